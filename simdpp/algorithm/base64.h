@@ -0,0 +1,112 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_BASE64_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_BASE64_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/base64.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Returns the number of characters produced by base64_encode() for @a n
+    bytes.
+*/
+static SIMDPP_INL std::size_t base64_encoded_size(std::size_t n)
+{
+    return (n + 2) / 3 * 4;
+}
+
+/** Returns the maximum number of bytes produced by base64_decode() for @a n
+    characters.
+*/
+static SIMDPP_INL std::size_t base64_decoded_max_size(std::size_t n)
+{
+    return n / 4 * 3;
+}
+
+/** Encodes the @a n bytes at @a in using the standard base64 alphabet with
+    padding and returns the number of characters stored to @a out, which
+    must have space for base64_encoded_size(@a n) characters.
+
+    Each group of three bytes is spread to four bytes with permute_bytes16()
+    and the 6-bit indices are aligned using 16-bit multiplications. The
+    indices are translated to characters using a 16-entry table of offsets.
+
+    @par 128-bit version:
+    Not vectorized on SSE2 and SSE3, since byte permutations are not
+    available.
+*/
+static SIMDPP_INL std::size_t base64_encode(const uint8_t* in, std::size_t n, char* out)
+{
+    return detail::base64_encode(in, n, out, detail::base64_is_vectorized());
+}
+
+/** Decodes the @a n characters of base64 at @a in, which must use the
+    standard alphabet with padding, and stores the bytes to @a out, which
+    must have space for base64_decoded_max_size(@a n) bytes.
+
+    If the input contains a character outside the alphabet or misplaced
+    padding, the returned result is not valid and holds the position of the
+    first such character; its size is the number of bytes decoded from the
+    preceding groups of four characters. If the length of the input is not
+    a multiple of four, the error position is @a n.
+
+    The characters are validated using two 16-entry tables indexed by the
+    nibbles of each character, which are applied with permute_bytes16(), and
+    are translated using a third table. Vectors with invalid characters are
+    decoded one character at a time to locate the error.
+
+    @par 128-bit version:
+    Not vectorized on SSE2 and SSE3, since byte permutations are not
+    available.
+*/
+static SIMDPP_INL decode_result base64_decode(const char* in, std::size_t n, uint8_t* out)
+{
+    return detail::base64_decode(in, n, out, detail::base64_is_vectorized());
+}
+
+/** Encodes the @a n bytes at @a in as lowercase hexadecimal digits and
+    returns the number of characters stored to @a out, which must have space
+    for 2 * @a n characters.
+
+    The digits are computed using comparisons on both nibbles of each byte
+    and are interleaved with zip16_lo() and zip16_hi().
+*/
+static SIMDPP_INL std::size_t hex_encode(const uint8_t* in, std::size_t n, char* out)
+{
+    return detail::hex_encode(in, n, out);
+}
+
+/** Decodes the @a n hexadecimal digits of either case at @a in and stores
+    the bytes to @a out, which must have space for @a n / 2 bytes.
+
+    If the input contains a character that is not a hexadecimal digit, the
+    returned result is not valid and holds the position of the first such
+    character; its size is the number of bytes decoded from the preceding
+    pairs of digits. If the length of the input is odd, the error position
+    is @a n.
+
+    The digits are separated by unzip16_lo() and unzip16_hi() and validated
+    with range checks using unsigned comparisons.
+*/
+static SIMDPP_INL decode_result hex_decode(const char* in, std::size_t n, uint8_t* out)
+{
+    return detail::hex_decode(in, n, out);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
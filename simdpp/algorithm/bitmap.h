@@ -0,0 +1,108 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_BITMAP_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_BITMAP_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/bitmap.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/*  The functions below operate on bitmaps of @a n_words 64-bit words. The
+    output may be equal to either of the inputs.
+
+    The *_count() variants additionally return the number of set bits in the
+    result, which is computed in the same pass. If the output pointer is
+    null, the result is only counted and not stored; e.g. the size of the
+    intersection of two sets can be computed without materializing it.
+
+    The bits are counted using a carry-save adder tree (Harley-Seal), which
+    needs a population count of only one vector per 16 processed vectors.
+*/
+
+/// Computes @a a & @a b for each word and stores the results to @a out
+static SIMDPP_INL void bitmap_and(const uint64_t* a, const uint64_t* b,
+                                  uint64_t* out, std::size_t n_words)
+{
+    detail::bitmap_op<detail::bitmap_and_op, true, false>(a, b, out, n_words);
+}
+
+/// Computes @a a | @a b for each word and stores the results to @a out
+static SIMDPP_INL void bitmap_or(const uint64_t* a, const uint64_t* b,
+                                 uint64_t* out, std::size_t n_words)
+{
+    detail::bitmap_op<detail::bitmap_or_op, true, false>(a, b, out, n_words);
+}
+
+/// Computes @a a ^ @a b for each word and stores the results to @a out
+static SIMDPP_INL void bitmap_xor(const uint64_t* a, const uint64_t* b,
+                                  uint64_t* out, std::size_t n_words)
+{
+    detail::bitmap_op<detail::bitmap_xor_op, true, false>(a, b, out, n_words);
+}
+
+/// Computes @a a & ~@a b for each word and stores the results to @a out
+static SIMDPP_INL void bitmap_andnot(const uint64_t* a, const uint64_t* b,
+                                     uint64_t* out, std::size_t n_words)
+{
+    detail::bitmap_op<detail::bitmap_andnot_op, true, false>(a, b, out, n_words);
+}
+
+/** Same as bitmap_and(), and returns the number of set bits in the result.
+    @a out may be null.
+*/
+static SIMDPP_INL uint64_t bitmap_and_count(const uint64_t* a, const uint64_t* b,
+                                            uint64_t* out, std::size_t n_words)
+{
+    return detail::bitmap_op_count<detail::bitmap_and_op>(a, b, out, n_words);
+}
+
+/** Same as bitmap_or(), and returns the number of set bits in the result.
+    @a out may be null.
+*/
+static SIMDPP_INL uint64_t bitmap_or_count(const uint64_t* a, const uint64_t* b,
+                                           uint64_t* out, std::size_t n_words)
+{
+    return detail::bitmap_op_count<detail::bitmap_or_op>(a, b, out, n_words);
+}
+
+/** Same as bitmap_xor(), and returns the number of set bits in the result.
+    @a out may be null.
+*/
+static SIMDPP_INL uint64_t bitmap_xor_count(const uint64_t* a, const uint64_t* b,
+                                            uint64_t* out, std::size_t n_words)
+{
+    return detail::bitmap_op_count<detail::bitmap_xor_op>(a, b, out, n_words);
+}
+
+/** Same as bitmap_andnot(), and returns the number of set bits in the
+    result. @a out may be null.
+*/
+static SIMDPP_INL uint64_t bitmap_andnot_count(const uint64_t* a, const uint64_t* b,
+                                               uint64_t* out, std::size_t n_words)
+{
+    return detail::bitmap_op_count<detail::bitmap_andnot_op>(a, b, out, n_words);
+}
+
+/// Returns the number of set bits in the bitmap of @a n_words words at @a a
+static SIMDPP_INL uint64_t bitmap_popcount(const uint64_t* a, std::size_t n_words)
+{
+    return detail::bitmap_op<detail::bitmap_first_op, false, true>(a, a, nullptr, n_words);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
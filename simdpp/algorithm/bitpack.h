@@ -0,0 +1,121 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_BITPACK_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_BITPACK_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/bitpack.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/*  The packed format is a little-endian bit stream: the i-th value occupies
+    the bits [i*B, (i+1)*B) of the stream, where bit j of the stream is the
+    bit (j % 8) of the byte (j / 8). The format does not depend on the
+    instruction set or the byte order of the target.
+*/
+
+/// Returns the number of bytes of @a n values packed to @a b bits each
+static SIMDPP_INL std::size_t bitpack_size(std::size_t n, unsigned b)
+{
+    return detail::bitpack_bytes(n, b);
+}
+
+/** Packs the lower @a B bits of each of the @a n values at @a in to @a out
+    and returns the number of written bytes, bitpack_size(n, B). The higher
+    bits of the values are ignored. @a B must be at most 32.
+*/
+template<unsigned B> SIMDPP_INL
+std::size_t bitpack(const uint32_t* in, std::size_t n, uint8_t* out)
+{
+    static_assert(B <= 32, "Bit width out of range");
+    return detail::bitpack<B>(in, n, out);
+}
+
+/** Unpacks @a n values of @a B bits each from @a in to @a out.
+    Exactly bitpack_size(n, B) bytes are read from @a in.
+
+    Each group of 4 values is unpacked by moving the bytes that contain each
+    value to its 32-bit element using a byte permutation, shifting each
+    element right by the bit offset of its value and masking. The positions
+    of the values are compile-time constants.
+
+    @par 128-bit version:
+    Not vectorized on SSE2 and SSE3, since byte permutations are not
+    available.
+*/
+template<unsigned B> SIMDPP_INL
+void bitunpack(const uint8_t* in, std::size_t n, uint32_t* out)
+{
+    static_assert(B <= 32, "Bit width out of range");
+    detail::bitunpack<B>(in, n, out);
+}
+
+/// Same as bitpack<B>(), except that the bit width @a b is a runtime value
+static SIMDPP_INL std::size_t bitpack(const uint32_t* in, std::size_t n,
+                                      unsigned b, uint8_t* out)
+{
+    return detail::bitpack_dispatch<detail::bitpack_fn, 0, 32>::run(b, in, n, out);
+}
+
+/// Same as bitunpack<B>(), except that the bit width @a b is a runtime value
+static SIMDPP_INL void bitunpack(const uint8_t* in, std::size_t n,
+                                 unsigned b, uint32_t* out)
+{
+    detail::bitpack_dispatch<detail::bitunpack_fn, 0, 32>::run(b, in, n, out);
+}
+
+/** Frame-of-reference encoding. Subtracts the minimum of the @a n values at
+    @a in from each value, stores the results to @a out and returns the
+    minimum, which is 0 if @a n is 0. The results usually need fewer bits
+    than the original values.
+*/
+static SIMDPP_INL uint32_t for_encode(const uint32_t* in, std::size_t n,
+                                      uint32_t* out)
+{
+    return detail::for_encode(in, n, out);
+}
+
+/// Adds @a base to each of the @a n values at @a in and stores the results to @a out
+static SIMDPP_INL void for_decode(const uint32_t* in, std::size_t n,
+                                  uint32_t base, uint32_t* out)
+{
+    detail::for_decode(in, n, base, out);
+}
+
+/** Delta encoding. Stores the zigzag-encoded differences between each of
+    the @a n values at @a in and the preceding value to @a out. The value
+    preceding the first one is @a prev. Zigzag encoding maps the differences
+    0, -1, 1, -2, 2 ... to 0, 1, 2, 3, 4 ..., thus small differences of either
+    sign need few bits. @a in and @a out must not overlap.
+*/
+static SIMDPP_INL void delta_encode(const uint32_t* in, std::size_t n,
+                                    uint32_t* out, uint32_t prev = 0)
+{
+    detail::delta_encode(in, n, out, prev);
+}
+
+/** Reverses delta_encode(). The differences are decoded and summed using
+    prefix_sum(). @a out may be equal to @a in.
+*/
+static SIMDPP_INL void delta_decode(const uint32_t* in, std::size_t n,
+                                    uint32_t* out, uint32_t prev = 0)
+{
+    detail::delta_decode(in, n, out, prev);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
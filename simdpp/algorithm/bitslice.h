@@ -0,0 +1,85 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_BITSLICE_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_BITSLICE_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/bitslice.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Transposes a 16x16 bit matrix: bit j of @a out[i] is set to bit i of
+    @a in[j]. @a out may be equal to @a in.
+
+    The bits of each byte plane of the rows are gathered with
+    extract_bits(), which maps to a single movemask instruction on x86.
+*/
+static SIMDPP_INL void bit_transpose16x16(const uint16_t* in, uint16_t* out)
+{
+    detail::bitslice_rows<1>(in, out, 1);
+}
+
+/// Same as bit_transpose16x16(), for a 32x32 bit matrix
+static SIMDPP_INL void bit_transpose32x32(const uint32_t* in, uint32_t* out)
+{
+    detail::bitslice_rows<2>(in, out, 1);
+}
+
+/// Same as bit_transpose16x16(), for a 64x64 bit matrix
+static SIMDPP_INL void bit_transpose64x64(const uint64_t* in, uint64_t* out)
+{
+    detail::bitslice_rows<4>(in, out, 1);
+}
+
+/// Returns the number of words of each bit plane of @a n elements
+static SIMDPP_INL std::size_t bitslice_words(std::size_t n)
+{
+    return detail::bitslice_words(n);
+}
+
+/** Converts the @a n integers at @a in to the bit-sliced layout: the bit b
+    of the i-th element is stored to the bit (i % 64) of the word
+    @a out[b * bitslice_words(n) + i / 64]. Each bit plane is thus a bitmap
+    of @a n bits. The bits of the last word of each plane past @a n are
+    zero.
+
+    Predicates can be evaluated on bit-sliced data a bit plane at a time
+    using bitwise operations on whole words.
+*/
+template<class T>
+void bitslice(const T* in, std::size_t n, uint64_t* out)
+{
+    static_assert(std::is_integral<T>::value, "Only integer elements are supported");
+    detail::bitslice(in, n, out);
+}
+
+/** Reverses bitslice(): reconstructs @a n integers from their bit planes at
+    @a in and stores them to @a out.
+
+    The planes of the bits of each byte are transposed using
+    bit_transpose8x8().
+*/
+template<class T>
+void unbitslice(const uint64_t* in, std::size_t n, T* out)
+{
+    static_assert(std::is_integral<T>::value, "Only integer elements are supported");
+    detail::unbitslice(in, n, out);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,52 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_DICT_DECODE_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_DICT_DECODE_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/dict_decode.h>
+#include <cstddef>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Dictionary decoding. Looks up each of the @a n indices at @a idx in the
+    dictionary of @a dict_size elements at @a dict and stores the elements to
+    @a out:
+
+    @code
+    out[i] = dict[idx[i]]
+    @endcode
+
+    @a I must be an unsigned integer type. All indices must be less than
+    @a dict_size.
+
+    If the indices are bytes and the dictionary fits into 16 bytes, it is
+    held in a vector and the elements are selected using permute_bytes16().
+    This covers, for example, up to 16 8-bit or 4 32-bit elements. If the
+    indices are 32-bit and the elements are 4 or 8 bytes, gathers are used
+    on AVX2 and AVX-512. Otherwise the lookups are scalar.
+
+    @par 128-bit version:
+    Dictionary lookup tables are not vectorized on SSE2 and SSE3, since byte
+    permutations are not available.
+*/
+template<class T, class I>
+void dict_decode(const I* idx, std::size_t n, const T* dict, std::size_t dict_size, T* out)
+{
+    detail::dict_decode(idx, n, dict, dict_size, out);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,83 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_FILTER_BITMAP_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_FILTER_BITMAP_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/filter_bitmap.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/*  The filters evaluate a predicate for each element of an array and store
+    the results to a bitmap: the result for the i-th element is the bit
+    (i % 64) of the word (i / 64). The elements may be 8, 16, 32 or 64-bit
+    integers or floating-point values.
+
+    The results are combined with the existing contents of the bitmap as
+    specified by @a op, so that conjunctions and disjunctions of predicates
+    can be evaluated without materializing intermediate bitmaps. The bits of
+    the last word that do not correspond to any element are computed as if
+    the predicate was false.
+
+    Each output word is computed from the comparison masks of 64 elements,
+    which are packed to bits using extract_bits_any(), or taken directly on
+    AVX-512.
+*/
+
+/// Returns the number of words of a bitmap of @a n bits
+static SIMDPP_INL std::size_t filter_bitmap_words(std::size_t n)
+{
+    return (n + detail::filter_word_bits - 1) / detail::filter_word_bits;
+}
+
+/** Evaluates @a lo <= x < @a hi for each of the @a n elements at @a in and
+    stores the results to the bitmap at @a out.
+
+    Integer ranges are evaluated using a single unsigned comparison of
+    x - lo with hi - lo.
+*/
+template<class T>
+void filter_range(const T* in, std::size_t n, T lo, T hi, uint64_t* out,
+                  filter_combine op = filter_combine::replace)
+{
+    detail::filter_bitmap(in, n, out, op, detail::filter_range_pred<T>(lo, hi));
+}
+
+/** Evaluates x == @a c for each of the @a n elements at @a in and stores the
+    results to the bitmap at @a out.
+*/
+template<class T>
+void filter_eq(const T* in, std::size_t n, T c, uint64_t* out,
+               filter_combine op = filter_combine::replace)
+{
+    detail::filter_bitmap(in, n, out, op, detail::filter_in_pred<T>(&c, 1));
+}
+
+/** Evaluates whether each of the @a n elements at @a in is equal to any of
+    the @a set_size elements at @a set and stores the results to the bitmap
+    at @a out. Each element is compared with all elements of the set, thus
+    the set should be small.
+*/
+template<class T>
+void filter_in(const T* in, std::size_t n, const T* set, std::size_t set_size,
+               uint64_t* out, filter_combine op = filter_combine::replace)
+{
+    detail::filter_bitmap(in, n, out, op, detail::filter_in_pred<T>(set, set_size));
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
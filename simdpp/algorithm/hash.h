@@ -0,0 +1,104 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_HASH_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_HASH_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/hash.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/*  The hash functions below compute the same values on all architectures.
+    The vector overloads compute the hashes of all elements independently and
+    the results are equal to those of the scalar overloads.
+*/
+
+/** Hashes a 32-bit value using the finalizer of MurmurHash3. The function is
+    a bijection, thus distinct values have distinct hashes. hash32(0) == 0.
+
+    @code
+    r = fmix32(x)
+    @endcode
+*/
+static SIMDPP_INL uint32_t hash32(uint32_t x)
+{
+    return detail::hash_fmix32(x);
+}
+
+/** Hashes each element of @a x in the same way as hash32(uint32_t).
+
+    @code
+    r0 = hash32(x0)
+    ...
+    rN = hash32(xN)
+    @endcode
+*/
+template<unsigned N, class E> SIMDPP_INL
+uint32<N> hash32(const uint32<N,E>& x)
+{
+    return detail::hash_fmix32(x.eval());
+}
+
+/** Hashes a 64-bit value using the 64-bit finalizer of MurmurHash3. The
+    function is a bijection, thus distinct values have distinct hashes.
+    hash64(0) == 0.
+*/
+static SIMDPP_INL uint64_t hash64(uint64_t x)
+{
+    return detail::hash_fmix64(x);
+}
+
+/** Hashes each element of @a x in the same way as hash64(uint64_t).
+
+    The 64-bit multiplications are emulated using 32-bit multiplications
+    unless AVX512DQ is available. On architectures other than x86 the
+    multiplications are performed on scalars.
+*/
+template<unsigned N, class E> SIMDPP_INL
+uint64<N> hash64(const uint64<N,E>& x)
+{
+    return detail::hash_fmix64(x.eval());
+}
+
+/** Computes the 32-bit MurmurHash3 (MurmurHash3_x86_32) of @a len bytes at
+    @a p. The data is read as little-endian words regardless of the target,
+    thus the result is the same on all platforms.
+*/
+static SIMDPP_INL uint32_t hash_bytes(const void* p, std::size_t len,
+                                      uint32_t seed = 0)
+{
+    return detail::hash_bytes_scalar(static_cast<const char*>(p), len, seed);
+}
+
+/** Computes hash_bytes(ptrs[i], lens[i], seed) for each of the @a n byte
+    strings and stores the results to @a out.
+
+    The strings are hashed in groups of @c SIMDPP_FAST_INT32_SIZE, one per
+    vector element. The 4-byte blocks of the strings within a group are
+    gathered into a vector and mixed in parallel, thus the cost of a group
+    depends on its longest string. The function is best suited for many short
+    keys of similar length.
+*/
+static SIMDPP_INL void hash_bytes_batch(const char* const* ptrs,
+                                        const std::size_t* lens, std::size_t n,
+                                        uint32_t* out, uint32_t seed = 0)
+{
+    detail::hash_bytes_batch<SIMDPP_FAST_INT32_SIZE>(ptrs, lens, n, out, seed);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,77 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_HISTOGRAM_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_HISTOGRAM_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/histogram.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Counts the occurrences of each key. For each of the @a n keys at @a keys,
+    increments counts[key]. Each key must be less than @a num_bins.
+
+    The keys are counted into several sub-histograms, which are added to
+    @a counts using vector additions at the end. On AVX-512F each lane of a
+    vector of 16 keys is counted into its own sub-histogram using gather,
+    add and scatter, thus the lanes never conflict. On other instruction sets
+    the keys are counted by scalar code into four interleaved sub-histograms,
+    so that the increments of runs of equal keys do not depend on each other.
+
+    The key type must be uint8_t, uint16_t or uint32_t.
+*/
+template<class K> SIMDPP_INL
+void histogram(const K* keys, std::size_t n, uint32_t* counts, std::size_t num_bins)
+{
+    static_assert(std::is_integral<K>::value && std::is_unsigned<K>::value &&
+                  sizeof(K) <= 4, "Only 8, 16 and 32-bit unsigned keys are supported");
+    detail::histogram(keys, n, counts, num_bins);
+}
+
+/** Counts the occurrences of each byte value. For each of the @a n bytes at
+    @a keys, increments counts[key]. @a counts must have 256 elements.
+*/
+static SIMDPP_INL void histogram(const uint8_t* keys, std::size_t n, uint32_t* counts)
+{
+    detail::histogram(keys, n, counts, 256);
+}
+
+/** Sums the values of each group. For each of the @a n keys at @a keys, adds
+    values[i] to out[keys[i]]. Each key must be less than @a num_groups.
+
+    The values are accumulated into several sub-histograms in the same way
+    as in histogram(), using vector gathers and scatters on AVX-512F and
+    scalar code otherwise. Consequently, the floating-point sums may differ from
+    sequential summation due to rounding.
+
+    The key type must be uint8_t, uint16_t or uint32_t. The value type must be
+    a 32-bit or 64-bit arithmetic type.
+*/
+template<class K, class T> SIMDPP_INL
+void group_sum(const K* keys, const T* values, std::size_t n, T* out,
+               std::size_t num_groups)
+{
+    static_assert(std::is_integral<K>::value && std::is_unsigned<K>::value &&
+                  sizeof(K) <= 4, "Only 8, 16 and 32-bit unsigned keys are supported");
+    static_assert(std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "Only 32-bit and 64-bit arithmetic values are supported");
+    detail::group_sum(keys, values, n, out, num_groups);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,145 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_LOWER_BOUND_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_LOWER_BOUND_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/aligned_allocator.h>
+#include <simdpp/detail/algorithm/lower_bound.h>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Returns the index of the first of @a n elements at @a p, which must be
+    sorted in ascending order, that is not less than @a key, or @a n if there
+    is no such element. The same as std::lower_bound, except that the index is
+    returned.
+
+    The search range is narrowed using branchless binary search down to a
+    64-byte block, whose elements are compared with the key at once.
+
+    The element type must be a 32-bit or 64-bit arithmetic type.
+*/
+template<class T> SIMDPP_INL
+std::size_t lower_bound(const T* p, std::size_t n, T key)
+{
+    static_assert(std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "Only 32-bit and 64-bit arithmetic types are supported");
+    return detail::search_lower_bound(p, n, key);
+}
+
+/** Computes lower_bound(p, n, keys[i]) for each of the @a num_keys keys and
+    stores the results to @a out. Several keys are searched simultaneously,
+    which hides the latency of the memory accesses.
+*/
+template<class T> SIMDPP_INL
+void lower_bound_many(const T* p, std::size_t n,
+                      const T* keys, std::size_t num_keys, std::size_t* out)
+{
+    static_assert(std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "Only 32-bit and 64-bit arithmetic types are supported");
+    detail::search_lower_bound_many(p, n, keys, num_keys, out);
+}
+
+/** A copy of a sorted array rearranged for fast searches.
+
+    The elements are stored in an implicit B-tree whose nodes are 64 bytes
+    long, so that each node occupies a single cache line and is compared with
+    the key at once. Each node holds @a node_length elements and has
+    @a node_length + 1 children. A search thus touches at most
+    log(n) / log(node_length + 1) cache lines compared to log2(n) in the case
+    of binary search over the original array. The positions of the elements
+    in the original array are stored separately and only the one of the
+    result is read.
+
+    @code
+    kary_search_tree<uint32_t> tree(bounds.data(), bounds.size());
+    std::size_t part = tree.lower_bound(key); // == lower_bound(bounds.data(), bounds.size(), key)
+    @endcode
+
+    The element type must be a 32-bit or 64-bit arithmetic type.
+    Floating-point values must not be NaN.
+*/
+template<class T>
+class kary_search_tree {
+    static_assert(std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "Only 32-bit and 64-bit arithmetic types are supported");
+public:
+    using size_type = std::size_t;
+
+    /// The number of elements in a node
+    static const unsigned node_length = detail::search_block_length<T>::value;
+
+    kary_search_tree() : size_(0), num_nodes_(0) {}
+
+    /// Builds the tree from @a n elements at @a p sorted in ascending order
+    kary_search_tree(const T* p, size_type n) : kary_search_tree()
+    {
+        assign(p, n);
+    }
+
+    /// Rebuilds the tree from @a n elements at @a p sorted in ascending order
+    void assign(const T* p, size_type n)
+    {
+        size_ = n;
+        num_nodes_ = (n + node_length - 1) / node_length;
+        // Unused slots are at the end in the in-order and are never less
+        // than any key
+        nodes_.assign(num_nodes_ * node_length,
+                      detail::sort_padding_value<T>(std::is_floating_point<T>()));
+        ranks_.assign(num_nodes_ * node_length, n);
+        size_type t = 0;
+        detail::search_tree_fill(nodes_.data(), ranks_.data(), num_nodes_, 0,
+                                 p, n, t);
+    }
+
+    /// Returns the number of elements in the tree
+    size_type size() const { return size_; }
+
+    /** Returns the index of the first element of the original array that is
+        not less than @a key, or size() if there is no such element.
+    */
+    size_type lower_bound(T key) const
+    {
+        return detail::search_tree_lower_bound(nodes_.data(), ranks_.data(),
+                                               num_nodes_, size_, key);
+    }
+
+    /** Computes lower_bound(keys[i]) for each of the @a num_keys keys and
+        stores the results to @a out. Several keys are searched
+        simultaneously and the child node of each key is prefetched while the
+        other keys are processed.
+    */
+    void lower_bound_many(const T* keys, size_type num_keys, size_type* out) const
+    {
+        detail::search_tree_lower_bound_many(nodes_.data(), ranks_.data(),
+                                             num_nodes_, size_, keys, num_keys,
+                                             out);
+    }
+
+private:
+    std::vector<T, aligned_allocator<T, 64>> nodes_;
+    std::vector<size_type> ranks_;
+    size_type size_;
+    size_type num_nodes_;
+};
+
+template<class T>
+const unsigned kary_search_tree<T>::node_length;
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
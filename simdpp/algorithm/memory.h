@@ -0,0 +1,131 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_MEMORY_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_MEMORY_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/memory.h>
+
+/** @def SIMDPP_STREAM_THRESHOLD
+    The default size in bytes starting from which @a copy and @a fill write
+    the destination using non-temporal stores. The default value is 4 MiB,
+    which is comparable to the size of the last level cache of typical
+    processors. Define this macro before including simd.h to change it.
+*/
+#ifndef SIMDPP_STREAM_THRESHOLD
+#define SIMDPP_STREAM_THRESHOLD (4u << 20)
+#endif
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Copies @a n bytes from @a src to @a dst. The memory ranges must not
+    overlap.
+
+    Sizes smaller than the native vector size are copied using masked stores
+    on AVX-512BW and at most two overlapping scalar or vector stores
+    otherwise. Larger sizes are copied using full vectors, the last partial
+    vector overlapping the previous one. If @a n is at least
+    @a stream_threshold bytes, the destination is written using @a stream and
+    the operation is completed by @a stream_fence.
+*/
+SIMDPP_INL void copy(void* dst, const void* src, std::size_t n,
+                     std::size_t stream_threshold)
+{
+    detail::copy_impl(reinterpret_cast<char*>(dst),
+                      reinterpret_cast<const char*>(src), n, stream_threshold);
+}
+
+SIMDPP_INL void copy(void* dst, const void* src, std::size_t n)
+{
+    copy(dst, src, n, SIMDPP_STREAM_THRESHOLD);
+}
+
+/** Sets @a n bytes starting at @a dst to @a value.
+
+    The strategy is the same as in @a copy, including the use of non-temporal
+    stores for sizes of at least @a stream_threshold bytes.
+*/
+SIMDPP_INL void fill(void* dst, uint8_t value, std::size_t n,
+                     std::size_t stream_threshold)
+{
+    detail::fill_impl(reinterpret_cast<char*>(dst), value, n, stream_threshold);
+}
+
+SIMDPP_INL void fill(void* dst, uint8_t value, std::size_t n)
+{
+    fill(dst, value, n, SIMDPP_STREAM_THRESHOLD);
+}
+
+/** Lexicographically compares @a n bytes at @a a and @a b as unsigned
+    values. Returns a negative value, zero or a positive value if the first
+    range is less than, equal to or greater than the second respectively.
+*/
+SIMDPP_INL int compare(const void* a, const void* b, std::size_t n)
+{
+    return detail::compare_impl(reinterpret_cast<const char*>(a),
+                                reinterpret_cast<const char*>(b), n);
+}
+
+/** Returns the index of the first byte equal to @a value within the first
+    @a n bytes at @a p, or @a n if there's no such byte.
+*/
+SIMDPP_INL std::size_t find_byte(const void* p, std::size_t n, uint8_t value)
+{
+    return detail::find_byte_impl(reinterpret_cast<const char*>(p), n, value);
+}
+
+/// Returns the number of bytes equal to @a value within the first @a n bytes at @a p
+SIMDPP_INL std::size_t count_byte(const void* p, std::size_t n, uint8_t value)
+{
+    return detail::count_byte_impl(reinterpret_cast<const char*>(p), n, value);
+}
+
+/** Returns the index of the first byte within the first @a n bytes at @a p
+    that is equal to any of the @a set_size bytes at @a set, or @a n if
+    there's no such byte.
+
+    The bytes are classified using two lookup tables indexed by the lower
+    and higher nibble of each byte, using permute_bytes16(). Sets in which
+    the bytes sharing each high nibble form at most 8 distinct patterns of
+    low nibbles need a single pair of tables; other sets need two.
+
+    @par 128-bit version:
+    On SSE2 and SSE3 the bytes are compared with each element of sets of up
+    to 16 bytes; larger sets are not vectorized.
+*/
+SIMDPP_INL std::size_t find_any_of(const void* p, std::size_t n,
+                                   const void* set, std::size_t set_size)
+{
+    return detail::find_any_of_impl(reinterpret_cast<const char*>(p), n,
+                                    reinterpret_cast<const uint8_t*>(set), set_size);
+}
+
+/** Returns the index of the first occurrence of the @a m bytes at @a needle
+    within the first @a n bytes at @a p, or @a n if there's no such
+    occurrence. An empty needle is found at index 0.
+
+    The positions at which both the first and the last byte of the needle
+    match are found a vector at a time; the remaining bytes are compared
+    only at these positions.
+*/
+SIMDPP_INL std::size_t find_substring(const void* p, std::size_t n,
+                                      const void* needle, std::size_t m)
+{
+    return detail::find_substring_impl(reinterpret_cast<const char*>(p), n,
+                                       reinterpret_cast<const char*>(needle), m);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
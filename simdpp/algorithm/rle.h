@@ -0,0 +1,59 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_RLE_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_RLE_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/rle.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Run-length encodes the @a n elements at @a in. The value and the length
+    of each run of equal consecutive elements are stored to @a values and
+    @a runs respectively. Returns the number of runs. Both output buffers
+    must have room for @a n runs. Runs longer than 2^32-1 elements are split.
+
+    Run boundaries are found by comparing each vector of elements with the
+    vector loaded one element earlier using cmp_neq(). Vectors without
+    boundaries are skipped with a single test; the boundaries of the
+    remaining vectors are enumerated from a bit mask, which for byte
+    elements is computed with extract_bits_any().
+
+    Floating-point elements are compared using floating-point comparison,
+    thus each NaN forms a separate run.
+*/
+template<class T>
+std::size_t rle_encode(const T* in, std::size_t n, T* values, uint32_t* runs)
+{
+    return detail::rle_encode(in, n, values, runs);
+}
+
+/** Expands the @a num_runs runs described by @a values and @a runs, as
+    produced by rle_encode(), to @a out. Returns the number of written
+    elements, which is the sum of the run lengths.
+
+    Each run is filled using whole vectors of the splat value. The stores
+    may pass the end of a run, but never the end of the output.
+*/
+template<class T>
+std::size_t rle_decode(const T* values, const uint32_t* runs, std::size_t num_runs, T* out)
+{
+    return detail::rle_decode(values, runs, num_runs, out);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
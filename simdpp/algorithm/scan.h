@@ -0,0 +1,73 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_SCAN_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_SCAN_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/scan.h>
+#include <cstddef>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Computes the inclusive prefix sums of @a n elements at @a in and stores
+    them to @a out. @a out may be equal to @a in, otherwise the ranges must
+    not overlap.
+
+    @code
+    out[0] = in[0]
+    out[1] = in[0] + in[1]
+    ...
+    @endcode
+
+    Each native vector is scanned using prefix_sum() and the total of the
+    preceding vectors is added to it, thus the sequential dependency is one
+    vector addition per vector instead of one scalar addition per element.
+
+    The element type may be any 8, 16, 32 or 64-bit integer type or a
+    floating-point type. Integer sums wrap around on overflow. Floating-point
+    sums may differ from sequential summation due to rounding.
+*/
+template<class T> SIMDPP_INL
+void inclusive_scan(const T* in, T* out, std::size_t n)
+{
+    static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                  "Only integer and floating-point types are supported");
+    detail::inclusive_scan(in, out, n);
+}
+
+/** Computes the exclusive prefix sums of @a n elements at @a in, starting
+    with @a init, and stores them to @a out. @a out may be equal to @a in,
+    otherwise the ranges must not overlap.
+
+    @code
+    out[0] = init
+    out[1] = init + in[0]
+    out[2] = init + in[0] + in[1]
+    ...
+    @endcode
+
+    The same element types as in inclusive_scan() are supported.
+*/
+template<class T> SIMDPP_INL
+void exclusive_scan(const T* in, T* out, std::size_t n, T init = T())
+{
+    static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                  "Only integer and floating-point types are supported");
+    detail::exclusive_scan(in, out, n, init);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
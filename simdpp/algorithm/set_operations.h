@@ -0,0 +1,92 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_SET_OPERATIONS_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_SET_OPERATIONS_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/set_operations.h>
+#include <cstddef>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/*  The following functions operate on sorted arrays of 32-bit or 64-bit
+    integers. Each function writes its result to @a out and returns the number
+    of stored elements. @a out must not overlap the inputs.
+*/
+
+/** Stores the elements that are present in both @a a and @a b. Both inputs
+    must be sorted in strictly increasing order, i.e. must not contain
+    duplicates. @a out must have space for min(na, nb) elements.
+
+    Each block of native vector size of one input is compared with a block of
+    the other input using all-pairs comparisons and the matching elements
+    are packed to the output. If one input is much smaller than the other,
+    each of its elements is searched in the larger input using exponential
+    search instead.
+*/
+template<class T> SIMDPP_INL
+std::size_t intersect_sorted(const T* a, std::size_t na,
+                             const T* b, std::size_t nb, T* out)
+{
+    static_assert(std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "Only 32-bit and 64-bit integer types are supported");
+    return detail::set_intersect(a, na, b, nb, out);
+}
+
+/** Stores the elements of @a a that are not present in @a b. Both inputs
+    must be sorted in strictly increasing order. @a out must have space for
+    @a na elements.
+*/
+template<class T> SIMDPP_INL
+std::size_t difference_sorted(const T* a, std::size_t na,
+                              const T* b, std::size_t nb, T* out)
+{
+    static_assert(std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "Only 32-bit and 64-bit integer types are supported");
+    return detail::set_difference(a, na, b, nb, out);
+}
+
+/** Stores the elements that are present in either @a a or @a b in strictly
+    increasing order. Both inputs must be sorted in ascending order; repeated
+    elements are stored once. @a out must have space for na + nb elements.
+
+    The inputs are merged using bitonic merging networks and the repeated
+    elements are removed from each merged vector.
+*/
+template<class T> SIMDPP_INL
+std::size_t union_sorted(const T* a, std::size_t na,
+                         const T* b, std::size_t nb, T* out)
+{
+    static_assert(std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "Only 32-bit and 64-bit integer types are supported");
+    return detail::set_merge<true>(a, na, b, nb, out);
+}
+
+/** Merges the elements of @a a and @a b, which must be sorted in ascending
+    order, into @a out. All na + nb elements are stored. The same as
+    std::merge, except that the merge is not stable.
+*/
+template<class T> SIMDPP_INL
+std::size_t merge_sorted(const T* a, std::size_t na,
+                         const T* b, std::size_t nb, T* out)
+{
+    static_assert(std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "Only 32-bit and 64-bit integer types are supported");
+    return detail::set_merge<false>(a, na, b, nb, out);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
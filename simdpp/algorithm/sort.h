@@ -0,0 +1,93 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_SORT_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_SORT_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/sort.h>
+#include <cstddef>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Sorts the columns of @a K vectors in ascending order, i.e. for each
+    element index i, rearranges the values of v[0][i] ... v[K-1][i] so that
+    v[0][i] <= v[1][i] <= ... <= v[K-1][i]. A bitonic sorting network is
+    used, thus only @a min and @a max operations are performed. @a K must be
+    a power of two.
+
+    @code
+    r0 = min(v0, v1), r1 = max(v0, v1)      // K == 2
+    @endcode
+*/
+template<unsigned K, class V> SIMDPP_INL
+void sort_network(V (&v)[K])
+{
+    static_assert(K != 0 && (K & (K - 1)) == 0, "K must be a power of two");
+    for (unsigned s = 2; s <= K; s *= 2) {
+        for (unsigned j = 0; j < K; ++j) {
+            if ((j & (s/2)) == 0) {
+                detail::sort_cmpx(v[j], v[j ^ (s-1)]);
+            }
+        }
+        for (unsigned d = s/4; d > 0; d /= 2) {
+            for (unsigned j = 0; j < K; ++j) {
+                if ((j & d) == 0) {
+                    detail::sort_cmpx(v[j], v[j + d]);
+                }
+            }
+        }
+    }
+}
+
+/** Merges two vectors whose elements are sorted in ascending order. After the
+    operation, @a a contains the smallest N values of both vectors and @a b
+    contains the largest N values, both in ascending order.
+
+    Only vectors of 32-bit and 64-bit elements are supported.
+*/
+template<unsigned N, class V> SIMDPP_INL
+void bitonic_merge(any_vec<N,V>& a, any_vec<N,V>& b)
+{
+    using E = typename V::element_type;
+    static_assert(sizeof(E) == 4 || sizeof(E) == 8,
+                  "Only 32-bit and 64-bit elements are supported");
+    detail::sort_bitonic_merge2(a.wrapped(), b.wrapped());
+}
+
+/** Sorts @a n elements at @a p in ascending order. The sort is not stable.
+
+    The array is partitioned using vectorized quicksort until the partitions
+    fit into 16 native vectors, which are then sorted using an in-register
+    bitonic sorting network. On AVX-512F the partitioning uses compressing
+    stores. If the recursion becomes too deep, the algorithm falls back to
+    std::sort.
+
+    The element type must be a 32-bit or 64-bit integer or floating-point
+    type. Floating-point data must not contain NaN values.
+
+    The function is compiled for each instruction set like any other function
+    of the library, thus it can be selected at runtime via the dispatcher.
+*/
+template<class T> SIMDPP_INL
+void sort(T* p, std::size_t n)
+{
+    static_assert(std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "Only 32-bit and 64-bit arithmetic types are supported");
+    detail::sort_array(p, n);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,71 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_TRANSPOSE_MATRIX_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_TRANSPOSE_MATRIX_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/transpose_matrix.h>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Transposes a matrix of 8, 16, 32 or 64-bit elements stored in memory.
+
+    @a src points to a matrix of @a rows rows and @a cols columns, @a dst
+    points to a matrix of @a cols rows and @a rows columns. Consecutive rows
+    are @a src_stride and @a dst_stride elements apart respectively. The two
+    matrices must not overlap.
+
+    @code
+    for (r = 0; r < rows; ++r)
+        for (c = 0; c < cols; ++c)
+            dst[c * dst_stride + r] = src[r * src_stride + c]
+    @endcode
+
+    The matrix is processed in tiles that fit into L1 cache. Each tile is
+    transposed in register-sized blocks using @a transpose16, @a transpose8,
+    @a transpose4 or @a transpose2 depending on the element size, while the
+    next tile is being prefetched. Parts of the matrix that don't fill a
+    whole block are transposed using scalar code.
+*/
+template<class T> SIMDPP_INL
+void transpose_matrix(const T* src, T* dst,
+                      std::size_t rows, std::size_t cols,
+                      std::size_t src_stride, std::size_t dst_stride)
+{
+    detail::transpose_matrix_impl<T, false>(src, dst, rows, cols,
+                                            src_stride, dst_stride);
+}
+
+/** Transposes a matrix of 8, 16, 32 or 64-bit elements stored in memory
+    without polluting the caches with the destination data, if possible.
+
+    Behaves the same way as @a transpose_matrix except that the destination
+    is written using @a stream. This is beneficial when the destination is
+    not going to be accessed soon, e.g. when the matrix is much larger than
+    the last level cache. Non-temporal stores are used only when @a dst and
+    <tt>dst_stride * sizeof(T)</tt> are both aligned to the vector size,
+    otherwise the function falls back to regular stores.
+*/
+template<class T> SIMDPP_INL
+void transpose_matrix_stream(const T* src, T* dst,
+                             std::size_t rows, std::size_t cols,
+                             std::size_t src_stride, std::size_t dst_stride)
+{
+    detail::transpose_matrix_impl<T, true>(src, dst, rows, cols,
+                                           src_stride, dst_stride);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
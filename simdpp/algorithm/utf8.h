@@ -0,0 +1,88 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_UTF8_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_UTF8_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/utf8.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Returns whether the @a n bytes at @a p are valid UTF-8. Overlong
+    encodings, surrogates, code points above U+10FFFF and truncated
+    sequences are rejected.
+
+    Each vector of bytes is checked together with the three preceding bytes
+    using three 16-entry lookup tables indexed by nibbles, which are applied
+    with permute_bytes16(). Vectors of ASCII bytes are skipped.
+
+    @par 128-bit version:
+    Not vectorized on SSE2 and SSE3, since byte permutations are not
+    available.
+*/
+static SIMDPP_INL bool utf8_validate(const uint8_t* p, std::size_t n)
+{
+    return detail::utf8_validate(p, n, detail::utf8_is_vectorized());
+}
+
+/** Converts the @a n bytes of UTF-8 at @a in to UTF-16 and returns the
+    number of units stored to @a out, which must have space for @a n units.
+    Returns 0 if the input is not valid UTF-8, which is checked using
+    utf8_validate() before any output is written.
+
+    ASCII is widened 16 bytes at a time. Other blocks without four-byte
+    sequences are decoded at each byte and the code units are packed using
+    permute_bytes16() with masks from a lookup table indexed by the positions
+    of the sequence ends. The units of @a out past the returned number may be
+    overwritten.
+
+    @par 128-bit version:
+    Only ASCII is vectorized on SSE2 and SSE3, since byte permutations are
+    not available.
+*/
+static SIMDPP_INL std::size_t utf8_to_utf16(const uint8_t* in, std::size_t n,
+                                            char16_t* out)
+{
+    if (!utf8_validate(in, n)) {
+        return 0;
+    }
+    return detail::utf8_to_utf16_valid(in, n, out, detail::utf8_is_vectorized());
+}
+
+/** Converts the @a n units of UTF-16 at @a in to UTF-8 and returns the
+    number of bytes stored to @a out, which must have space for 3 * @a n
+    bytes. Returns 0 if the input contains unpaired surrogates; in that case
+    the contents of @a out are unspecified.
+
+    ASCII is narrowed 16 units at a time. Other blocks without surrogates are
+    encoded to up to three bytes per unit, which are packed using
+    permute_bytes16() with masks from a lookup table indexed by the byte
+    counts of each group of four units. The bytes of @a out past the returned
+    number may be overwritten.
+
+    @par 128-bit version:
+    Only ASCII is vectorized on SSE2 and SSE3, since byte permutations are
+    not available.
+*/
+static SIMDPP_INL std::size_t utf16_to_utf8(const char16_t* in, std::size_t n,
+                                            uint8_t* out)
+{
+    return detail::utf16_to_utf8(in, n, out, detail::utf8_is_vectorized());
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
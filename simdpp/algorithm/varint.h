@@ -0,0 +1,98 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_ALGORITHM_VARINT_H
+#define LIBSIMDPP_SIMDPP_ALGORITHM_VARINT_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/algorithm/varint.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/*  The Stream VByte format stores n values as (n + 3) / 4 control bytes
+    followed by the data bytes. Each value is stored as 1 to 4 little-endian
+    data bytes; bits [2*k, 2*k+2) of the control byte of each group of 4
+    values hold the number of data bytes of the k-th value minus one. The
+    unused bits of the last control byte are zero.
+*/
+
+/// Returns the maximum number of bytes svb_encode() writes for @a n values
+static SIMDPP_INL std::size_t svb_max_encoded_size(std::size_t n)
+{
+    return detail::svb_control_bytes(n) + n * 4;
+}
+
+/** Encodes the @a n values at @a in to @a out in the Stream VByte format
+    and returns the number of bytes of the encoded data. The size of the
+    buffer at @a out must be at least svb_max_encoded_size(n) bytes:
+    vectorized encoding may write past the end of the encoded data.
+*/
+static SIMDPP_INL std::size_t svb_encode(const uint32_t* in, std::size_t n, uint8_t* out)
+{
+    return detail::svb_encode(in, n, out);
+}
+
+/** Decodes @a n values in the Stream VByte format from @a in to @a out and
+    returns the number of bytes of the encoded data. No data is read past the
+    end of the encoded data.
+
+    The data of each group of 4 values is loaded as a 16-byte vector and
+    moved to its 32-bit elements using a byte permutation, whose mask is
+    looked up by the control byte. On wider vectors, several groups are
+    combined into a single vector.
+
+    @par 128-bit version:
+    Not vectorized on SSE2 and SSE3, since byte permutations are not
+    available.
+*/
+static SIMDPP_INL std::size_t svb_decode(const uint8_t* in, std::size_t n, uint32_t* out)
+{
+    return detail::svb_decode(in, n, out);
+}
+
+/// Returns the maximum number of bytes leb128_encode() writes for @a n values
+static SIMDPP_INL std::size_t leb128_max_encoded_size(std::size_t n)
+{
+    return n * 5;
+}
+
+/** Encodes the @a n values at @a in to @a out as unsigned LEB128 varints, as
+    used by Protocol Buffers, and returns the number of written bytes. Each
+    value is stored in 7-bit groups starting from the least significant one;
+    the high bit of each byte is set if more bytes follow.
+*/
+static SIMDPP_INL std::size_t leb128_encode(const uint32_t* in, std::size_t n, uint8_t* out)
+{
+    return detail::leb128_encode(in, n, out);
+}
+
+/** Decodes @a n unsigned LEB128 varints from the @a in_size bytes at @a in
+    to @a out and returns the number of consumed bytes. Returns 0 if the
+    input ends before @a n values are decoded or if a value does not fit into
+    32 bits. Values may be encoded with redundant zero groups, up to 5 bytes.
+
+    The input is scanned 16 bytes at a time. The bytes that terminate values
+    are found using cmp_lt() and extract_bits_any(); chunks of 16
+    single-byte values are zero-extended directly.
+*/
+static SIMDPP_INL std::size_t leb128_decode(const uint8_t* in, std::size_t in_size,
+                                            uint32_t* out, std::size_t n)
+{
+    return detail::leb128_decode(in, in_size, out, n);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -9,9 +9,17 @@
 #define LIBSIMDPP_CORE_ALIGNED_ALLOCATOR_H
 
 #include <memory>
+#include <new>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <stdexcept>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
 
 namespace simdpp {
 namespace SIMDPP_ARCH_NAMESPACE {
@@ -121,6 +129,217 @@ public:
     }
 };
 
+namespace detail {
+
+/*  Allocates @a size bytes aligned to @a align bytes using the facilities
+    provided by the system. @a align must be a power of two and a multiple of
+    sizeof(void*). Returns nullptr on failure. The memory must be released
+    by aligned_free.
+*/
+inline void* aligned_malloc(std::size_t size, std::size_t align)
+{
+#if defined(_WIN32)
+    return _aligned_malloc(size, align);
+#elif defined(__unix__) || defined(__APPLE__)
+    void* p = nullptr;
+    if (posix_memalign(&p, align, size) != 0) {
+        return nullptr;
+    }
+    return p;
+#else
+    // Same approach as in aligned_allocator: over-allocate and store the
+    // original pointer just before the returned location
+    std::size_t al = align < 2*sizeof(void*) ? 2*sizeof(void*) : align;
+    char* pv = static_cast<char*>(std::malloc(size + al));
+    if (!pv) {
+        return nullptr;
+    }
+    std::uintptr_t upv = reinterpret_cast<std::uintptr_t>(pv);
+    upv = (upv + al) & ~(al - 1);
+    char** aligned_pv = reinterpret_cast<char**>(upv);
+    *(aligned_pv-1) = pv;
+    return aligned_pv;
+#endif
+}
+
+inline void aligned_free(void* p)
+{
+#if defined(_WIN32)
+    _aligned_free(p);
+#elif defined(__unix__) || defined(__APPLE__)
+    std::free(p);
+#else
+    if (p) {
+        std::free(*(static_cast<char**>(p) - 1));
+    }
+#endif
+}
+
+/*  Asks the operating system to back the given memory range with huge pages.
+    This is only a hint, thus failures are ignored.
+*/
+inline void advise_huge_pages(void* p, std::size_t size)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    madvise(p, size, MADV_HUGEPAGE);
+#else
+    (void) p; (void) size;
+#endif
+}
+
+} // namespace detail
+
+/** An allocator that allocates memory with stricter alignment requirements
+    than the defaults using the aligned allocation functions of the system,
+    i.e. @c posix_memalign or @c _aligned_malloc. Unlike @a aligned_allocator
+    no memory is wasted for padding. @a A must be a power of two.
+
+    Optionally, allocations of at least @a huge_page_threshold bytes are
+    aligned to and padded to the huge page size and the operating system is
+    advised to back them by transparent huge pages (@c MADV_HUGEPAGE on
+    Linux). This reduces TLB misses when accessing large buffers. The
+    threshold is part of the allocator state and is disabled by default.
+*/
+template<class T, std::size_t A>
+class system_aligned_allocator {
+private:
+
+    static_assert(!(A & (A - 1)), "A is not a power of two");
+
+public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    /// The size of huge pages assumed by the allocator
+    static const std::size_t huge_page_size = std::size_t(2) << 20;
+
+    system_aligned_allocator() : huge_page_threshold_(0) {}
+
+    /** Creates an allocator that uses huge pages for allocations of at least
+        @a huge_page_threshold bytes. Zero disables huge pages.
+    */
+    explicit system_aligned_allocator(std::size_t huge_page_threshold) :
+        huge_page_threshold_(huge_page_threshold) {}
+
+    system_aligned_allocator(const system_aligned_allocator&) = default;
+
+    template<class U>
+    system_aligned_allocator(const system_aligned_allocator<U,A>& other) :
+        huge_page_threshold_(other.huge_page_threshold()) {}
+
+    ~system_aligned_allocator() = default;
+
+    system_aligned_allocator& operator=(const system_aligned_allocator&) = default;
+
+    template<class U>
+    struct rebind {
+        using other = system_aligned_allocator<U,A>;
+    };
+
+    std::size_t huge_page_threshold() const
+    {
+        return huge_page_threshold_;
+    }
+
+    T* address(T& x) const
+    {
+        return &x;
+    }
+
+    std::size_t max_size() const
+    {
+        return (static_cast<std::size_t>(0) - static_cast<std::size_t>(1)) / sizeof(T);
+    }
+
+    template<class U>
+    bool operator!=(const system_aligned_allocator<U,A>& other) const
+    {
+        return huge_page_threshold_ != other.huge_page_threshold();
+    }
+
+    template<class U>
+    bool operator==(const system_aligned_allocator<U,A>& other) const
+    {
+        return huge_page_threshold_ == other.huge_page_threshold();
+    }
+
+    void construct(T* p, const T& t) const
+    {
+        void* pv = static_cast<void*>(p);
+        new (pv) T(t);
+    }
+
+    void destroy(T* p) const
+    {
+        p->~T();
+    }
+
+    T* allocate(std::size_t n) const
+    {
+        if (n == 0) {
+            return nullptr;
+        }
+
+        if (n > max_size()) {
+            throw std::length_error("system_aligned_allocator<T,A>::allocate() - Integer overflow.");
+        }
+
+        std::size_t size = n * sizeof(T);
+        std::size_t al = A < sizeof(void*) ? sizeof(void*) : A;
+        bool huge = use_huge_pages(size);
+        if (huge) {
+            al = al < huge_page_size ? huge_page_size : al;
+            size = round_to_huge_page(size);
+        }
+
+        void* p = detail::aligned_malloc(size, al);
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        if (huge) {
+            detail::advise_huge_pages(p, size);
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, std::size_t n) const
+    {
+        (void) n;
+        if (!p) {
+            return;
+        }
+        detail::aligned_free(p);
+    }
+
+    template<class U>
+    T * allocate(std::size_t n, const U* hint) const
+    {
+        (void) hint;
+        return allocate(n);
+    }
+
+private:
+    bool use_huge_pages(std::size_t size) const
+    {
+        return huge_page_threshold_ != 0 && size >= huge_page_threshold_;
+    }
+
+    static std::size_t round_to_huge_page(std::size_t size)
+    {
+        return (size + huge_page_size - 1) & ~(huge_page_size - 1);
+    }
+
+    std::size_t huge_page_threshold_;
+};
+
+template<class T, std::size_t A>
+const std::size_t system_aligned_allocator<T,A>::huge_page_size;
+
 } // namespace SIMDPP_ARCH_NAMESPACE
 } // namespace simdpp
 
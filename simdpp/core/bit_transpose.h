@@ -0,0 +1,55 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_BIT_TRANSPOSE_H
+#define LIBSIMDPP_SIMDPP_CORE_BIT_TRANSPOSE_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/insn/bit_transpose.h>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Transposes 8x8 bit matrices. Each group of 8 consecutive bytes holds one
+    matrix: the byte at offset i within the group is row i and bit j of that
+    byte is column j.
+
+    @code
+    r[8*m+i] bit j = a[8*m+j] bit i
+    @endcode
+
+    The matrices are transposed using three masked swaps of bits within
+    64-bit elements, thus each vector width processes N/8 matrices at the
+    same cost.
+
+    @par 128-bit version:
+    @icost{SSE2-AVX2, NEON, ALTIVEC, 18}
+
+    @par 256-bit version:
+    @icost{SSE2-AVX, NEON, ALTIVEC, 36}
+    @icost{AVX2, 18}
+*/
+template<unsigned N, class E> SIMDPP_INL
+uint8<N,expr_empty> bit_transpose8x8(const uint8<N,E>& a)
+{
+    return detail::insn::i_bit_transpose8x8(a.eval());
+}
+
+template<unsigned N, class E> SIMDPP_INL
+int8<N,expr_empty> bit_transpose8x8(const int8<N,E>& a)
+{
+    return detail::insn::i_bit_transpose8x8(uint8<N>(a.eval()));
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,145 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_BLOOM_FILTER_H
+#define LIBSIMDPP_SIMDPP_CORE_BLOOM_FILTER_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/aligned_allocator.h>
+#include <simdpp/detail/bloom_filter.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** A split block Bloom filter.
+
+    The filter is an array of 256-bit blocks. Each key sets or tests 8 bits
+    within a single block, one in each 32-bit word, thus an insertion or a
+    probe touches a single cache line and is performed using a few vector
+    operations on a @c uint32<8> vector.
+
+    The filter stores 64-bit hashes of the keys rather than the keys
+    themselves. The hashes must be well distributed in both the upper and
+    the lower 32 bits, e.g. computed using hash64().
+
+    @code
+    bloom_filter filter(bloom_filter::optimal_num_bits(keys.size(), 0.01));
+    for (uint64_t k : keys)
+        filter.insert(hash64(k));
+    bool maybe = filter.contains(hash64(x));
+    @endcode
+
+    The layout of the filter does not depend on the instruction set and is
+    compatible with the split block Bloom filters of Apache Parquet.
+*/
+class bloom_filter {
+public:
+    using size_type = std::size_t;
+
+    /// The number of bits in a block
+    static const unsigned block_bits = detail::bloom_block_words * 32;
+
+    /// Creates an empty filter of at least @a num_bits bits
+    explicit bloom_filter(size_type num_bits)
+    {
+        num_blocks_ = std::max<size_type>(1, (num_bits + block_bits - 1) / block_bits);
+        blocks_.assign(num_blocks_ * detail::bloom_block_words, 0);
+    }
+
+    /** Returns the number of bits of a filter that holds @a num_keys keys
+        with the false positive rate of at most @a fpp.
+    */
+    static size_type optimal_num_bits(size_type num_keys, double fpp)
+    {
+        double k = detail::bloom_block_words;
+        double bits = -k * double(num_keys) / std::log(1.0 - std::pow(fpp, 1.0 / k));
+        return std::max<size_type>(block_bits, size_type(bits));
+    }
+
+    /// Returns the number of bits in the filter
+    size_type num_bits() const { return num_blocks_ * block_bits; }
+
+    /// Removes all keys from the filter
+    void clear()
+    {
+        std::fill(blocks_.begin(), blocks_.end(), 0);
+    }
+
+    /// Inserts a key with the given hash
+    void insert(uint64_t hash)
+    {
+        detail::bloom_insert(block(hash), hash);
+    }
+
+    /// Inserts @a n keys with the given hashes
+    void insert_many(const uint64_t* hashes, size_type n)
+    {
+        for (size_type i = 0; i < n; ++i) {
+            insert(hashes[i]);
+        }
+    }
+
+    /** Returns false if a key with the given hash has definitely not been
+        inserted. Returns true if it might have been.
+    */
+    bool contains(uint64_t hash) const
+    {
+        return detail::bloom_contains(block(hash), hash);
+    }
+
+    /** Computes contains(hashes[i]) for each of the @a n hashes and stores the
+        results to @a out.
+
+        On AVX2 and AVX-512 several keys are tested at once: each word of the
+        blocks of the keys is loaded using a single gather instruction.
+    */
+    void contains_many(const uint64_t* hashes, size_type n, bool* out) const
+    {
+        detail::bloom_contains_many(blocks_.data(), num_blocks_, hashes, n, out);
+    }
+
+    /// Adds all keys of @a other, which must have the same size, to the filter
+    void merge(const bloom_filter& other)
+    {
+        for (size_type i = 0; i < blocks_.size(); ++i) {
+            blocks_[i] |= other.blocks_[i];
+        }
+    }
+
+    /// Returns the words of the blocks
+    const uint32_t* data() const { return blocks_.data(); }
+
+private:
+    uint32_t* block(uint64_t hash)
+    {
+        size_type b = detail::bloom_block_index(hash, num_blocks_);
+        return blocks_.data() + b * detail::bloom_block_words;
+    }
+
+    const uint32_t* block(uint64_t hash) const
+    {
+        size_type b = detail::bloom_block_index(hash, num_blocks_);
+        return blocks_.data() + b * detail::bloom_block_words;
+    }
+
+    std::vector<uint32_t, aligned_allocator<uint32_t, 32>> blocks_;
+    size_type num_blocks_;
+};
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -16,44 +16,73 @@
 namespace simdpp {
 namespace SIMDPP_ARCH_NAMESPACE {
 
-/** Prefetches data to the lowest level cache for reading.
-
-    @param ptr pointer to the data to prefetch
+/** Specifies which level of the cache hierarchy the prefetched data should be
+    placed into. The values correspond to the locality argument of
+    @c __builtin_prefetch.
 */
-template<class T>
-SIMDPP_INL void prefetch_read(const T* ptr)
+enum class prefetch_locality {
+    /// Non-temporal data. The data is fetched close to the processor, but
+    /// cache pollution is minimized. Maps to @c _MM_HINT_NTA on x86 and
+    /// @c PLDL1STRM on ARM64.
+    nta = 0,
+    /// Low temporal locality. Maps to @c _MM_HINT_T2 on x86 and @c PLDL3KEEP
+    /// on ARM64.
+    t2 = 1,
+    /// Moderate temporal locality. Maps to @c _MM_HINT_T1 on x86 and
+    /// @c PLDL2KEEP on ARM64.
+    t1 = 2,
+    /// High temporal locality, the data is fetched into all cache levels.
+    /// Maps to @c _MM_HINT_T0 on x86 and @c PLDL1KEEP on ARM64.
+    t0 = 3
+};
+
+namespace detail {
+
+template<prefetch_locality L, bool Write>
+SIMDPP_INL void prefetch(const char* ptr)
 {
 #if SIMDPP_USE_SSE2
-    _mm_prefetch(reinterpret_cast<const char*>(ptr), _MM_HINT_T0);
+    switch (L) {
+    case prefetch_locality::nta: _mm_prefetch(ptr, _MM_HINT_NTA); break;
+    case prefetch_locality::t2:  _mm_prefetch(ptr, _MM_HINT_T2); break;
+    case prefetch_locality::t1:  _mm_prefetch(ptr, _MM_HINT_T1); break;
+    case prefetch_locality::t0:  _mm_prefetch(ptr, _MM_HINT_T0); break;
+    }
 #elif SIMDPP_USE_NEON || SIMDPP_USE_ALTIVEC || SIMDPP_USE_MSA
 #if __GNUC__
-    // on NEON results in PLD
-    // on Altivec results in DST
+    // on NEON results in PLD/PLDW or PRFM with the respective cache level
+    // on Altivec results in DST/DSTST
     // on MSA results in PREF
-    __builtin_prefetch(ptr, 0);
+    __builtin_prefetch(ptr, Write ? 1 : 0, static_cast<int>(L));
 #endif
 #endif
     (void) ptr;
 }
 
-/** Prefetches data to the lowest level cache for writing.
+} // namespace detail
+
+/** Prefetches data to the cache for reading.
+
+    @tparam L the cache level to fetch the data into. By default the data is
+        fetched into the lowest level cache.
+    @param ptr pointer to the data to prefetch
+*/
+template<prefetch_locality L = prefetch_locality::t0, class T>
+SIMDPP_INL void prefetch_read(const T* ptr)
+{
+    detail::prefetch<L, false>(reinterpret_cast<const char*>(ptr));
+}
+
+/** Prefetches data to the cache for writing.
 
+    @tparam L the cache level to fetch the data into. By default the data is
+        fetched into the lowest level cache.
     @param ptr pointer to the data to prefetch
 */
-template<class T>
+template<prefetch_locality L = prefetch_locality::t0, class T>
 SIMDPP_INL void prefetch_write(const T* ptr)
 {
-#if SIMDPP_USE_SSE2
-    _mm_prefetch(reinterpret_cast<const char*>(ptr), _MM_HINT_T0);
-#elif SIMDPP_USE_NEON || SIMDPP_USE_ALTIVEC || SIMDPP_USE_MSA
-#if __GNUC__
-    // on NEON results in PLDW
-    // on Altivec results in DSTST
-    // on MSA results in PREF
-    __builtin_prefetch(ptr, 1);
-#endif
-#endif
-    (void) ptr;
+    detail::prefetch<L, true>(reinterpret_cast<const char*>(ptr));
 }
 
 } // namespace SIMDPP_ARCH_NAMESPACE
@@ -39,6 +39,10 @@ SIMDPP_INL uint32_t extract_bits_any(const uint8<32>& a)
 {
     return detail::insn::i_extract_bits_any(a);
 }
+SIMDPP_INL uint64_t extract_bits_any(const uint8<64>& a)
+{
+    return detail::insn::i_extract_bits_any(a);
+}
 
 /** Extracts specific bit from each byte of each element of a int8x16 vector.
 
@@ -58,6 +62,12 @@ uint32_t extract_bits(const uint8<32>& a)
     static_assert(id < 8, "index out of bounds");
     return detail::insn::i_extract_bits<id>(a);
 }
+template<unsigned id> SIMDPP_INL
+uint64_t extract_bits(const uint8<64>& a)
+{
+    static_assert(id < 8, "index out of bounds");
+    return detail::insn::i_extract_bits<id>(a);
+}
 
 } // namespace SIMDPP_ARCH_NAMESPACE
 } // namespace simdpp
@@ -0,0 +1,440 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_FLAT_HASH_MAP_H
+#define LIBSIMDPP_SIMDPP_CORE_FLAT_HASH_MAP_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/aligned_allocator.h>
+#include <simdpp/core/cache.h>
+#include <simdpp/detail/flat_hash_map.h>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** An open-addressing hash map that stores its elements in a single array.
+
+    Each slot has a control byte that holds 7 bits of the hash of the key.
+    The control bytes of a group of @a group_size consecutive slots are
+    compared against the searched hash at once, thus usually only one key
+    comparison is performed per lookup. @a group_size is the size of the
+    widest native 8-bit integer vector, e.g. 16 on SSE2, 32 on AVX2 and 64 on
+    AVX-512BW. Consequently, the layout of the map depends on the instruction
+    set; when using dynamic dispatch, the code that builds and the code that
+    queries a map must be compiled for the same instruction set.
+
+    The maximum load factor is 7/8. Pointers to elements are invalidated by
+    insertions that cause the map to grow. Erased elements leave tombstones
+    that are removed when the map is rehashed.
+
+    Iteration is provided via @a for_each instead of iterators.
+*/
+template<class Key, class T,
+         class Hash = std::hash<Key>,
+         class KeyEqual = std::equal_to<Key>>
+class flat_hash_map {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+    /// The number of slots whose control bytes are compared at once
+    static const unsigned group_size = detail::mem_vector_size;
+
+    /// The number of keys that are in flight in find_many()
+    static const unsigned batch_size = 16;
+
+    explicit flat_hash_map(const Hash& hash = Hash(),
+                           const KeyEqual& eq = KeyEqual()) :
+        ctrl_(nullptr), slots_(nullptr), size_(0), capacity_(0),
+        growth_left_(0), hash_(hash), eq_(eq)
+    {}
+
+    explicit flat_hash_map(size_type n, const Hash& hash = Hash(),
+                           const KeyEqual& eq = KeyEqual()) :
+        flat_hash_map(hash, eq)
+    {
+        reserve(n);
+    }
+
+    flat_hash_map(const flat_hash_map& other) :
+        flat_hash_map(other.hash_, other.eq_)
+    {
+        reserve(other.size_);
+        other.for_each([this](const Key& k, const T& v) { insert(k, v); });
+    }
+
+    flat_hash_map(flat_hash_map&& other) :
+        ctrl_(other.ctrl_), slots_(other.slots_), size_(other.size_),
+        capacity_(other.capacity_), growth_left_(other.growth_left_),
+        hash_(other.hash_), eq_(other.eq_)
+    {
+        other.release();
+    }
+
+    ~flat_hash_map()
+    {
+        destroy();
+    }
+
+    flat_hash_map& operator=(const flat_hash_map& other)
+    {
+        if (this != &other) {
+            flat_hash_map copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    flat_hash_map& operator=(flat_hash_map&& other)
+    {
+        if (this != &other) {
+            destroy();
+            ctrl_ = other.ctrl_;
+            slots_ = other.slots_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            growth_left_ = other.growth_left_;
+            hash_ = other.hash_;
+            eq_ = other.eq_;
+            other.release();
+        }
+        return *this;
+    }
+
+    void swap(flat_hash_map& other)
+    {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(growth_left_, other.growth_left_);
+        std::swap(hash_, other.hash_);
+        std::swap(eq_, other.eq_);
+    }
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /// Returns the number of slots. This is always a power of two.
+    size_type capacity() const { return capacity_; }
+
+    /// Removes all elements. The capacity is not changed.
+    void clear()
+    {
+        for (size_type i = 0; i < capacity_; ++i) {
+            if (is_full(i)) {
+                slots_[i].~value_type();
+            }
+        }
+        if (capacity_ > 0) {
+            std::memset(ctrl_, detail::hash_ctrl_empty, capacity_ + group_size);
+        }
+        size_ = 0;
+        growth_left_ = max_load(capacity_);
+    }
+
+    /// Ensures that @a n elements can be stored without rehashing
+    void reserve(size_type n)
+    {
+        if (n > size_ + growth_left_) {
+            rehash(capacity_for(n));
+        }
+    }
+
+    /** Inserts @a value under @a key if the key is not present. Returns a
+        pointer to the value stored under the key and whether the insertion
+        took place.
+    */
+    std::pair<T*, bool> insert(const Key& key, const T& value)
+    {
+        uint64_t h = hash_key(key);
+        size_type i = find_index(key, h);
+        if (i != npos) {
+            return std::make_pair(&slots_[i].second, false);
+        }
+        i = prepare_insert(h);
+        new (&slots_[i]) value_type(key, value);
+        return std::make_pair(&slots_[i].second, true);
+    }
+
+    /// Returns a reference to the value under @a key, inserting a
+    /// value-initialized value if the key is not present
+    T& operator[](const Key& key)
+    {
+        uint64_t h = hash_key(key);
+        size_type i = find_index(key, h);
+        if (i == npos) {
+            i = prepare_insert(h);
+            new (&slots_[i]) value_type(key, T());
+        }
+        return slots_[i].second;
+    }
+
+    /// Returns a pointer to the value under @a key or nullptr if not found
+    T* find(const Key& key)
+    {
+        size_type i = find_index(key, hash_key(key));
+        return i == npos ? nullptr : &slots_[i].second;
+    }
+
+    const T* find(const Key& key) const
+    {
+        size_type i = find_index(key, hash_key(key));
+        return i == npos ? nullptr : &slots_[i].second;
+    }
+
+    bool contains(const Key& key) const
+    {
+        return find_index(key, hash_key(key)) != npos;
+    }
+
+    /// Removes the element under @a key. Returns whether it was present.
+    bool erase(const Key& key)
+    {
+        size_type i = find_index(key, hash_key(key));
+        if (i == npos) {
+            return false;
+        }
+        slots_[i].~value_type();
+        set_ctrl(i, detail::hash_ctrl_deleted);
+        size_--;
+        return true;
+    }
+
+    /** Looks up @a n keys and stores pointers to the corresponding values, or
+        nullptr for the missing keys, to @a out.
+
+        The keys are processed in batches of @a batch_size. The hashes of
+        the whole batch are computed first and the first probed group of
+        control bytes and slots of each key is prefetched. Thus the cache
+        misses of the keys in a batch overlap instead of being serialized.
+    */
+    void find_many(const Key* keys, size_type n, const T** out) const
+    {
+        uint64_t h[batch_size];
+        for (size_type b = 0; b < n; b += batch_size) {
+            unsigned count = n - b < batch_size ? unsigned(n - b) : batch_size;
+            for (unsigned k = 0; k < count; ++k) {
+                h[k] = hash_key(keys[b + k]);
+                if (capacity_ > 0) {
+                    size_type pos = detail::hash_h1(h[k]) & (capacity_ - 1);
+                    prefetch_read(ctrl_ + pos);
+                    prefetch_read(slots_ + pos);
+                }
+            }
+            for (unsigned k = 0; k < count; ++k) {
+                size_type i = find_index(keys[b + k], h[k]);
+                out[b + k] = i == npos ? nullptr : &slots_[i].second;
+            }
+        }
+    }
+
+    /// Calls f(key, value) for each element in unspecified order
+    template<class F>
+    void for_each(F f) const
+    {
+        for (size_type i = 0; i < capacity_; ++i) {
+            if (is_full(i)) {
+                f(static_cast<const Key&>(slots_[i].first),
+                  static_cast<const T&>(slots_[i].second));
+            }
+        }
+    }
+
+    template<class F>
+    void for_each(F f)
+    {
+        for (size_type i = 0; i < capacity_; ++i) {
+            if (is_full(i)) {
+                f(static_cast<const Key&>(slots_[i].first), slots_[i].second);
+            }
+        }
+    }
+
+private:
+    static const size_type npos = size_type(-1);
+
+    using ctrl_allocator = aligned_allocator<uint8_t, 64>;
+    using slot_allocator = std::allocator<value_type>;
+
+    static size_type max_load(size_type capacity)
+    {
+        return capacity - capacity / 8;
+    }
+
+    static size_type capacity_for(size_type n)
+    {
+        size_type c = group_size;
+        while (max_load(c) < n) {
+            c *= 2;
+        }
+        return c;
+    }
+
+    uint64_t hash_key(const Key& key) const
+    {
+        return detail::hash_mix(static_cast<uint64_t>(hash_(key)));
+    }
+
+    bool is_full(size_type i) const
+    {
+        return (ctrl_[i] & 0x80) == 0;
+    }
+
+    // The control bytes of the first group are mirrored past the end, so
+    // that a group can be loaded at any position without wrapping around
+    void set_ctrl(size_type i, uint8_t c)
+    {
+        ctrl_[i] = c;
+        if (i < group_size) {
+            ctrl_[capacity_ + i] = c;
+        }
+    }
+
+    size_type find_index(const Key& key, uint64_t h) const
+    {
+        if (capacity_ == 0) {
+            return npos;
+        }
+        uint8_t h2 = detail::hash_h2(h);
+        detail::hash_probe_seq seq(detail::hash_h1(h), capacity_ - 1);
+        for (;;) {
+            const uint8_t* g = ctrl_ + seq.pos();
+            uint64_t m = detail::hash_group_match(g, h2);
+            while (m != 0) {
+                size_type i = seq.index(detail::bit_scan_forward(m));
+                if (eq_(slots_[i].first, key)) {
+                    return i;
+                }
+                m &= m - 1;
+            }
+            if (detail::hash_group_match(g, detail::hash_ctrl_empty) != 0) {
+                return npos;
+            }
+            seq.next();
+        }
+    }
+
+    // Returns the first empty or deleted slot in the probe sequence of h
+    size_type find_free(uint64_t h) const
+    {
+        detail::hash_probe_seq seq(detail::hash_h1(h), capacity_ - 1);
+        for (;;) {
+            uint64_t m = detail::hash_group_match_free(ctrl_ + seq.pos());
+            if (m != 0) {
+                return seq.index(detail::bit_scan_forward(m));
+            }
+            seq.next();
+        }
+    }
+
+    // Marks a free slot for a new element with the given hash as full and
+    // returns its index. Grows or cleans up the map if needed.
+    size_type prepare_insert(uint64_t h)
+    {
+        size_type i = capacity_ > 0 ? find_free(h) : npos;
+        if (i == npos || (growth_left_ == 0 && ctrl_[i] == detail::hash_ctrl_empty)) {
+            // Rehashing to the same capacity removes the tombstones
+            rehash(capacity_for(size_ + 1));
+            i = find_free(h);
+        }
+        if (ctrl_[i] == detail::hash_ctrl_empty) {
+            growth_left_--;
+        }
+        set_ctrl(i, detail::hash_h2(h));
+        size_++;
+        return i;
+    }
+
+    void rehash(size_type capacity)
+    {
+        uint8_t* old_ctrl = ctrl_;
+        value_type* old_slots = slots_;
+        size_type old_capacity = capacity_;
+
+        ctrl_ = ctrl_allocator().allocate(capacity + group_size);
+        slots_ = slot_allocator().allocate(capacity);
+        capacity_ = capacity;
+        std::memset(ctrl_, detail::hash_ctrl_empty, capacity + group_size);
+
+        for (size_type i = 0; i < old_capacity; ++i) {
+            if ((old_ctrl[i] & 0x80) == 0) {
+                uint64_t h = hash_key(old_slots[i].first);
+                size_type j = find_free(h);
+                set_ctrl(j, detail::hash_h2(h));
+                new (&slots_[j]) value_type(std::move(old_slots[i]));
+                old_slots[i].~value_type();
+            }
+        }
+        growth_left_ = max_load(capacity_) - size_;
+
+        if (old_capacity > 0) {
+            ctrl_allocator().deallocate(old_ctrl, old_capacity + group_size);
+            slot_allocator().deallocate(old_slots, old_capacity);
+        }
+    }
+
+    void destroy()
+    {
+        if (capacity_ == 0) {
+            return;
+        }
+        for (size_type i = 0; i < capacity_; ++i) {
+            if (is_full(i)) {
+                slots_[i].~value_type();
+            }
+        }
+        ctrl_allocator().deallocate(ctrl_, capacity_ + group_size);
+        slot_allocator().deallocate(slots_, capacity_);
+        release();
+    }
+
+    void release()
+    {
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+        growth_left_ = 0;
+    }
+
+    uint8_t* ctrl_;
+    value_type* slots_;
+    size_type size_;
+    size_type capacity_;
+    // The number of empty slots that may still be filled before rehashing
+    size_type growth_left_;
+    Hash hash_;
+    KeyEqual eq_;
+};
+
+template<class Key, class T, class Hash, class KeyEqual>
+const unsigned flat_hash_map<Key, T, Hash, KeyEqual>::group_size;
+template<class Key, class T, class Hash, class KeyEqual>
+const unsigned flat_hash_map<Key, T, Hash, KeyEqual>::batch_size;
+template<class Key, class T, class Hash, class KeyEqual>
+const typename flat_hash_map<Key, T, Hash, KeyEqual>::size_type
+    flat_hash_map<Key, T, Hash, KeyEqual>::npos;
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,52 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_LOAD_STRIDED_H
+#define LIBSIMDPP_SIMDPP_CORE_LOAD_STRIDED_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/insn/load_strided.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Loads every @a Stride-th element starting from @a p into a vector.
+
+    @code
+    a = [ *(p), *(p+Stride), *(p+Stride*2), ... , *(p+Stride*(M-1)) ]
+    @endcode
+
+    Here M is the number of elements in the vector. @a Stride is expressed
+    in elements of the vector. This is useful to load a single field of an
+    array of structures or to decimate a signal.
+
+    Strides of up to 4 elements are loaded as whole vectors and de-interleaved
+    using shuffles, thus the memory range <tt>[p, p+Stride*M)</tt> must be
+    readable. Larger strides of 32 and 64-bit elements are loaded using gather
+    instructions when available.
+
+    @a p must be aligned to the element size.
+*/
+template<unsigned Stride, unsigned N, class V, class T> SIMDPP_INL
+void load_strided(any_vec<N,V>& a, const T* p)
+{
+    static_assert(!is_mask<V>::value, "Mask types can not be loaded");
+    static_assert(Stride > 0, "Stride must be positive");
+    typename detail::get_expr_nosign<V>::type ra;
+    detail::insn::i_load_strided<Stride>(ra, reinterpret_cast<const char*>(p));
+    a.wrapped() = ra;
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,50 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_PREFIX_SUM_H
+#define LIBSIMDPP_SIMDPP_CORE_PREFIX_SUM_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/insn/prefix_sum.h>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Computes the inclusive prefix sums of the elements of the vector. Integer
+    sums wrap around on overflow.
+
+    @code
+    r0 = a0
+    r1 = a0 + a1
+    ...
+    rN = a0 + a1 + ... + aN
+    @endcode
+
+    Within each 128-bit block the sums are computed in log2(elements per
+    block) steps, each of which adds the vector moved to the right by 1, 2,
+    4, ... elements. The totals of the blocks are then broadcast and added
+    to the following blocks.
+
+    The floating-point sums are computed in a different order than
+    sequential summation, thus the results may differ due to rounding.
+*/
+template<unsigned N, class V> SIMDPP_INL
+typename detail::get_expr_nomask<V>::empty
+        prefix_sum(const any_vec<N,V>& a)
+{
+    typename detail::get_expr_nomask<V>::type ra = a.wrapped().eval();
+    return detail::insn::i_prefix_sum(ra);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,242 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_CORE_SIMD_ARENA_H
+#define LIBSIMDPP_CORE_SIMD_ARENA_H
+
+#include <simdpp/core/aligned_allocator.h>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** A pool allocator for short-lived scratch buffers.
+
+    Memory is carved from large blocks obtained from the system. Requests are
+    rounded up to a power of two size class between @a min_size and
+    @a max_size bytes. Released buffers are kept in a free list for each size
+    class and are reused by subsequent allocations of the same class, thus in
+    steady state no calls to the system allocator are made. Larger requests
+    are forwarded to the system allocator directly. The blocks are returned to
+    the system only when the arena is destroyed.
+
+    All returned buffers are aligned to @a min_size bytes, which is sufficient
+    for any vector type.
+
+    The arena is not thread-safe. Use @a thread_arena to get an arena local to
+    the current thread.
+*/
+class simd_arena {
+public:
+    /// The smallest size class and the alignment of all buffers
+    static const std::size_t min_size = 64;
+    /// The largest size class. Larger buffers are allocated from the system
+    static const std::size_t max_size = std::size_t(64) << 10;
+
+    /** Creates an arena that obtains memory from the system in blocks of
+        @a block_size bytes.
+    */
+    explicit simd_arena(std::size_t block_size = std::size_t(1) << 20) :
+        block_size_(block_size < max_size + min_size ? max_size + min_size
+                                                     : block_size),
+        blocks_(nullptr),
+        cur_(nullptr),
+        end_(nullptr)
+    {
+        for (unsigned i = 0; i < num_classes; ++i) {
+            free_[i] = nullptr;
+        }
+    }
+
+    simd_arena(const simd_arena&) = delete;
+    simd_arena& operator=(const simd_arena&) = delete;
+
+    ~simd_arena()
+    {
+        while (blocks_) {
+            free_node* next = blocks_->next;
+            detail::aligned_free(blocks_);
+            blocks_ = next;
+        }
+    }
+
+    /** Allocates a buffer of at least @a size bytes aligned to @a min_size
+        bytes. Throws std::bad_alloc on failure.
+    */
+    void* allocate(std::size_t size)
+    {
+        unsigned c = size_class(size);
+        if (c == num_classes) {
+            return system_allocate(size);
+        }
+
+        if (free_[c]) {
+            free_node* n = free_[c];
+            free_[c] = n->next;
+            return n;
+        }
+
+        std::size_t bytes = min_size << c;
+        if (static_cast<std::size_t>(end_ - cur_) < bytes) {
+            new_block();
+        }
+        void* p = cur_;
+        cur_ += bytes;
+        return p;
+    }
+
+    /** Releases a buffer previously returned by @a allocate of this arena.
+        @a size must be the same as passed to @a allocate.
+    */
+    void deallocate(void* p, std::size_t size)
+    {
+        if (!p) {
+            return;
+        }
+        unsigned c = size_class(size);
+        if (c == num_classes) {
+            detail::aligned_free(p);
+            return;
+        }
+        free_node* n = static_cast<free_node*>(p);
+        n->next = free_[c];
+        free_[c] = n;
+    }
+
+private:
+    struct free_node {
+        free_node* next;
+    };
+
+    static const unsigned num_classes = 11; // 64 bytes to 64 KiB
+
+    // Returns num_classes if the size does not fit any size class
+    static unsigned size_class(std::size_t size)
+    {
+        unsigned c = 0;
+        std::size_t s = min_size;
+        while (s < size && c < num_classes) {
+            s <<= 1;
+            c++;
+        }
+        return c;
+    }
+
+    static void* system_allocate(std::size_t size)
+    {
+        void* p = detail::aligned_malloc(size, min_size);
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    void new_block()
+    {
+        // The first min_size bytes of each block link the blocks together
+        char* b = static_cast<char*>(system_allocate(block_size_));
+        free_node* n = reinterpret_cast<free_node*>(b);
+        n->next = blocks_;
+        blocks_ = n;
+        cur_ = b + min_size;
+        end_ = b + block_size_;
+    }
+
+    std::size_t block_size_;
+    free_node* blocks_;
+    char* cur_;
+    char* end_;
+    free_node* free_[num_classes];
+};
+
+/** Returns an arena local to the calling thread. The arena is destroyed when
+    the thread exits, thus buffers allocated from it must not outlive the
+    thread.
+*/
+inline simd_arena& thread_arena()
+{
+    static thread_local simd_arena arena;
+    return arena;
+}
+
+/** A standard allocator that allocates memory from a @a simd_arena. By
+    default the arena of the current thread is used. The memory must be
+    deallocated through an allocator referring to the same arena.
+*/
+template<class T>
+class arena_allocator {
+public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    arena_allocator() : arena_(&thread_arena()) {}
+    explicit arena_allocator(simd_arena& arena) : arena_(&arena) {}
+    arena_allocator(const arena_allocator&) = default;
+
+    template<class U>
+    arena_allocator(const arena_allocator<U>& other) : arena_(other.arena()) {}
+
+    arena_allocator& operator=(const arena_allocator&) = default;
+
+    template<class U>
+    struct rebind {
+        using other = arena_allocator<U>;
+    };
+
+    simd_arena* arena() const
+    {
+        return arena_;
+    }
+
+    std::size_t max_size() const
+    {
+        return (static_cast<std::size_t>(0) - static_cast<std::size_t>(1)) / sizeof(T);
+    }
+
+    template<class U>
+    bool operator!=(const arena_allocator<U>& other) const
+    {
+        return arena_ != other.arena();
+    }
+
+    template<class U>
+    bool operator==(const arena_allocator<U>& other) const
+    {
+        return arena_ == other.arena();
+    }
+
+    T* allocate(std::size_t n) const
+    {
+        if (n == 0) {
+            return nullptr;
+        }
+        if (n > max_size()) {
+            throw std::length_error("arena_allocator<T>::allocate() - Integer overflow.");
+        }
+        return static_cast<T*>(arena_->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) const
+    {
+        arena_->deallocate(p, n * sizeof(T));
+    }
+
+private:
+    simd_arena* arena_;
+};
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,264 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_SIMD_VECTOR_H
+#define LIBSIMDPP_SIMDPP_CORE_SIMD_VECTOR_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/aligned_allocator.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/traits.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** A contiguous container of arithmetic values, the storage of which is
+    aligned and padded so that whole vectors can be loaded from and stored to
+    any position that is a multiple of the vector length.
+
+    The capacity is always a multiple of @a pad_length, the number of elements
+    in the widest vector supported by any instruction set. Thus a
+    loop such as the following needs no epilogue for the last, partial
+    vector:
+
+    @code
+    simd_vector<float> v = ...;
+    for (std::size_t i = 0; i < v.size(); i += 8) {
+        float32<8> x = v.load<8>(i);
+        v.store<8>(i, mul(x, x));
+    }
+    @endcode
+
+    The elements between size() and capacity() are always initialized, but
+    their values are unspecified. Stores may overwrite them.
+
+    The storage is allocated using @a aligned_allocator.
+*/
+template<class T>
+class simd_vector {
+    static_assert(std::is_arithmetic<T>::value,
+                  "Only arithmetic element types are supported");
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /** The size in bytes of the widest vector supported by any instruction
+        set. The storage is aligned to it, thus the same code can use vectors
+        up to this size regardless of the instruction set it's compiled for.
+    */
+    static const std::size_t vector_bytes = 64;
+
+    /// The number of elements in the widest vector
+    static const std::size_t pad_length = vector_bytes / sizeof(T);
+
+    using allocator_type = aligned_allocator<T, vector_bytes>;
+
+    simd_vector() : data_(nullptr), size_(0), capacity_(0) {}
+
+    explicit simd_vector(size_type n) : simd_vector()
+    {
+        resize(n);
+    }
+
+    simd_vector(size_type n, const T& value) : simd_vector()
+    {
+        resize(n, value);
+    }
+
+    simd_vector(std::initializer_list<T> list) : simd_vector()
+    {
+        reserve(list.size());
+        std::memcpy(data_, list.begin(), list.size() * sizeof(T));
+        size_ = list.size();
+    }
+
+    simd_vector(const simd_vector& other) : simd_vector()
+    {
+        reserve(other.size_);
+        std::memcpy(data_, other.data_, other.size_ * sizeof(T));
+        size_ = other.size_;
+    }
+
+    simd_vector(simd_vector&& other) :
+        data_(other.data_), size_(other.size_), capacity_(other.capacity_)
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    ~simd_vector()
+    {
+        allocator_type().deallocate(data_, capacity_);
+    }
+
+    simd_vector& operator=(const simd_vector& other)
+    {
+        if (this != &other) {
+            size_ = 0;
+            reserve(other.size_);
+            std::memcpy(data_, other.data_, other.size_ * sizeof(T));
+            size_ = other.size_;
+        }
+        return *this;
+    }
+
+    simd_vector& operator=(simd_vector&& other)
+    {
+        if (this != &other) {
+            allocator_type().deallocate(data_, capacity_);
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    /// Returns size() rounded up to a multiple of @a pad_length
+    size_type padded_size() const { return round_up(size_); }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+
+    T& operator[](size_type i) { return data_[i]; }
+    const T& operator[](size_type i) const { return data_[i]; }
+
+    T& front() { return data_[0]; }
+    const T& front() const { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    iterator begin() { return data_; }
+    const_iterator begin() const { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator end() const { return data_ + size_; }
+
+    /** Loads @a N elements starting at index @a i. If @a i is a multiple of
+        @a N and less than size(), the elements past the end of the container
+        are read from the padding.
+    */
+    template<unsigned N>
+    typename detail::vector_for_element<T,N>::type load(size_type i) const
+    {
+        static_assert(N * sizeof(T) <= vector_bytes,
+                      "The vector is wider than the padding");
+        return load_u(data_ + i);
+    }
+
+    /** Stores @a N elements starting at index @a i. If @a i is a multiple of
+        @a N and less than size(), the elements past the end of the container
+        are written to the padding.
+    */
+    template<unsigned N, class V>
+    void store(size_type i, const any_vec<N*sizeof(T),V>& v)
+    {
+        static_assert(N * sizeof(T) <= vector_bytes,
+                      "The vector is wider than the padding");
+        store_u(data_ + i, v.wrapped());
+    }
+
+    void reserve(size_type n)
+    {
+        n = round_up(n);
+        if (n <= capacity_) {
+            return;
+        }
+        allocator_type alloc;
+        T* d = alloc.allocate(n);
+        if (size_ > 0) {
+            std::memcpy(d, data_, size_ * sizeof(T));
+        }
+        std::fill(d + size_, d + n, T());
+        alloc.deallocate(data_, capacity_);
+        data_ = d;
+        capacity_ = n;
+    }
+
+    void resize(size_type n)
+    {
+        resize(n, T());
+    }
+
+    void resize(size_type n, const T& value)
+    {
+        if (n > capacity_) {
+            grow(n);
+        }
+        for (size_type i = size_; i < n; ++i) {
+            data_[i] = value;
+        }
+        size_ = n;
+    }
+
+    void push_back(const T& value)
+    {
+        if (size_ == capacity_) {
+            grow(size_ + 1);
+        }
+        data_[size_++] = value;
+    }
+
+    void pop_back()
+    {
+        size_--;
+    }
+
+    void clear()
+    {
+        size_ = 0;
+    }
+
+private:
+    static size_type round_up(size_type n)
+    {
+        return (n + pad_length - 1) / pad_length * pad_length;
+    }
+
+    void grow(size_type n)
+    {
+        size_type c = capacity_ * 2;
+        reserve(c < n ? n : c);
+    }
+
+    T* data_;
+    size_type size_;
+    size_type capacity_;
+};
+
+template<class T>
+const std::size_t simd_vector<T>::vector_bytes;
+template<class T>
+const std::size_t simd_vector<T>::pad_length;
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
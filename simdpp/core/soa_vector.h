@@ -0,0 +1,309 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_SOA_VECTOR_H
+#define LIBSIMDPP_SIMDPP_CORE_SOA_VECTOR_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/aligned_allocator.h>
+#include <simdpp/detail/insn/load.h>
+#include <simdpp/detail/insn/store.h>
+#include <simdpp/detail/soa_vector.h>
+#include <simdpp/detail/traits.h>
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** A container of records with the given fields stored in an
+    array-of-structures-of-arrays (AoSoA) layout.
+
+    The elements are grouped into blocks of @a block_length elements, which is
+    equal to the number of elements in the native 32-bit floating-point
+    vector. Within each block, the values of each field are stored
+    contiguously and are aligned, thus the values of a field for a whole block
+    can be loaded or stored as a single vector without any shuffling:
+
+    @code
+    soa_vector<float, float, float> pos = ...; // x, y, z
+    using V = float32<SIMDPP_FAST_FLOAT32_SIZE>;
+    for (std::size_t b = 0; b < pos.num_blocks(); ++b) {
+        V x = pos.load<0>(b), y = pos.load<1>(b), z = pos.load<2>(b);
+        pos.store<2>(b, add(z, mul(x, y)));
+    }
+    @endcode
+
+    Each field must be a 32-bit or 64-bit arithmetic type. The values of the
+    elements past size() in the last block are initialized, but unspecified.
+
+    @a from_aos and @a to_aos convert from and to arrays of packed records.
+    If all fields have the same type and there are two to four of them, the
+    conversion uses vector shuffles.
+*/
+template<class... Fields>
+class soa_vector {
+    static_assert(sizeof...(Fields) > 0, "At least one field is required");
+public:
+    using size_type = std::size_t;
+
+    /// The number of elements in a block
+    static const unsigned block_length = SIMDPP_FAST_FLOAT32_SIZE;
+
+    /// The number of fields
+    static const unsigned num_fields = sizeof...(Fields);
+
+    /// The type of the I-th field
+    template<unsigned I>
+    using field_type = typename std::tuple_element<I, std::tuple<Fields...>>::type;
+
+    /// The vector type that holds the values of the I-th field of a block
+    template<unsigned I>
+    using vector_type = typename detail::vector_for_element<field_type<I>,
+                                                            block_length>::type;
+
+private:
+    using layout = detail::soa_layout<block_length, Fields...>;
+    using allocator_type = aligned_allocator<char, layout::align>;
+
+    static_assert(detail::soa_valid_fields<Fields...>::value,
+                  "Fields must be 32-bit or 64-bit arithmetic types");
+
+public:
+    /// The size of a single block in bytes
+    static const std::size_t block_bytes = layout::block_bytes;
+
+    /// The size of a packed record as used by from_aos() and to_aos()
+    static const std::size_t record_bytes = layout::record_bytes;
+
+    soa_vector() : data_(nullptr), size_(0), capacity_(0) {}
+
+    explicit soa_vector(size_type n) : soa_vector()
+    {
+        resize(n);
+    }
+
+    soa_vector(const soa_vector& other) : soa_vector()
+    {
+        reserve(other.size_);
+        std::memcpy(data_, other.data_, bytes(other.size_));
+        size_ = other.size_;
+    }
+
+    soa_vector(soa_vector&& other) :
+        data_(other.data_), size_(other.size_), capacity_(other.capacity_)
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    ~soa_vector()
+    {
+        allocator_type().deallocate(data_, bytes(capacity_));
+    }
+
+    soa_vector& operator=(const soa_vector& other)
+    {
+        if (this != &other) {
+            size_ = 0;
+            reserve(other.size_);
+            std::memcpy(data_, other.data_, bytes(other.size_));
+            size_ = other.size_;
+        }
+        return *this;
+    }
+
+    soa_vector& operator=(soa_vector&& other)
+    {
+        if (this != &other) {
+            allocator_type().deallocate(data_, bytes(capacity_));
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    /// Returns the number of blocks, including the last partial block
+    size_type num_blocks() const
+    {
+        return (size_ + block_length - 1) / block_length;
+    }
+
+    /// Returns the value of the I-th field of the element at index @a i
+    template<unsigned I>
+    field_type<I>& get(size_type i)
+    {
+        return *reinterpret_cast<field_type<I>*>(field_ptr<I>(i));
+    }
+
+    template<unsigned I>
+    const field_type<I>& get(size_type i) const
+    {
+        return *reinterpret_cast<const field_type<I>*>(field_ptr<I>(i));
+    }
+
+    /** Returns a pointer to the values of the I-th field of the block at
+        index @a block. The pointer is aligned to the size of
+        @a vector_type<I>.
+    */
+    template<unsigned I>
+    field_type<I>* block_data(size_type block)
+    {
+        return &get<I>(block * block_length);
+    }
+
+    template<unsigned I>
+    const field_type<I>* block_data(size_type block) const
+    {
+        return &get<I>(block * block_length);
+    }
+
+    /// Loads the values of the I-th field of the block at index @a block
+    template<unsigned I>
+    vector_type<I> load(size_type block) const
+    {
+        return detail::insn::i_load_any<vector_type<I>>(
+                reinterpret_cast<const char*>(block_data<I>(block)));
+    }
+
+    /// Stores the values of the I-th field of the block at index @a block
+    template<unsigned I, class V>
+    void store(size_type block,
+               const any_vec<block_length * sizeof(field_type<I>), V>& v)
+    {
+        detail::insn::i_store(reinterpret_cast<char*>(block_data<I>(block)),
+                              v.wrapped().eval());
+    }
+
+    void reserve(size_type n)
+    {
+        n = (n + block_length - 1) / block_length * block_length;
+        if (n <= capacity_) {
+            return;
+        }
+        allocator_type alloc;
+        char* d = alloc.allocate(bytes(n));
+        if (size_ > 0) {
+            std::memcpy(d, data_, bytes(size_));
+        }
+        std::memset(d + bytes(size_), 0, bytes(n) - bytes(size_));
+        alloc.deallocate(data_, bytes(capacity_));
+        data_ = d;
+        capacity_ = n;
+    }
+
+    /// Resizes the container. New elements are value-initialized.
+    void resize(size_type n)
+    {
+        if (n > capacity_) {
+            grow(n);
+        }
+        for (size_type i = size_; i < n; ++i) {
+            set_fields<0>(i, Fields()...);
+        }
+        size_ = n;
+    }
+
+    void push_back(const Fields&... values)
+    {
+        if (size_ == capacity_) {
+            grow(size_ + 1);
+        }
+        set_fields<0>(size_++, values...);
+    }
+
+    void clear()
+    {
+        size_ = 0;
+    }
+
+    /** Replaces the contents of the container with @a n records read from
+        @a src. Each record contains the values of all fields packed in order
+        without padding, i.e. occupies @a record_bytes bytes.
+    */
+    void from_aos(const void* src, size_type n)
+    {
+        size_ = 0;
+        reserve(n);
+        detail::soa_from_aos<block_length, Fields...>(
+                data_, reinterpret_cast<const char*>(src), n);
+        size_ = n;
+    }
+
+    /** Stores all elements of the container to @a dst as packed records.
+        @a dst must have space for size() * @a record_bytes bytes.
+    */
+    void to_aos(void* dst) const
+    {
+        detail::soa_to_aos<block_length, Fields...>(
+                reinterpret_cast<char*>(dst), data_, size_);
+    }
+
+private:
+    // Returns the number of bytes needed to store n elements in whole blocks
+    static size_type bytes(size_type n)
+    {
+        return (n + block_length - 1) / block_length * block_bytes;
+    }
+
+    template<unsigned I>
+    char* field_ptr(size_type i) const
+    {
+        return data_ + (i / block_length) * block_bytes +
+                layout::template offset<I>::value +
+                (i % block_length) * sizeof(field_type<I>);
+    }
+
+    template<unsigned I>
+    void set_fields(size_type) {}
+
+    template<unsigned I, class F, class... Rest>
+    void set_fields(size_type i, const F& value, const Rest&... rest)
+    {
+        get<I>(i) = value;
+        set_fields<I+1>(i, rest...);
+    }
+
+    void grow(size_type n)
+    {
+        size_type c = capacity_ * 2;
+        reserve(c < n ? n : c);
+    }
+
+    char* data_;
+    size_type size_;
+    size_type capacity_;
+};
+
+template<class... Fields>
+const unsigned soa_vector<Fields...>::block_length;
+template<class... Fields>
+const unsigned soa_vector<Fields...>::num_fields;
+template<class... Fields>
+const std::size_t soa_vector<Fields...>::block_bytes;
+template<class... Fields>
+const std::size_t soa_vector<Fields...>::record_bytes;
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
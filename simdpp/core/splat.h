@@ -81,7 +81,8 @@ typename detail::get_expr_nomask<V>::empty
         splat(const any_vec<N,V>& a)
 {
     static_assert(s < V::length, "Access out of bounds");
-    typename detail::get_expr_nomask<V>::type ra = a.wrapped().eval();
+    typename detail::get_expr_nomask_nosign<V>::type ra;
+    ra = a.wrapped().eval();
     return detail::insn::i_splat<s>(ra);
 }
 
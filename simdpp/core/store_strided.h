@@ -0,0 +1,46 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_CORE_STORE_STRIDED_H
+#define LIBSIMDPP_SIMDPP_CORE_STORE_STRIDED_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/insn/store_strided.h>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/** Stores the elements of a vector to every @a Stride-th location starting
+    from @a p.
+
+    @code
+    [ *(p), *(p+Stride), *(p+Stride*2), ... , *(p+Stride*(M-1)) ] = a
+    @endcode
+
+    Here M is the number of elements in the vector. @a Stride is expressed
+    in elements of the vector. The locations in between are not modified.
+    Scatter instructions are used for 32 and 64-bit elements when available.
+
+    @a p must be aligned to the element size.
+*/
+template<unsigned Stride, class T, unsigned N, class V> SIMDPP_INL
+void store_strided(T* p, const any_vec<N,V>& a)
+{
+    static_assert(!is_mask<V>::value, "Mask types can not be stored"); // FIXME
+    static_assert(Stride > 0, "Stride must be positive");
+    detail::insn::i_store_strided<Stride>(reinterpret_cast<char*>(p),
+                                          a.wrapped().eval());
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
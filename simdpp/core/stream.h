@@ -14,6 +14,8 @@
 
 #include <simdpp/types.h>
 #include <simdpp/detail/insn/stream.h>
+#include <simdpp/detail/traits.h>
+#include <simdpp/types/traits.h>
 
 namespace simdpp {
 namespace SIMDPP_ARCH_NAMESPACE {
@@ -45,6 +47,47 @@ void stream(T* p, const any_vec<N,V>& a)
     detail::insn::i_stream(reinterpret_cast<char*>(p), a.wrapped().eval());
 }
 
+/** Loads a 128, 256 or 512-bit vector from memory using a non-temporal hint,
+    if possible.
+
+    @code
+    r = *(p)
+    @endcode
+
+    @a p must be aligned to the vector size in bytes.
+
+    On SSE4.1 and newer this compiles to @c MOVNTDQA. Note that most current
+    processors honor the non-temporal hint only for write-combining memory,
+    on regular memory the instruction behaves like an ordinary load. Use
+    @a prefetch_read with @c prefetch_locality::nta to reduce cache pollution
+    when scanning large arrays of regular memory. On other architectures an
+    ordinary aligned load is performed.
+*/
+template<class V, class T> SIMDPP_INL
+V stream_load(const T* p)
+{
+    static_assert(is_vector<V>::value && !is_mask<V>::value,
+                  "V must be a non-mask vector");
+    typename detail::get_expr_nosign<V>::type r;
+    detail::insn::i_stream_load(r, reinterpret_cast<const char*>(p));
+    return V(r);
+}
+
+/** Guarantees that all non-temporal stores issued by @a stream before the
+    call are globally visible before any stores issued after it.
+
+    Non-temporal stores are weakly ordered on x86. This function must be
+    called after a sequence of @a stream calls before the data is consumed by
+    another thread. On architectures where @a stream is an ordinary store this
+    function does nothing.
+*/
+SIMDPP_INL void stream_fence()
+{
+#if SIMDPP_USE_SSE2
+    _mm_sfence();
+#endif
+}
+
 } // namespace SIMDPP_ARCH_NAMESPACE
 } // namespace simdpp
 
@@ -313,6 +313,272 @@ void transpose4(float32<N>& a0, float32<N>& a1,
     detail::insn::i_transpose4(a0, a1, a2, a3);
 }
 
+/** Transposes 8x8 16-bit matrices within eight int16x8 vectors
+
+    Mask or expression vectors are not supported.
+
+    @code
+    r0 = [ a0_0; a1_0; a2_0; a3_0; a4_0; a5_0; a6_0; a7_0 ]
+    r1 = [ a0_1; a1_1; a2_1; a3_1; a4_1; a5_1; a6_1; a7_1 ]
+    ...
+    r7 = [ a0_7; a1_7; a2_7; a3_7; a4_7; a5_7; a6_7; a7_7 ]
+    @endcode
+
+    @par 128-bit version:
+    @icost{SSE2-AVX2, NEON, ALTIVEC, 24}
+
+    @par 256-bit version:
+    The lower and higher 128-bit halves are processed as if 128-bit instruction
+    was applied to each of them separately.
+
+    @icost{SSE2-AVX, NEON, ALTIVEC, 48}
+    @icost{AVX2, 24}
+*/
+template<unsigned N, class V> SIMDPP_INL
+void transpose8(any_int16<N,V>& a0, any_int16<N,V>& a1,
+                any_int16<N,V>& a2, any_int16<N,V>& a3,
+                any_int16<N,V>& a4, any_int16<N,V>& a5,
+                any_int16<N,V>& a6, any_int16<N,V>& a7)
+{
+    static_assert(!is_mask<V>::value, "Mask vectors are not supported");
+    static_assert(is_value_vector<V>::value, "Expression vectors are not supported");
+    uint16<N> qa0, qa1, qa2, qa3, qa4, qa5, qa6, qa7;
+    qa0 = a0.wrapped();  qa1 = a1.wrapped();  qa2 = a2.wrapped();  qa3 = a3.wrapped();
+    qa4 = a4.wrapped();  qa5 = a5.wrapped();  qa6 = a6.wrapped();  qa7 = a7.wrapped();
+    detail::insn::i_transpose8(qa0, qa1, qa2, qa3, qa4, qa5, qa6, qa7);
+    a0.wrapped() = qa0;  a1.wrapped() = qa1;  a2.wrapped() = qa2;  a3.wrapped() = qa3;
+    a4.wrapped() = qa4;  a5.wrapped() = qa5;  a6.wrapped() = qa6;  a7.wrapped() = qa7;
+}
+
+/** Transposes a 8x8 32-bit matrix within eight int32x8 vectors
+
+    Mask or expression vectors are not supported. Unlike @a transpose4, the
+    operation spans the whole 256-bit vector.
+
+    @code
+    r0 = [ a0_0; a1_0; a2_0; a3_0; a4_0; a5_0; a6_0; a7_0 ]
+    r1 = [ a0_1; a1_1; a2_1; a3_1; a4_1; a5_1; a6_1; a7_1 ]
+    ...
+    r7 = [ a0_7; a1_7; a2_7; a3_7; a4_7; a5_7; a6_7; a7_7 ]
+    @endcode
+
+    @par 256-bit version:
+    @icost{SSE2-AVX, NEON, ALTIVEC, 48}
+    @icost{AVX2, 24}
+*/
+template<unsigned N, class V> SIMDPP_INL
+void transpose8(any_int32<N,V>& a0, any_int32<N,V>& a1,
+                any_int32<N,V>& a2, any_int32<N,V>& a3,
+                any_int32<N,V>& a4, any_int32<N,V>& a5,
+                any_int32<N,V>& a6, any_int32<N,V>& a7)
+{
+    static_assert(N == 8, "Only 8-element vectors are supported");
+    static_assert(!is_mask<V>::value, "Mask vectors are not supported");
+    static_assert(is_value_vector<V>::value, "Expression vectors are not supported");
+    uint32<N> qa0, qa1, qa2, qa3, qa4, qa5, qa6, qa7;
+    qa0 = a0.wrapped();  qa1 = a1.wrapped();  qa2 = a2.wrapped();  qa3 = a3.wrapped();
+    qa4 = a4.wrapped();  qa5 = a5.wrapped();  qa6 = a6.wrapped();  qa7 = a7.wrapped();
+    detail::insn::i_transpose8(qa0, qa1, qa2, qa3, qa4, qa5, qa6, qa7);
+    a0.wrapped() = qa0;  a1.wrapped() = qa1;  a2.wrapped() = qa2;  a3.wrapped() = qa3;
+    a4.wrapped() = qa4;  a5.wrapped() = qa5;  a6.wrapped() = qa6;  a7.wrapped() = qa7;
+}
+
+/** Transposes a 8x8 32-bit matrix within eight float32x8 vectors
+
+    Unlike @a transpose4, the operation spans the whole 256-bit vector.
+
+    @code
+    r0 = [ a0_0; a1_0; a2_0; a3_0; a4_0; a5_0; a6_0; a7_0 ]
+    r1 = [ a0_1; a1_1; a2_1; a3_1; a4_1; a5_1; a6_1; a7_1 ]
+    ...
+    r7 = [ a0_7; a1_7; a2_7; a3_7; a4_7; a5_7; a6_7; a7_7 ]
+    @endcode
+
+    @par 256-bit version:
+    @icost{SSE2-SSE4.1, NEON, ALTIVEC, 48}
+    @icost{AVX-AVX2, 24}
+*/
+template<unsigned N> SIMDPP_INL
+void transpose8(float32<N>& a0, float32<N>& a1, float32<N>& a2, float32<N>& a3,
+                float32<N>& a4, float32<N>& a5, float32<N>& a6, float32<N>& a7)
+{
+    static_assert(N == 8, "Only 8-element vectors are supported");
+    detail::insn::i_transpose8(a0, a1, a2, a3, a4, a5, a6, a7);
+}
+
+/** Transposes a 8x8 64-bit matrix within eight int64x8 vectors
+
+    Mask or expression vectors are not supported.
+
+    @code
+    r0 = [ a0_0; a1_0; a2_0; a3_0; a4_0; a5_0; a6_0; a7_0 ]
+    r1 = [ a0_1; a1_1; a2_1; a3_1; a4_1; a5_1; a6_1; a7_1 ]
+    ...
+    r7 = [ a0_7; a1_7; a2_7; a3_7; a4_7; a5_7; a6_7; a7_7 ]
+    @endcode
+
+    @par 512-bit version:
+    @icost{SSE2-AVX, NEON, ALTIVEC, 32}
+    @icost{AVX2, 32}
+    @icost{AVX512F, 24}
+*/
+template<unsigned N, class V> SIMDPP_INL
+void transpose8(any_int64<N,V>& a0, any_int64<N,V>& a1,
+                any_int64<N,V>& a2, any_int64<N,V>& a3,
+                any_int64<N,V>& a4, any_int64<N,V>& a5,
+                any_int64<N,V>& a6, any_int64<N,V>& a7)
+{
+    static_assert(N == 8, "Only 8-element vectors are supported");
+    static_assert(!is_mask<V>::value, "Mask vectors are not supported");
+    static_assert(is_value_vector<V>::value, "Expression vectors are not supported");
+    uint64<N> qa0, qa1, qa2, qa3, qa4, qa5, qa6, qa7;
+    qa0 = a0.wrapped();  qa1 = a1.wrapped();  qa2 = a2.wrapped();  qa3 = a3.wrapped();
+    qa4 = a4.wrapped();  qa5 = a5.wrapped();  qa6 = a6.wrapped();  qa7 = a7.wrapped();
+    detail::insn::i_transpose8(qa0, qa1, qa2, qa3, qa4, qa5, qa6, qa7);
+    a0.wrapped() = qa0;  a1.wrapped() = qa1;  a2.wrapped() = qa2;  a3.wrapped() = qa3;
+    a4.wrapped() = qa4;  a5.wrapped() = qa5;  a6.wrapped() = qa6;  a7.wrapped() = qa7;
+}
+
+/** Transposes a 8x8 64-bit matrix within eight float64x8 vectors
+
+    @code
+    r0 = [ a0_0; a1_0; a2_0; a3_0; a4_0; a5_0; a6_0; a7_0 ]
+    r1 = [ a0_1; a1_1; a2_1; a3_1; a4_1; a5_1; a6_1; a7_1 ]
+    ...
+    r7 = [ a0_7; a1_7; a2_7; a3_7; a4_7; a5_7; a6_7; a7_7 ]
+    @endcode
+
+    @par 512-bit version:
+    @icost{SSE2-AVX2, 32}
+    @icost{AVX512F, 24}
+    @novec{NEON, ALTIVEC}
+*/
+template<unsigned N> SIMDPP_INL
+void transpose8(float64<N>& a0, float64<N>& a1, float64<N>& a2, float64<N>& a3,
+                float64<N>& a4, float64<N>& a5, float64<N>& a6, float64<N>& a7)
+{
+    static_assert(N == 8, "Only 8-element vectors are supported");
+    detail::insn::i_transpose8(a0, a1, a2, a3, a4, a5, a6, a7);
+}
+
+/** Transposes 16x16 8-bit matrices within sixteen int8x16 vectors
+
+    Mask or expression vectors are not supported.
+
+    @code
+    r0 = [ a0_0; a1_0; ... ; a15_0 ]
+    r1 = [ a0_1; a1_1; ... ; a15_1 ]
+    ...
+    r15 = [ a0_15; a1_15; ... ; a15_15 ]
+    @endcode
+
+    @par 128-bit version:
+    @icost{SSE2-AVX2, NEON, ALTIVEC, 64}
+
+    @par 256-bit version:
+    The lower and higher 128-bit halves are processed as if 128-bit instruction
+    was applied to each of them separately.
+
+    @icost{SSE2-AVX, NEON, ALTIVEC, 128}
+    @icost{AVX2, 64}
+*/
+template<unsigned N, class V> SIMDPP_INL
+void transpose16(any_int8<N,V>& a0, any_int8<N,V>& a1,
+                 any_int8<N,V>& a2, any_int8<N,V>& a3,
+                 any_int8<N,V>& a4, any_int8<N,V>& a5,
+                 any_int8<N,V>& a6, any_int8<N,V>& a7,
+                 any_int8<N,V>& a8, any_int8<N,V>& a9,
+                 any_int8<N,V>& a10, any_int8<N,V>& a11,
+                 any_int8<N,V>& a12, any_int8<N,V>& a13,
+                 any_int8<N,V>& a14, any_int8<N,V>& a15)
+{
+    static_assert(!is_mask<V>::value, "Mask vectors are not supported");
+    static_assert(is_value_vector<V>::value, "Expression vectors are not supported");
+    uint8<N> qa[16] = {
+        a0.wrapped(), a1.wrapped(), a2.wrapped(), a3.wrapped(),
+        a4.wrapped(), a5.wrapped(), a6.wrapped(), a7.wrapped(),
+        a8.wrapped(), a9.wrapped(), a10.wrapped(), a11.wrapped(),
+        a12.wrapped(), a13.wrapped(), a14.wrapped(), a15.wrapped()
+    };
+    detail::insn::i_transpose16(qa);
+    a0.wrapped() = qa[0];    a1.wrapped() = qa[1];    a2.wrapped() = qa[2];    a3.wrapped() = qa[3];
+    a4.wrapped() = qa[4];    a5.wrapped() = qa[5];    a6.wrapped() = qa[6];    a7.wrapped() = qa[7];
+    a8.wrapped() = qa[8];    a9.wrapped() = qa[9];    a10.wrapped() = qa[10];  a11.wrapped() = qa[11];
+    a12.wrapped() = qa[12];  a13.wrapped() = qa[13];  a14.wrapped() = qa[14];  a15.wrapped() = qa[15];
+}
+
+/** Transposes a 16x16 32-bit matrix within sixteen int32x16 vectors
+
+    Mask or expression vectors are not supported.
+
+    @code
+    r0 = [ a0_0; a1_0; ... ; a15_0 ]
+    r1 = [ a0_1; a1_1; ... ; a15_1 ]
+    ...
+    r15 = [ a0_15; a1_15; ... ; a15_15 ]
+    @endcode
+
+    @par 512-bit version:
+    @icost{SSE2-AVX, NEON, ALTIVEC, 192}
+    @icost{AVX2, 96}
+    @icost{AVX512F, 64}
+*/
+template<unsigned N, class V> SIMDPP_INL
+void transpose16(any_int32<N,V>& a0, any_int32<N,V>& a1,
+                 any_int32<N,V>& a2, any_int32<N,V>& a3,
+                 any_int32<N,V>& a4, any_int32<N,V>& a5,
+                 any_int32<N,V>& a6, any_int32<N,V>& a7,
+                 any_int32<N,V>& a8, any_int32<N,V>& a9,
+                 any_int32<N,V>& a10, any_int32<N,V>& a11,
+                 any_int32<N,V>& a12, any_int32<N,V>& a13,
+                 any_int32<N,V>& a14, any_int32<N,V>& a15)
+{
+    static_assert(N == 16, "Only 16-element vectors are supported");
+    static_assert(!is_mask<V>::value, "Mask vectors are not supported");
+    static_assert(is_value_vector<V>::value, "Expression vectors are not supported");
+    uint32<N> qa[16] = {
+        a0.wrapped(), a1.wrapped(), a2.wrapped(), a3.wrapped(),
+        a4.wrapped(), a5.wrapped(), a6.wrapped(), a7.wrapped(),
+        a8.wrapped(), a9.wrapped(), a10.wrapped(), a11.wrapped(),
+        a12.wrapped(), a13.wrapped(), a14.wrapped(), a15.wrapped()
+    };
+    detail::insn::i_transpose16(qa);
+    a0.wrapped() = qa[0];    a1.wrapped() = qa[1];    a2.wrapped() = qa[2];    a3.wrapped() = qa[3];
+    a4.wrapped() = qa[4];    a5.wrapped() = qa[5];    a6.wrapped() = qa[6];    a7.wrapped() = qa[7];
+    a8.wrapped() = qa[8];    a9.wrapped() = qa[9];    a10.wrapped() = qa[10];  a11.wrapped() = qa[11];
+    a12.wrapped() = qa[12];  a13.wrapped() = qa[13];  a14.wrapped() = qa[14];  a15.wrapped() = qa[15];
+}
+
+/** Transposes a 16x16 32-bit matrix within sixteen float32x16 vectors
+
+    @code
+    r0 = [ a0_0; a1_0; ... ; a15_0 ]
+    r1 = [ a0_1; a1_1; ... ; a15_1 ]
+    ...
+    r15 = [ a0_15; a1_15; ... ; a15_15 ]
+    @endcode
+
+    @par 512-bit version:
+    @icost{SSE2-SSE4.1, NEON, ALTIVEC, 192}
+    @icost{AVX-AVX2, 96}
+    @icost{AVX512F, 64}
+*/
+template<unsigned N> SIMDPP_INL
+void transpose16(float32<N>& a0, float32<N>& a1, float32<N>& a2, float32<N>& a3,
+                 float32<N>& a4, float32<N>& a5, float32<N>& a6, float32<N>& a7,
+                 float32<N>& a8, float32<N>& a9, float32<N>& a10, float32<N>& a11,
+                 float32<N>& a12, float32<N>& a13, float32<N>& a14, float32<N>& a15)
+{
+    static_assert(N == 16, "Only 16-element vectors are supported");
+    float32<N> qa[16] = { a0, a1, a2, a3, a4, a5, a6, a7,
+                          a8, a9, a10, a11, a12, a13, a14, a15 };
+    detail::insn::i_transpose16(qa);
+    a0 = qa[0];    a1 = qa[1];    a2 = qa[2];    a3 = qa[3];
+    a4 = qa[4];    a5 = qa[5];    a6 = qa[6];    a7 = qa[7];
+    a8 = qa[8];    a9 = qa[9];    a10 = qa[10];  a11 = qa[11];
+    a12 = qa[12];  a13 = qa[13];  a14 = qa[14];  a15 = qa[15];
+}
+
 } // namespace SIMDPP_ARCH_NAMESPACE
 } // namespace simdpp
 
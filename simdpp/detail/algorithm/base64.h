@@ -0,0 +1,414 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_BASE64_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_BASE64_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_not.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/blend.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/cmp_gt.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/combine.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_mul.h>
+#include <simdpp/core/i_shift_l.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/i_sub.h>
+#include <simdpp/core/i_sub_sat.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_int.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/permute_bytes16.h>
+#include <simdpp/core/split.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/test_bits.h>
+#include <simdpp/core/unzip_hi.h>
+#include <simdpp/core/unzip_lo.h>
+#include <simdpp/core/zip_hi.h>
+#include <simdpp/core/zip_lo.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/// The result of decoding text into bytes
+struct decode_result {
+    std::size_t size;       ///< the number of bytes stored to the output
+    bool valid;             ///< whether the whole input has been decoded
+    std::size_t error_pos;  ///< the position of the first invalid character,
+                            ///< or the input size if the input is valid or
+                            ///< truncated
+};
+
+namespace detail {
+
+static const unsigned base64_invalid = 0xff;
+
+static SIMDPP_INL char base64_char(uint32_t v)
+{
+    return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[v & 0x3f];
+}
+
+static SIMDPP_INL unsigned base64_value(uint8_t c)
+{
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return base64_invalid;
+}
+
+static SIMDPP_INL std::size_t base64_encode_scalar(const uint8_t* in, std::size_t n,
+                                                   char* out, std::size_t i, std::size_t r)
+{
+    for (; i + 3 <= n; i += 3) {
+        uint32_t w = (uint32_t(in[i]) << 16) | (uint32_t(in[i+1]) << 8) | in[i+2];
+        out[r] = base64_char(w >> 18);
+        out[r+1] = base64_char(w >> 12);
+        out[r+2] = base64_char(w >> 6);
+        out[r+3] = base64_char(w);
+        r += 4;
+    }
+    if (i < n) {
+        uint32_t w = uint32_t(in[i]) << 16;
+        if (i + 1 < n) {
+            w |= uint32_t(in[i+1]) << 8;
+        }
+        out[r] = base64_char(w >> 18);
+        out[r+1] = base64_char(w >> 12);
+        out[r+2] = i + 1 < n ? base64_char(w >> 6) : '=';
+        out[r+3] = '=';
+        r += 4;
+    }
+    return r;
+}
+
+/*  Decodes whole quanta of four characters starting at @a i. Only the last
+    quantum of the input may end with padding.
+*/
+static SIMDPP_INL decode_result base64_decode_scalar(const uint8_t* in, std::size_t n,
+                                                     uint8_t* out, std::size_t i,
+                                                     std::size_t r)
+{
+    for (; i + 4 <= n; i += 4) {
+        unsigned len = 4;
+        if (i + 4 == n && in[i+3] == '=') {
+            len = in[i+2] == '=' ? 2 : 3;
+        }
+        uint32_t w = 0;
+        for (unsigned k = 0; k < len; ++k) {
+            unsigned v = base64_value(in[i + k]);
+            if (v == base64_invalid) {
+                return { r, false, i + k };
+            }
+            w = (w << 6) | v;
+        }
+        w <<= 6 * (4 - len);
+        out[r++] = uint8_t(w >> 16);
+        if (len > 2) {
+            out[r++] = uint8_t(w >> 8);
+        }
+        if (len > 3) {
+            out[r++] = uint8_t(w);
+        }
+    }
+    for (; i < n; ++i) {
+        if (base64_value(in[i]) == base64_invalid) {
+            return { r, false, i };
+        }
+    }
+    return { r, n % 4 == 0, n };
+}
+
+/*  Whether the byte permutations used to regroup the bits and to translate
+    the characters are available. The bit regrouping relies on the order of
+    bytes within 16- and 32-bit elements.
+*/
+#if (SIMDPP_USE_NULL || SIMDPP_USE_SSSE3 || SIMDPP_USE_NEON || SIMDPP_USE_ALTIVEC || \
+     SIMDPP_USE_MSA) && !SIMDPP_BIG_ENDIAN
+using base64_is_vectorized = std::true_type;
+#else
+using base64_is_vectorized = std::false_type;
+#endif
+
+using base64_vector = uint8<SIMDPP_FAST_INT8_SIZE>;
+
+/*  Loads and stores 12 bytes at each 128-bit block of a vector, which
+    correspond to the 16 characters of the block. Each 128-bit block is
+    accessed using 16 bytes starting at offset 12 times its index; the bytes
+    past the 12 bytes of the last block are not used and stored values are
+    overwritten by the following block.
+*/
+template<unsigned N>
+struct base64_blocks {
+    static SIMDPP_INL uint8<N> load(const uint8_t* p)
+    {
+        uint8<N/2> lo = base64_blocks<N/2>::load(p);
+        uint8<N/2> hi = base64_blocks<N/2>::load(p + 12 * N / 32);
+        return combine(lo, hi);
+    }
+
+    static SIMDPP_INL void store(uint8_t* p, const uint8<N>& v)
+    {
+        uint8<N/2> lo, hi;
+        split(v, lo, hi);
+        base64_blocks<N/2>::store(p, lo);
+        base64_blocks<N/2>::store(p + 12 * N / 32, hi);
+    }
+};
+
+template<>
+struct base64_blocks<16> {
+    static SIMDPP_INL uint8<16> load(const uint8_t* p)
+    {
+        return load_u(p);
+    }
+
+    static SIMDPP_INL void store(uint8_t* p, const uint8<16>& v)
+    {
+        store_u(p, v);
+    }
+};
+
+/*  Encodes 12 bytes at the start of each 128-bit block into 16 characters.
+
+    The bytes of each group of three are permuted so that each 16-bit
+    element holds two of the four 6-bit indices at known bit positions.
+    Multiplications move the indices to separate bytes: mul_hi() shifts the
+    first and third index right and mul_lo() shifts the second and fourth
+    left. The indices are translated to characters by adding an offset
+    selected by the range of the index (Muła and Lemire, 2018).
+*/
+template<unsigned N> SIMDPP_INL
+uint8<N> base64_encode_block(const uint8<N>& in)
+{
+    using U16 = uint16<N/2>;
+    using U32 = uint32<N/4>;
+    uint8<N> groups = make_uint(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    U32 w = U32(permute_bytes16(in, groups));
+
+    U16 t0 = U16(bit_and(w, U32(make_uint(0x0fc0fc00))));
+    U16 t1 = mul_hi(t0, U16(make_uint(0x0040, 0x0400)));
+    U16 t2 = U16(bit_and(w, U32(make_uint(0x003f03f0))));
+    U16 t3 = mul_lo(t2, U16(make_uint(0x0010, 0x0100)));
+    uint8<N> idx = uint8<N>(bit_or(t1, t3));
+
+    // 0: 26..51, 1..10: 52..61, 11: 62, 12: 63, 13: 0..25
+    uint8<N> range = sub_sat(idx, uint8<N>(make_uint(51)));
+    typename int8<N>::mask_vector_type upper = cmp_lt(int8<N>(idx), int8<N>(make_int(26)));
+    int8<N> upper_v = int8<N>(upper);
+    range = bit_or(range, bit_and(uint8<N>(upper_v), uint8<N>(make_uint(13))));
+
+    uint8<N> offsets = make_uint('a' - 26, 0x100 + '0' - 52, 0x100 + '0' - 52,
+                                 0x100 + '0' - 52, 0x100 + '0' - 52, 0x100 + '0' - 52,
+                                 0x100 + '0' - 52, 0x100 + '0' - 52, 0x100 + '0' - 52,
+                                 0x100 + '0' - 52, 0x100 + '0' - 52, 0x100 + '+' - 62,
+                                 0x100 + '/' - 63, 'A', 0, 0);
+    return add(idx, permute_bytes16(offsets, range));
+}
+
+/*  Decodes 16 characters at each 128-bit block into 12 bytes at the start
+    of the block. Returns false if any of the characters is not in the
+    alphabet, in which case @a out is not modified.
+
+    The characters are validated by two tables indexed by the low and high
+    nibble whose entries have a common bit only for invalid characters. The
+    6-bit values are obtained by adding an offset selected by the high
+    nibble; '/' is the only character whose offset differs from the other
+    characters with the same high nibble. The values are then merged into
+    groups of 24 bits with shifts.
+*/
+template<unsigned N> SIMDPP_INL
+bool base64_decode_block(const uint8<N>& c, uint8<N>& out)
+{
+    using U16 = uint16<N/2>;
+    using U32 = uint32<N/4>;
+    uint8<N> lut_lo = make_uint(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    uint8<N> lut_hi = make_uint(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    uint8<N> lut_roll = make_uint(0, 16, 19, 4, 0x100 - 65, 0x100 - 65,
+                                  0x100 - 71, 0x100 - 71, 0, 0, 0, 0, 0, 0, 0, 0);
+    uint8<N> hi = shift_r<4>(c);
+    uint8<N> lo = bit_and(c, uint8<N>(make_uint(0x0f)));
+    uint8<N> invalid = bit_and(permute_bytes16(lut_lo, lo), permute_bytes16(lut_hi, hi));
+    if (test_bits_any(invalid)) {
+        return false;
+    }
+    typename uint8<N>::mask_vector_type slash = cmp_eq(c, uint8<N>(make_uint('/')));
+    uint8<N> slash_v = uint8<N>(slash);
+    uint8<N> v = add(c, permute_bytes16(lut_roll, add(hi, slash_v)));
+
+    U16 w = U16(v);
+    U16 ab = bit_or(shift_l<6>(bit_and(w, U16(make_uint(0x00ff)))), shift_r<8>(w));
+    U32 x = U32(ab);
+    U32 abcd = bit_or(shift_l<12>(bit_and(x, U32(make_uint(0xffff)))), shift_r<16>(x));
+    uint8<N> order = make_uint(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 3, 7, 11, 15);
+    out = permute_bytes16(uint8<N>(abcd), order);
+    return true;
+}
+
+static SIMDPP_INL std::size_t base64_encode(const uint8_t* in, std::size_t n, char* out,
+                                            std::false_type /*vectorized*/)
+{
+    return base64_encode_scalar(in, n, out, 0, 0);
+}
+
+static SIMDPP_INL std::size_t base64_encode(const uint8_t* in, std::size_t n, char* out,
+                                            std::true_type /*vectorized*/)
+{
+    const std::size_t L = base64_vector::length;
+    const std::size_t G = L / 16 * 12;
+    std::size_t i = 0;
+    std::size_t r = 0;
+    // the last block reads 4 bytes past the bytes it encodes
+    for (; i + G + 4 <= n; i += G, r += L) {
+        base64_vector v = base64_blocks<L>::load(in + i);
+        store_u(out + r, base64_encode_block(v));
+    }
+    return base64_encode_scalar(in, n, out, i, r);
+}
+
+static SIMDPP_INL decode_result base64_decode(const char* in, std::size_t n, uint8_t* out,
+                                              std::false_type /*vectorized*/)
+{
+    return base64_decode_scalar(reinterpret_cast<const uint8_t*>(in), n, out, 0, 0);
+}
+
+/*  The blocks that contain invalid characters are decoded by the scalar
+    code, which determines the position of the error. The last 8 characters
+    are always decoded by the scalar code, which handles the padding; this
+    also ensures that the stores past the 12 bytes of the last block stay
+    within the output.
+*/
+static SIMDPP_INL decode_result base64_decode(const char* in, std::size_t n, uint8_t* out,
+                                              std::true_type /*vectorized*/)
+{
+    const std::size_t L = base64_vector::length;
+    const std::size_t G = L / 16 * 12;
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(in);
+    std::size_t i = 0;
+    std::size_t r = 0;
+    for (; i + L + 8 <= n; i += L, r += G) {
+        base64_vector c = load_u(p + i);
+        base64_vector v;
+        if (!base64_decode_block(c, v)) {
+            break;
+        }
+        base64_blocks<L>::store(out + r, v);
+    }
+    return base64_decode_scalar(p, n, out, i, r);
+}
+
+static SIMDPP_INL char hex_char(unsigned v)
+{
+    return "0123456789abcdef"[v & 0xf];
+}
+
+static SIMDPP_INL unsigned hex_value(uint8_t c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return base64_invalid;
+}
+
+// Translates nibbles to lowercase hexadecimal digits
+static SIMDPP_INL uint8<16> hex_digits(const uint8<16>& x)
+{
+    mask_int8<16> letter = cmp_gt(int8<16>(x), int8<16>(make_int(9)));
+    int8<16> letter_v = int8<16>(letter);
+    uint8<16> off = bit_and(uint8<16>(letter_v), uint8<16>(make_uint('a' - '0' - 10)));
+    return add(add(x, uint8<16>(make_uint('0'))), off);
+}
+
+/*  Translates hexadecimal digits of either case to nibbles. Returns false
+    if any of the characters is not a digit. The wrapping subtractions map
+    the digits and the letters to 0..9 and 0..5 respectively and all other
+    characters to larger values.
+*/
+static SIMDPP_INL bool hex_values(const uint8<16>& c, uint8<16>& out)
+{
+    uint8<16> d = sub(c, uint8<16>(make_uint('0')));
+    uint8<16> x = sub(bit_or(c, uint8<16>(make_uint(0x20))), uint8<16>(make_uint('a')));
+    mask_int8<16> is_digit = cmp_lt(d, uint8<16>(make_uint(10)));
+    mask_int8<16> is_letter = cmp_lt(x, uint8<16>(make_uint(6)));
+    uint8<16> invalid = bit_not(bit_or(uint8<16>(is_digit), uint8<16>(is_letter)));
+    if (test_bits_any(invalid)) {
+        return false;
+    }
+    out = blend(d, add(x, uint8<16>(make_uint(10))), is_digit);
+    return true;
+}
+
+/*  The high and low nibbles of 16 bytes are translated separately and the
+    digits are interleaved with zip16_lo() and zip16_hi(). 128-bit vectors
+    are used since the interleaving works within 128-bit blocks.
+*/
+static SIMDPP_INL std::size_t hex_encode(const uint8_t* in, std::size_t n, char* out)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8<16> v = load_u(in + i);
+        uint8<16> h = hex_digits(shift_r<4>(v));
+        uint8<16> l = hex_digits(bit_and(v, uint8<16>(make_uint(0x0f))));
+        store_u(out + 2*i, zip16_lo(h, l));
+        store_u(out + 2*i + 16, zip16_hi(h, l));
+    }
+    for (; i < n; ++i) {
+        out[2*i] = hex_char(in[i] >> 4);
+        out[2*i+1] = hex_char(in[i]);
+    }
+    return 2 * n;
+}
+
+static SIMDPP_INL decode_result hex_decode(const char* in, std::size_t n, uint8_t* out)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(in);
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        uint8<16> a = load_u(p + i);
+        uint8<16> b = load_u(p + i + 16);
+        uint8<16> h, l;
+        if (!hex_values(unzip16_lo(a, b), h) || !hex_values(unzip16_hi(a, b), l)) {
+            break;
+        }
+        store_u(out + i / 2, bit_or(shift_l<4>(h), l));
+    }
+    for (; i + 2 <= n; i += 2) {
+        unsigned h = hex_value(p[i]);
+        if (h == base64_invalid) {
+            return { i / 2, false, i };
+        }
+        unsigned l = hex_value(p[i+1]);
+        if (l == base64_invalid) {
+            return { i / 2, false, i + 1 };
+        }
+        out[i / 2] = uint8_t((h << 4) | l);
+    }
+    if (i < n && hex_value(p[i]) == base64_invalid) {
+        return { i / 2, false, i };
+    }
+    return { i / 2, i == n, n };
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
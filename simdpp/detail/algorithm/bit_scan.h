@@ -0,0 +1,99 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_BIT_SCAN_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_BIT_SCAN_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/setup_arch.h>
+#include <cstdint>
+#if _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+/*  Returns the index of the least significant set bit of @a x. @a x must not
+    be zero.
+*/
+static SIMDPP_INL unsigned bit_scan_forward(uint64_t x)
+{
+#if __GNUC__
+    return __builtin_ctzll(x);
+#elif _MSC_VER && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long r;
+    _BitScanForward64(&r, x);
+    return r;
+#elif _MSC_VER
+    unsigned long r;
+    if (static_cast<uint32_t>(x) != 0) {
+        _BitScanForward(&r, static_cast<uint32_t>(x));
+        return r;
+    }
+    _BitScanForward(&r, static_cast<uint32_t>(x >> 32));
+    return r + 32;
+#else
+    unsigned r = 0;
+    while ((x & 1) == 0) {
+        x >>= 1;
+        r++;
+    }
+    return r;
+#endif
+}
+
+/*  Returns the index of the most significant set bit of @a x. @a x must not
+    be zero.
+*/
+static SIMDPP_INL unsigned bit_scan_reverse(uint64_t x)
+{
+#if __GNUC__
+    return 63 - __builtin_clzll(x);
+#elif _MSC_VER && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long r;
+    _BitScanReverse64(&r, x);
+    return r;
+#elif _MSC_VER
+    unsigned long r;
+    if ((x >> 32) != 0) {
+        _BitScanReverse(&r, static_cast<uint32_t>(x >> 32));
+        return r + 32;
+    }
+    _BitScanReverse(&r, static_cast<uint32_t>(x));
+    return r;
+#else
+    unsigned r = 0;
+    while ((x >>= 1) != 0) {
+        r++;
+    }
+    return r;
+#endif
+}
+
+// Returns the number of set bits in @a x
+static SIMDPP_INL unsigned bit_popcount(uint64_t x)
+{
+#if __GNUC__
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<unsigned>((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
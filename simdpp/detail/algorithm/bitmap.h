@@ -0,0 +1,170 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_BITMAP_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_BITMAP_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_andnot.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/bit_xor.h>
+#include <simdpp/core/i_reduce_popcnt.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/algorithm/bit_scan.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+using bitmap_vector = uint64<SIMDPP_FAST_INT64_SIZE>;
+
+struct bitmap_and_op {
+    template<class V> static SIMDPP_INL V run(const V& a, const V& b) { return bit_and(a, b); }
+    static SIMDPP_INL uint64_t run(uint64_t a, uint64_t b) { return a & b; }
+};
+
+struct bitmap_or_op {
+    template<class V> static SIMDPP_INL V run(const V& a, const V& b) { return bit_or(a, b); }
+    static SIMDPP_INL uint64_t run(uint64_t a, uint64_t b) { return a | b; }
+};
+
+struct bitmap_xor_op {
+    template<class V> static SIMDPP_INL V run(const V& a, const V& b) { return bit_xor(a, b); }
+    static SIMDPP_INL uint64_t run(uint64_t a, uint64_t b) { return a ^ b; }
+};
+
+struct bitmap_andnot_op {
+    template<class V> static SIMDPP_INL V run(const V& a, const V& b) { return bit_andnot(a, b); }
+    static SIMDPP_INL uint64_t run(uint64_t a, uint64_t b) { return a & ~b; }
+};
+
+// Returns the first operand; used to count the bits of a single bitmap
+struct bitmap_first_op {
+    template<class V> static SIMDPP_INL V run(const V& a, const V&) { return a; }
+};
+
+/*  Computes the operation on the vector of words at offset @a i and stores
+    the result if @a Store is set.
+*/
+template<class Op, bool Store> SIMDPP_INL
+bitmap_vector bitmap_step(const uint64_t* a, const uint64_t* b, uint64_t* out,
+                          std::size_t i)
+{
+    bitmap_vector va = load_u(a + i);
+    bitmap_vector vb = load_u(b + i);
+    bitmap_vector r = Op::run(va, vb);
+    if (Store) {
+        store_u(out + i, r);
+    }
+    return r;
+}
+
+/*  Carry-save adder: adds three bit vectors bitwise and stores the sum to
+    @a l and the carry to @a h.
+*/
+static SIMDPP_INL void bitmap_csa(bitmap_vector& h, bitmap_vector& l,
+                                  const bitmap_vector& a, const bitmap_vector& b,
+                                  const bitmap_vector& c)
+{
+    bitmap_vector u = bit_xor(a, b);
+    h = bit_or(bit_and(a, b), bit_and(u, c));
+    l = bit_xor(u, c);
+}
+
+/*  Computes @a Op on @a n words of @a a and @a b, optionally stores the
+    results to @a out and returns the number of set bits in the results if
+    @a Count is set.
+
+    The bits are counted using the Harley-Seal method: blocks of 16 vectors
+    are reduced by a tree of carry-save adders into counters of weight 1, 2,
+    4, 8 and 16 bits, so that the population of only one vector per block
+    needs to be computed.
+*/
+template<class Op, bool Store, bool Count>
+uint64_t bitmap_op(const uint64_t* a, const uint64_t* b, uint64_t* out, std::size_t n)
+{
+    using V = bitmap_vector;
+    const std::size_t L = V::length;
+    std::size_t i = 0;
+    uint64_t total = 0;
+
+    if (Count) {
+        V ones = make_uint(0), twos = ones, fours = ones, eights = ones;
+        V twos_a, twos_b, fours_a, fours_b, eights_a, eights_b, sixteens;
+        uint64_t sixteens_total = 0;
+        for (; i + 16 * L <= n; i += 16 * L) {
+            bitmap_csa(twos_a, ones, ones, bitmap_step<Op, Store>(a, b, out, i),
+                       bitmap_step<Op, Store>(a, b, out, i + L));
+            bitmap_csa(twos_b, ones, ones, bitmap_step<Op, Store>(a, b, out, i + 2*L),
+                       bitmap_step<Op, Store>(a, b, out, i + 3*L));
+            bitmap_csa(fours_a, twos, twos, twos_a, twos_b);
+            bitmap_csa(twos_a, ones, ones, bitmap_step<Op, Store>(a, b, out, i + 4*L),
+                       bitmap_step<Op, Store>(a, b, out, i + 5*L));
+            bitmap_csa(twos_b, ones, ones, bitmap_step<Op, Store>(a, b, out, i + 6*L),
+                       bitmap_step<Op, Store>(a, b, out, i + 7*L));
+            bitmap_csa(fours_b, twos, twos, twos_a, twos_b);
+            bitmap_csa(eights_a, fours, fours, fours_a, fours_b);
+            bitmap_csa(twos_a, ones, ones, bitmap_step<Op, Store>(a, b, out, i + 8*L),
+                       bitmap_step<Op, Store>(a, b, out, i + 9*L));
+            bitmap_csa(twos_b, ones, ones, bitmap_step<Op, Store>(a, b, out, i + 10*L),
+                       bitmap_step<Op, Store>(a, b, out, i + 11*L));
+            bitmap_csa(fours_a, twos, twos, twos_a, twos_b);
+            bitmap_csa(twos_a, ones, ones, bitmap_step<Op, Store>(a, b, out, i + 12*L),
+                       bitmap_step<Op, Store>(a, b, out, i + 13*L));
+            bitmap_csa(twos_b, ones, ones, bitmap_step<Op, Store>(a, b, out, i + 14*L),
+                       bitmap_step<Op, Store>(a, b, out, i + 15*L));
+            bitmap_csa(fours_b, twos, twos, twos_a, twos_b);
+            bitmap_csa(eights_b, fours, fours, fours_a, fours_b);
+            bitmap_csa(sixteens, eights, eights, eights_a, eights_b);
+            sixteens_total += reduce_popcnt(sixteens);
+        }
+        total = 16 * sixteens_total + 8 * uint64_t(reduce_popcnt(eights)) +
+                4 * uint64_t(reduce_popcnt(fours)) + 2 * uint64_t(reduce_popcnt(twos)) +
+                reduce_popcnt(ones);
+    }
+
+    for (; i + L <= n; i += L) {
+        V r = bitmap_step<Op, Store>(a, b, out, i);
+        if (Count) {
+            total += reduce_popcnt(r);
+        }
+    }
+    for (; i < n; ++i) {
+        uint64_t r = Op::run(a[i], b[i]);
+        if (Store) {
+            out[i] = r;
+        }
+        if (Count) {
+            total += bit_popcount(r);
+        }
+    }
+    return total;
+}
+
+template<class Op>
+uint64_t bitmap_op_count(const uint64_t* a, const uint64_t* b, uint64_t* out, std::size_t n)
+{
+    if (out == nullptr) {
+        return bitmap_op<Op, false, true>(a, b, nullptr, n);
+    }
+    return bitmap_op<Op, true, true>(a, b, out, n);
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
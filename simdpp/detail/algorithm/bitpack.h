@@ -0,0 +1,446 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_BITPACK_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_BITPACK_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/bit_xor.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_min.h>
+#include <simdpp/core/i_reduce_min.h>
+#include <simdpp/core/i_shift_l.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/i_sub.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/permute_bytes16.h>
+#include <simdpp/core/permute_zbytes16.h>
+#include <simdpp/core/prefix_sum.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/algorithm/scan.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+/*  The packed values form a little-endian bit stream: the i-th value
+    occupies the bits [i*B, (i+1)*B) of the stream, where bit j is the bit
+    (j % 8) of the byte (j / 8). Values are unpacked in blocks of 32, which
+    occupy exactly 4*B bytes.
+*/
+static const unsigned bitpack_block_length = 32;
+
+// The number of bytes that may be read past the end of a block
+static const unsigned bitpack_block_overread = 16;
+
+// Whether the byte permutations needed for unpacking are available
+#if SIMDPP_USE_NULL || SIMDPP_USE_SSSE3 || SIMDPP_USE_NEON || SIMDPP_USE_ALTIVEC || SIMDPP_USE_MSA
+using bitpack_is_vectorized = std::true_type;
+#else
+using bitpack_is_vectorized = std::false_type;
+#endif
+
+template<unsigned B>
+struct bitpack_value_mask : std::integral_constant<uint32_t,
+    B == 32 ? 0xffffffff : (uint32_t(1) << (B % 32)) - 1> {};
+
+static SIMDPP_INL std::size_t bitpack_bytes(std::size_t n, unsigned b)
+{
+    return (n * b + 7) / 8;
+}
+
+static SIMDPP_INL void bitpack_store32le(uint8_t* p, uint32_t x)
+{
+    p[0] = uint8_t(x);
+    p[1] = uint8_t(x >> 8);
+    p[2] = uint8_t(x >> 16);
+    p[3] = uint8_t(x >> 24);
+}
+
+static SIMDPP_INL uint32_t bitpack_load32le(const uint8_t* p)
+{
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) |
+           (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+static SIMDPP_INL uint64_t bitpack_load64le(const uint8_t* p)
+{
+    uint64_t r = 0;
+    for (unsigned i = 0; i < 8; ++i) {
+        r |= uint64_t(p[i]) << (i * 8);
+    }
+    return r;
+}
+
+/*  Values are accumulated into a 64-bit register and flushed 32 bits at a
+    time. Since B is a compile-time constant, the compiler resolves the
+    flushes of an unrolled block statically.
+*/
+template<unsigned B>
+std::size_t bitpack(const uint32_t* in, std::size_t n, uint8_t* out)
+{
+    const uint32_t mask = bitpack_value_mask<B>::value;
+    uint64_t acc = 0;
+    unsigned fill = 0;
+    uint8_t* o = out;
+    for (std::size_t i = 0; i < n; ++i) {
+        acc |= uint64_t(in[i] & mask) << fill;
+        fill += B;
+        if (fill >= 32) {
+            bitpack_store32le(o, uint32_t(acc));
+            o += 4;
+            acc >>= 32;
+            fill -= 32;
+        }
+    }
+    for (; fill > 0; fill = fill > 8 ? fill - 8 : 0) {
+        *o++ = uint8_t(acc);
+        acc >>= 8;
+    }
+    return o - out;
+}
+
+// Bit position of the K-th value of the G-th group of 4 values of a block
+template<unsigned B, unsigned G, unsigned K>
+struct bitunpack_pos {
+    static const unsigned bit = (G * 4 + K) * B;
+    static const unsigned byte = bit / 8;
+    static const unsigned shift = bit % 8;
+};
+
+/*  Returns a byte permutation mask that moves the 4 bytes starting at
+    b[k] + off to the k-th 32-bit element. Elements whose b[k] is 0xff are
+    zeroed.
+*/
+static SIMDPP_INL uint8<16> bitunpack_mask(unsigned b0, unsigned b1,
+                                           unsigned b2, unsigned b3, unsigned off)
+{
+    unsigned b[4] = { b0, b1, b2, b3 };
+    SIMDPP_ALIGN(16) uint8_t m[16];
+    for (unsigned k = 0; k < 4; ++k) {
+        for (unsigned i = 0; i < 4; ++i) {
+#if SIMDPP_BIG_ENDIAN
+            unsigned idx = b[k] + off + 3 - i;
+#else
+            unsigned idx = b[k] + off + i;
+#endif
+            m[k * 4 + i] = b[k] == 0xff ? 0x80 : uint8_t(idx);
+        }
+    }
+    return load(m);
+}
+
+/*  Unpacks 4 values of width B <= 25. The 4 bytes that contain each value
+    are moved to its element, then the elements are shifted right by the bit
+    offset of the value within the first byte and masked.
+*/
+template<unsigned B, unsigned G> SIMDPP_INL
+uint32<4> bitunpack_group(const uint8_t* block, std::true_type /*narrow*/)
+{
+    using P0 = bitunpack_pos<B, G, 0>;
+    using P1 = bitunpack_pos<B, G, 1>;
+    using P2 = bitunpack_pos<B, G, 2>;
+    using P3 = bitunpack_pos<B, G, 3>;
+
+    uint8<16> mask = bitunpack_mask(0, P1::byte - P0::byte, P2::byte - P0::byte,
+                                    P3::byte - P0::byte, 0);
+    uint8<16> a = load_u(block + P0::byte);
+    uint32<4> v = uint32<4>(permute_bytes16(a, mask));
+    uint32<4> sh = make_uint(P0::shift, P1::shift, P2::shift, P3::shift);
+    v = shift_r(v, sh);
+    return bit_and(v, splat<uint32<4>>(bitpack_value_mask<B>::value));
+}
+
+/*  Unpacks 4 values of width 25 < B < 32. A value may span 5 bytes, thus the
+    low and the high 32 bits of a 64-bit window are assembled separately.
+    The first and the last two values are taken from separate loads so that
+    each load spans at most 16 bytes.
+*/
+template<unsigned B, unsigned G> SIMDPP_INL
+uint32<4> bitunpack_group(const uint8_t* block, std::false_type /*narrow*/)
+{
+    using P0 = bitunpack_pos<B, G, 0>;
+    using P1 = bitunpack_pos<B, G, 1>;
+    using P2 = bitunpack_pos<B, G, 2>;
+    using P3 = bitunpack_pos<B, G, 3>;
+    const unsigned z = 0xff;
+
+    uint8<16> a = load_u(block + P0::byte);
+    uint8<16> c = load_u(block + P2::byte);
+    uint8<16> ma_lo = bitunpack_mask(0, P1::byte - P0::byte, z, z, 0);
+    uint8<16> mc_lo = bitunpack_mask(z, z, 0, P3::byte - P2::byte, 0);
+    uint8<16> ma_hi = bitunpack_mask(0, P1::byte - P0::byte, z, z, 4);
+    uint8<16> mc_hi = bitunpack_mask(z, z, 0, P3::byte - P2::byte, 4);
+    uint8<16> t0 = permute_zbytes16(a, ma_lo);
+    uint8<16> t1 = permute_zbytes16(c, mc_lo);
+    uint32<4> lo = uint32<4>(bit_or(t0, t1));
+    t0 = permute_zbytes16(a, ma_hi);
+    t1 = permute_zbytes16(c, mc_hi);
+    uint32<4> hi = uint32<4>(bit_or(t0, t1));
+
+    uint32<4> sh = make_uint(P0::shift, P1::shift, P2::shift, P3::shift);
+    uint32<4> sh_hi = make_uint(31 - P0::shift, 31 - P1::shift,
+                                31 - P2::shift, 31 - P3::shift);
+    lo = shift_r(lo, sh);
+    // shifting by 32 is not portable, thus the high part is shifted in two steps
+    hi = shift_l<1>(hi);
+    hi = shift_l(hi, sh_hi);
+    uint32<4> v = bit_or(lo, hi);
+    return bit_and(v, splat<uint32<4>>(bitpack_value_mask<B>::value));
+}
+
+template<unsigned B, unsigned G>
+struct bitunpack_groups {
+    static SIMDPP_INL void run(const uint8_t* block, uint32_t* out)
+    {
+        using Narrow = std::integral_constant<bool, (B <= 25)>;
+        uint32<4> v = bitunpack_group<B, G>(block, Narrow());
+        store_u(out + G * 4, v);
+        bitunpack_groups<B, G + 1>::run(block, out);
+    }
+};
+
+template<unsigned B>
+struct bitunpack_groups<B, bitpack_block_length / 4> {
+    static SIMDPP_INL void run(const uint8_t*, uint32_t*) {}
+};
+
+// Unpacks a block of 32 values. Up to bitpack_block_overread bytes past the
+// end of the block may be read.
+template<unsigned B> SIMDPP_INL
+void bitunpack_block(const uint8_t* block, uint32_t* out, std::true_type /*vectorized*/)
+{
+    bitunpack_groups<B, 0>::run(block, out);
+}
+
+template<unsigned B> SIMDPP_INL
+void bitunpack_block(const uint8_t* block, uint32_t* out, std::false_type /*vectorized*/)
+{
+    for (unsigned k = 0; k < bitpack_block_length; ++k) {
+        unsigned bit = k * B;
+        uint64_t w = bitpack_load64le(block + bit / 8);
+        out[k] = uint32_t(w >> (bit % 8)) & bitpack_value_mask<B>::value;
+    }
+}
+
+template<unsigned B>
+void bitunpack(const uint8_t* in, std::size_t n, uint32_t* out)
+{
+    const unsigned L = bitpack_block_length;
+    const std::size_t block_bytes = L * B / 8;
+    const std::size_t in_bytes = bitpack_bytes(n, B);
+
+    if (B == 0) {
+        std::fill(out, out + n, 0);
+        return;
+    }
+    if (B == 32) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = bitpack_load32le(in + i * 4);
+        }
+        return;
+    }
+
+    std::size_t i = 0;
+    for (; (i + 1) * L <= n &&
+           (i + 1) * block_bytes + bitpack_block_overread <= in_bytes; ++i) {
+        bitunpack_block<B>(in + i * block_bytes, out + i * L, bitpack_is_vectorized());
+    }
+
+    // The last blocks are copied to a buffer so that no data is read past
+    // the end of the input
+    for (; i * L < n; ++i) {
+        uint8_t buf[L * 4 + bitpack_block_overread] = {};
+        uint32_t tmp[L];
+        std::size_t avail = std::min(block_bytes, in_bytes - i * block_bytes);
+        std::memcpy(buf, in + i * block_bytes, avail);
+        bitunpack_block<B>(buf, tmp, bitpack_is_vectorized());
+        std::size_t c = std::min<std::size_t>(L, n - i * L);
+        std::copy(tmp, tmp + c, out + i * L);
+    }
+}
+
+/*  Calls F::run<B>() for the bit width b, which must be at most 32. The
+    widths are compared in a binary tree so that the dispatch is not linear
+    in b.
+*/
+template<class F, unsigned Lo, unsigned Hi>
+struct bitpack_dispatch {
+    template<class... Args> SIMDPP_INL
+    static auto run(unsigned b, Args... args) -> decltype(F::template run<Lo>(args...))
+    {
+        const unsigned mid = (Lo + Hi) / 2;
+        if (b <= mid) {
+            return bitpack_dispatch<F, Lo, mid>::run(b, args...);
+        }
+        return bitpack_dispatch<F, mid + 1, Hi>::run(b, args...);
+    }
+};
+
+template<class F, unsigned B>
+struct bitpack_dispatch<F, B, B> {
+    template<class... Args> SIMDPP_INL
+    static auto run(unsigned, Args... args) -> decltype(F::template run<B>(args...))
+    {
+        return F::template run<B>(args...);
+    }
+};
+
+struct bitpack_fn {
+    template<unsigned B> static SIMDPP_INL
+    std::size_t run(const uint32_t* in, std::size_t n, uint8_t* out)
+    {
+        return bitpack<B>(in, n, out);
+    }
+};
+
+struct bitunpack_fn {
+    template<unsigned B> static SIMDPP_INL
+    void run(const uint8_t* in, std::size_t n, uint32_t* out)
+    {
+        bitunpack<B>(in, n, out);
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+using codec_vector = uint32<SIMDPP_FAST_INT32_SIZE>;
+
+static SIMDPP_INL uint32_t for_encode(const uint32_t* in, std::size_t n, uint32_t* out)
+{
+    using V = codec_vector;
+    const std::size_t L = V::length;
+    if (n == 0) {
+        return 0;
+    }
+
+    uint32_t base = in[0];
+    std::size_t i = 0;
+    if (n >= L) {
+        V m = load_u(in);
+        for (i = L; i + L <= n; i += L) {
+            V v = load_u(in + i);
+            m = min(m, v);
+        }
+        base = reduce_min(m);
+    }
+    for (; i < n; ++i) {
+        base = std::min(base, in[i]);
+    }
+
+    V vb = splat<V>(base);
+    for (i = 0; i + L <= n; i += L) {
+        V v = load_u(in + i);
+        store_u(out + i, sub(v, vb));
+    }
+    for (; i < n; ++i) {
+        out[i] = in[i] - base;
+    }
+    return base;
+}
+
+static SIMDPP_INL void for_decode(const uint32_t* in, std::size_t n,
+                                  uint32_t base, uint32_t* out)
+{
+    using V = codec_vector;
+    const std::size_t L = V::length;
+    V vb = splat<V>(base);
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        V v = load_u(in + i);
+        store_u(out + i, add(v, vb));
+    }
+    for (; i < n; ++i) {
+        out[i] = in[i] + base;
+    }
+}
+
+// Maps signed differences to unsigned values: 0, -1, 1, -2, 2... -> 0, 1, 2, 3, 4...
+static SIMDPP_INL uint32_t zigzag_encode(uint32_t d)
+{
+    return (d << 1) ^ (0 - (d >> 31));
+}
+
+static SIMDPP_INL uint32_t zigzag_decode(uint32_t z)
+{
+    return (z >> 1) ^ (0 - (z & 1));
+}
+
+template<unsigned N> SIMDPP_INL
+uint32<N> zigzag_encode(const uint32<N>& d)
+{
+    uint32<N> s = sub(splat<uint32<N>>(0), shift_r<31>(d));
+    return bit_xor(shift_l<1>(d), s);
+}
+
+template<unsigned N> SIMDPP_INL
+uint32<N> zigzag_decode(const uint32<N>& z)
+{
+    uint32<N> s = sub(splat<uint32<N>>(0), bit_and(z, splat<uint32<N>>(1)));
+    return bit_xor(shift_r<1>(z), s);
+}
+
+static SIMDPP_INL void delta_encode(const uint32_t* in, std::size_t n,
+                                    uint32_t* out, uint32_t prev)
+{
+    using V = codec_vector;
+    const std::size_t L = V::length;
+    if (n == 0) {
+        return;
+    }
+    out[0] = zigzag_encode(in[0] - prev);
+    std::size_t i = 1;
+    for (; i + L <= n; i += L) {
+        V v = load_u(in + i);
+        V p = load_u(in + i - 1);
+        store_u(out + i, zigzag_encode(V(sub(v, p))));
+    }
+    for (; i < n; ++i) {
+        out[i] = zigzag_encode(in[i] - in[i - 1]);
+    }
+}
+
+// The differences are decoded and summed using prefix_sum() with the total
+// of the preceding vectors kept broadcast in a vector
+static SIMDPP_INL void delta_decode(const uint32_t* in, std::size_t n,
+                                    uint32_t* out, uint32_t prev)
+{
+    using V = codec_vector;
+    const std::size_t L = V::length;
+    V carry = splat<V>(prev);
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        V v = load_u(in + i);
+        v = add(prefix_sum(zigzag_decode(v)), carry);
+        store_u(out + i, v);
+        carry = splat<L - 1>(v);
+    }
+    uint32_t c = i > 0 ? out[i - 1] : prev;
+    for (; i < n; ++i) {
+        c += zigzag_decode(in[i]);
+        out[i] = c;
+    }
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,259 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_BITSLICE_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_BITSLICE_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_transpose.h>
+#include <simdpp/core/extract_bits.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/unzip_hi.h>
+#include <simdpp/core/unzip_lo.h>
+#include <simdpp/core/zip_hi.h>
+#include <simdpp/core/zip_lo.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+// The number of elements whose bits are stored in each word of a bit plane
+static const unsigned bitslice_word_bits = 64;
+
+/*  Returns the index of the byte of an element of @a n bytes in the order of
+    significance, given its offset @a i in memory.
+*/
+static SIMDPP_INL unsigned bitslice_sig_byte(unsigned i, unsigned n)
+{
+#if SIMDPP_BIG_ENDIAN
+    return n - 1 - i;
+#else
+    (void) n;
+    return i;
+#endif
+}
+
+/*  Converts between 16 elements of S bytes held in S vectors and S planes,
+    the p-th of which holds the byte at offset p of each element. Each level
+    of unzipping halves the size of the elements.
+*/
+template<unsigned S>
+struct bitslice_planes {
+    static SIMDPP_INL void split(const uint8<16>* v, uint8<16>* planes)
+    {
+        const unsigned H = S / 2;
+        uint8<16> lo[H], hi[H], plo[H], phi[H];
+        for (unsigned i = 0; i < H; ++i) {
+            lo[i] = unzip16_lo(v[2*i], v[2*i+1]);
+            hi[i] = unzip16_hi(v[2*i], v[2*i+1]);
+        }
+        bitslice_planes<H>::split(lo, plo);
+        bitslice_planes<H>::split(hi, phi);
+        for (unsigned i = 0; i < H; ++i) {
+            planes[2*i] = plo[i];
+            planes[2*i+1] = phi[i];
+        }
+    }
+
+    static SIMDPP_INL void merge(const uint8<16>* planes, uint8<16>* v)
+    {
+        const unsigned H = S / 2;
+        uint8<16> lo[H], hi[H], plo[H], phi[H];
+        for (unsigned i = 0; i < H; ++i) {
+            plo[i] = planes[2*i];
+            phi[i] = planes[2*i+1];
+        }
+        bitslice_planes<H>::merge(plo, lo);
+        bitslice_planes<H>::merge(phi, hi);
+        for (unsigned i = 0; i < H; ++i) {
+            v[2*i] = zip16_lo(lo[i], hi[i]);
+            v[2*i+1] = zip16_hi(lo[i], hi[i]);
+        }
+    }
+};
+
+template<>
+struct bitslice_planes<1> {
+    static SIMDPP_INL void split(const uint8<16>* v, uint8<16>* planes)
+    {
+        planes[0] = v[0];
+    }
+
+    static SIMDPP_INL void merge(const uint8<16>* planes, uint8<16>* v)
+    {
+        v[0] = planes[0];
+    }
+};
+
+// Stores the masks of each bit of the bytes of @a a to @a r[0..7]
+static SIMDPP_INL void bitslice_extract8(const uint8<16>& a, uint16_t* r)
+{
+    r[0] = extract_bits<0>(a);
+    r[1] = extract_bits<1>(a);
+    r[2] = extract_bits<2>(a);
+    r[3] = extract_bits<3>(a);
+    r[4] = extract_bits<4>(a);
+    r[5] = extract_bits<5>(a);
+    r[6] = extract_bits<6>(a);
+    r[7] = extract_bits<7>(a);
+}
+
+/*  Computes the masks of each bit of 16 elements at @a p: the bit i of
+    @a bits[b] is set to the bit b of @a p[i].
+*/
+template<class T> SIMDPP_INL
+void bitslice_block(const T* p, uint16_t* bits)
+{
+    const unsigned S = sizeof(T);
+    const uint8_t* pb = reinterpret_cast<const uint8_t*>(p);
+    uint8<16> v[S], planes[S];
+    for (unsigned i = 0; i < S; ++i) {
+        v[i] = load_u(pb + 16 * i);
+    }
+    bitslice_planes<S>::split(v, planes);
+    for (unsigned i = 0; i < S; ++i) {
+        bitslice_extract8(planes[i], bits + 8 * bitslice_sig_byte(i, S));
+    }
+}
+
+/*  Computes the bit planes of 16*G elements at @a in. The plane of bit b is
+    stored to @a out[b * stride]. All elements are read before any output is
+    written.
+*/
+template<unsigned G, class T, class R> SIMDPP_INL
+void bitslice_rows(const T* in, R* out, std::size_t stride)
+{
+    const unsigned W = sizeof(T) * 8;
+    uint16_t bits[G][W];
+    for (unsigned g = 0; g < G; ++g) {
+        bitslice_block(in + 16 * g, bits[g]);
+    }
+    for (unsigned b = 0; b < W; ++b) {
+        R r = 0;
+        for (unsigned g = 0; g < G; ++g) {
+            r |= R(bits[g][b]) << (16 * g);
+        }
+        out[b * stride] = r;
+    }
+}
+
+/*  Returns a vector whose bytes at offsets 0..7 are the bytes of @a x in the
+    order of significance.
+*/
+static SIMDPP_INL uint8<16> bitslice_row(uint64_t x)
+{
+#if SIMDPP_BIG_ENDIAN
+    uint64_t r = 0;
+    for (unsigned i = 0; i < 8; ++i) {
+        r = (r << 8) | ((x >> (8 * i)) & 0xff);
+    }
+    x = r;
+#endif
+    return uint8<16>(splat<uint64<2>>(x));
+}
+
+/*  Transposes the 8x8 matrix of bytes whose rows are the lower halves of
+    @a r[0..7]. @a c[q] receives the columns 2q and 2q+1.
+*/
+static SIMDPP_INL void bitslice_transpose_bytes(const uint8<16>* r, uint8<16>* c)
+{
+    uint8<16> a0 = zip16_lo(r[0], r[1]);
+    uint8<16> a1 = zip16_lo(r[2], r[3]);
+    uint8<16> a2 = zip16_lo(r[4], r[5]);
+    uint8<16> a3 = zip16_lo(r[6], r[7]);
+    uint16<8> b0 = zip8_lo(uint16<8>(a0), uint16<8>(a1));
+    uint16<8> b1 = zip8_hi(uint16<8>(a0), uint16<8>(a1));
+    uint16<8> b2 = zip8_lo(uint16<8>(a2), uint16<8>(a3));
+    uint16<8> b3 = zip8_hi(uint16<8>(a2), uint16<8>(a3));
+    c[0] = uint8<16>(zip4_lo(uint32<4>(b0), uint32<4>(b2)));
+    c[1] = uint8<16>(zip4_hi(uint32<4>(b0), uint32<4>(b2)));
+    c[2] = uint8<16>(zip4_lo(uint32<4>(b1), uint32<4>(b3)));
+    c[3] = uint8<16>(zip4_hi(uint32<4>(b1), uint32<4>(b3)));
+}
+
+/*  Reconstructs 64 elements from their bit planes, the plane of bit b being
+    at @a in[b * stride]. The planes of the 8 bits of each byte form an 8x8
+    matrix of bytes whose columns, once transposed, are 8x8 bit matrices
+    whose transposes are the bytes of 8 consecutive elements.
+*/
+template<class T> SIMDPP_INL
+void unbitslice_rows(const uint64_t* in, std::size_t stride, T* out)
+{
+    const unsigned S = sizeof(T);
+    uint8<16> planes[4][S];
+    for (unsigned i = 0; i < S; ++i) {
+        const uint64_t* w = in + 8 * bitslice_sig_byte(i, S) * stride;
+        uint8<16> r[8], c[4];
+        for (unsigned k = 0; k < 8; ++k) {
+            r[k] = bitslice_row(w[k * stride]);
+        }
+        bitslice_transpose_bytes(r, c);
+        for (unsigned g = 0; g < 4; ++g) {
+            planes[g][i] = bit_transpose8x8(c[g]);
+        }
+    }
+    uint8_t* pb = reinterpret_cast<uint8_t*>(out);
+    for (unsigned g = 0; g < 4; ++g) {
+        uint8<16> v[S];
+        bitslice_planes<S>::merge(planes[g], v);
+        for (unsigned i = 0; i < S; ++i) {
+            store_u(pb + 16 * (g * S + i), v[i]);
+        }
+    }
+}
+
+static SIMDPP_INL std::size_t bitslice_words(std::size_t n)
+{
+    return (n + bitslice_word_bits - 1) / bitslice_word_bits;
+}
+
+template<class T>
+void bitslice(const T* in, std::size_t n, uint64_t* out)
+{
+    const std::size_t B = bitslice_word_bits;
+    std::size_t words = bitslice_words(n);
+    std::size_t w = 0;
+    for (; (w + 1) * B <= n; ++w) {
+        bitslice_rows<B / 16>(in + w * B, out + w, words);
+    }
+    if (w * B < n) {
+        T buf[B] = {};
+        std::memcpy(buf, in + w * B, (n - w * B) * sizeof(T));
+        bitslice_rows<B / 16>(buf, out + w, words);
+    }
+}
+
+template<class T>
+void unbitslice(const uint64_t* in, std::size_t n, T* out)
+{
+    const std::size_t B = bitslice_word_bits;
+    std::size_t words = bitslice_words(n);
+    std::size_t w = 0;
+    for (; (w + 1) * B <= n; ++w) {
+        unbitslice_rows(in + w, words, out + w * B);
+    }
+    if (w * B < n) {
+        T buf[B];
+        unbitslice_rows(in + w, words, buf);
+        std::memcpy(out + w * B, buf, (n - w * B) * sizeof(T));
+    }
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,148 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_COMPRESS_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_COMPRESS_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/cast.h>
+#include <simdpp/core/i_reduce_add.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/detail/algorithm/bit_scan.h>
+#include <simdpp/detail/get_expr.h>
+#include <simdpp/detail/mem_block.h>
+#include <cstddef>
+#include <cstring>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+#if SIMDPP_USE_AVX512F
+// Stores the elements of v selected by the bits of k contiguously to p
+template<class T> SIMDPP_INL
+void compress_store_k(T* p, __mmask16 k, const uint32<16>& v)
+{
+    _mm512_mask_compressstoreu_epi32(p, k, v.native());
+}
+
+template<class T> SIMDPP_INL
+void compress_store_k(T* p, __mmask16 k, const float32<16>& v)
+{
+    _mm512_mask_compressstoreu_ps(p, k, v.native());
+}
+
+template<class T> SIMDPP_INL
+void compress_store_k(T* p, __mmask8 k, const uint64<8>& v)
+{
+    _mm512_mask_compressstoreu_epi64(p, k, v.native());
+}
+
+template<class T> SIMDPP_INL
+void compress_store_k(T* p, __mmask8 k, const float64<8>& v)
+{
+    _mm512_mask_compressstoreu_pd(p, k, v.native());
+}
+#endif
+
+/*  Stores the elements of @a v whose corresponding elements of @a mask are
+    set contiguously to @a p and returns their number. Memory past the last
+    stored element is not written to.
+*/
+template<class T, class V, class M> SIMDPP_INL
+std::size_t compress_store(T* p, const V& v, const M& mask)
+{
+    mem_block<V> bv(v);
+    mem_block<V> bm{V(mask)};
+    T tmp[V::length];
+    unsigned c = 0;
+    for (unsigned i = 0; i < V::length; ++i) {
+        tmp[c] = bv[i];
+        c += bm[i] != 0;
+    }
+    std::memcpy(p, tmp, c * sizeof(T));
+    return c;
+}
+
+#if SIMDPP_USE_AVX512F
+template<class T> SIMDPP_INL
+std::size_t compress_store(T* p, const uint32<16>& v, const mask_int32<16>& mask)
+{
+    compress_store_k(p, mask.native(), v);
+    return bit_popcount(mask.native());
+}
+
+template<class T> SIMDPP_INL
+std::size_t compress_store(T* p, const float32<16>& v, const mask_float32<16>& mask)
+{
+    compress_store_k(p, mask.native(), v);
+    return bit_popcount(mask.native());
+}
+
+template<class T> SIMDPP_INL
+std::size_t compress_store(T* p, const uint64<8>& v, const mask_int64<8>& mask)
+{
+    compress_store_k(p, mask.native(), v);
+    return bit_popcount(mask.native());
+}
+
+template<class T> SIMDPP_INL
+std::size_t compress_store(T* p, const float64<8>& v, const mask_float64<8>& mask)
+{
+    compress_store_k(p, mask.native(), v);
+    return bit_popcount(mask.native());
+}
+#endif
+
+/*  Returns the number of set elements of @a mask, which is the result of a
+    comparison of vectors of type V.
+*/
+template<class V, class M> SIMDPP_INL
+unsigned mask_count(const M& mask)
+{
+    using U = typename type_of_tag<SIMDPP_TAG_UINT + V::size_tag,
+                                   V::length_bytes, void>::type;
+    U ones = bit_and(bit_cast<U>(V(mask)), splat<U>(1));
+    return static_cast<unsigned>(reduce_add(ones));
+}
+
+#if SIMDPP_USE_AVX512F
+template<class V> SIMDPP_INL
+unsigned mask_count(const mask_int32<16>& mask)
+{
+    return bit_popcount(mask.native());
+}
+
+template<class V> SIMDPP_INL
+unsigned mask_count(const mask_float32<16>& mask)
+{
+    return bit_popcount(mask.native());
+}
+
+template<class V> SIMDPP_INL
+unsigned mask_count(const mask_int64<8>& mask)
+{
+    return bit_popcount(mask.native());
+}
+
+template<class V> SIMDPP_INL
+unsigned mask_count(const mask_float64<8>& mask)
+{
+    return bit_popcount(mask.native());
+}
+#endif
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
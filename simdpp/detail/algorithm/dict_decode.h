@@ -0,0 +1,221 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_DICT_DECODE_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_DICT_DECODE_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/permute_bytes16.h>
+#include <simdpp/core/store_u.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+template<class T, class I> SIMDPP_INL
+void dict_decode_scalar(const I* idx, std::size_t n, const T* dict, T* out, std::size_t i)
+{
+    for (; i + 4 <= n; i += 4) {
+        T a = dict[idx[i]];
+        T b = dict[idx[i+1]];
+        T c = dict[idx[i+2]];
+        T d = dict[idx[i+3]];
+        out[i] = a;
+        out[i+1] = b;
+        out[i+2] = c;
+        out[i+3] = d;
+    }
+    for (; i < n; ++i) {
+        out[i] = dict[idx[i]];
+    }
+}
+
+// Whether the byte permutations needed by the dictionary lookup tables are available
+#if SIMDPP_USE_NULL || SIMDPP_USE_SSSE3 || SIMDPP_USE_NEON || SIMDPP_USE_ALTIVEC || SIMDPP_USE_MSA
+using dict_lut_is_vectorized = std::true_type;
+#else
+using dict_lut_is_vectorized = std::false_type;
+#endif
+
+/*  Decodes byte indices into a dictionary of at most 16 bytes held in a
+    vector. Each index is replicated to the bytes of its element, scaled by
+    the element size and offset by the byte position within the element;
+    the result selects the dictionary bytes with permute_bytes16. Elements
+    of a single byte use the native vector width since the permutation works
+    within 128-bit blocks; wider elements use 128-bit vectors. Returns the
+    number of decoded elements.
+*/
+template<unsigned W, unsigned S, class T>
+std::size_t dict_decode_lut(const uint8_t* idx, std::size_t n, const T* dict,
+                            std::size_t dict_size, T* out, std::true_type /*vectorized*/)
+{
+    using U = uint8<W>;
+    const unsigned E = W / S;
+
+    SIMDPP_ALIGN(W) uint8_t buf[W] = {};
+    std::memcpy(buf, dict, dict_size * S);
+    for (unsigned j = 16; j < W; ++j) {
+        buf[j] = buf[j - 16];
+    }
+    U d = load(buf);
+    for (unsigned j = 0; j < W; ++j) {
+        buf[j] = uint8_t(j % 16 / S);
+    }
+    U rep = load(buf);
+    for (unsigned j = 0; j < W; ++j) {
+        buf[j] = uint8_t(j % S);
+    }
+    U off = load(buf);
+
+    std::size_t i = 0;
+    for (; i + W <= n; i += E) {
+        U m = load_u(idx + i);
+        if (S > 1) {
+            m = permute_bytes16(m, rep);
+            for (unsigned k = 1; k < S; k *= 2) {
+                m = add(m, m);
+            }
+            m = add(m, off);
+        }
+        store_u(out + i, permute_bytes16(d, m));
+    }
+    return i;
+}
+
+template<unsigned W, unsigned S, class T> SIMDPP_INL
+std::size_t dict_decode_lut(const uint8_t*, std::size_t, const T*, std::size_t, T*,
+                            std::false_type /*vectorized*/)
+{
+    return 0;
+}
+
+template<class T, class I> SIMDPP_INL
+std::size_t dict_decode_small(const I*, std::size_t, const T*, std::size_t, T*,
+                              std::false_type /*byte indices*/)
+{
+    return 0;
+}
+
+template<class T, class I> SIMDPP_INL
+std::size_t dict_decode_small(const I* idx, std::size_t n, const T* dict,
+                              std::size_t dict_size, T* out, std::true_type /*byte indices*/)
+{
+    const unsigned S = sizeof(T);
+    const unsigned W = S == 1 ? SIMDPP_FAST_INT8_SIZE : 16;
+    using Vectorized = std::integral_constant<bool, dict_lut_is_vectorized::value &&
+                                                    S <= 8 && (S & (S - 1)) == 0>;
+    if (dict_size * S > 16) {
+        return 0;
+    }
+    return dict_decode_lut<W, S>(reinterpret_cast<const uint8_t*>(idx), n,
+                                 dict, dict_size, out, Vectorized());
+}
+
+#if SIMDPP_USE_AVX512F || SIMDPP_USE_AVX2
+// Gathers 16 or 8 elements of 4 or 8 bytes using 32-bit indices
+template<unsigned S> struct dict_gather;
+
+#if SIMDPP_USE_AVX512F
+template<> struct dict_gather<4> {
+    static const unsigned width = 16;
+    static SIMDPP_INL void run(const uint32_t* idx, const void* dict, void* out)
+    {
+        uint32<16> i = load_u(idx);
+        uint32<16> r = _mm512_i32gather_epi32(i.native(), dict, 4);
+        store_u(out, r);
+    }
+};
+
+template<> struct dict_gather<8> {
+    static const unsigned width = 8;
+    static SIMDPP_INL void run(const uint32_t* idx, const void* dict, void* out)
+    {
+        __m256i i = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx));
+        uint64<8> r = _mm512_i32gather_epi64(i, dict, 8);
+        store_u(out, r);
+    }
+};
+#else
+template<> struct dict_gather<4> {
+    static const unsigned width = 8;
+    static SIMDPP_INL void run(const uint32_t* idx, const void* dict, void* out)
+    {
+        uint32<8> i = load_u(idx);
+        uint32<8> r = _mm256_i32gather_epi32(reinterpret_cast<const int*>(dict),
+                                             i.native(), 4);
+        store_u(out, r);
+    }
+};
+
+template<> struct dict_gather<8> {
+    static const unsigned width = 4;
+    static SIMDPP_INL void run(const uint32_t* idx, const void* dict, void* out)
+    {
+        uint32<4> i = load_u(idx);
+        uint64<4> r = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(dict),
+                                             i.native(), 8);
+        store_u(out, r);
+    }
+};
+#endif
+#endif
+
+template<class T, class I> SIMDPP_INL
+std::size_t dict_decode_gather(const I*, std::size_t, const T*, std::size_t, T*,
+                               std::false_type /*32-bit indices*/)
+{
+    return 0;
+}
+
+template<class T, class I> SIMDPP_INL
+std::size_t dict_decode_gather(const I* idx, std::size_t n, const T* dict,
+                               std::size_t dict_size, T* out, std::true_type /*32-bit indices*/)
+{
+    std::size_t i = 0;
+#if SIMDPP_USE_AVX512F || SIMDPP_USE_AVX2
+    const unsigned S = sizeof(T) == 8 ? 8 : 4;
+    using G = dict_gather<S>;
+    // the gathers sign-extend the indices
+    if ((sizeof(T) == 4 || sizeof(T) == 8) && dict_size <= (std::size_t(1) << 31)) {
+        const uint32_t* uidx = reinterpret_cast<const uint32_t*>(idx);
+        for (; i + G::width <= n; i += G::width) {
+            G::run(uidx + i, dict, out + i);
+        }
+    }
+#else
+    (void) idx; (void) n; (void) dict; (void) dict_size; (void) out;
+#endif
+    return i;
+}
+
+template<class T, class I>
+void dict_decode(const I* idx, std::size_t n, const T* dict, std::size_t dict_size, T* out)
+{
+    using ByteIdx = std::integral_constant<bool, sizeof(I) == 1>;
+    using WordIdx = std::integral_constant<bool, sizeof(I) == 4>;
+    // at most one of the vectorized paths applies to any index type
+    std::size_t i = dict_decode_small(idx, n, dict, dict_size, out, ByteIdx()) +
+                    dict_decode_gather(idx, n, dict, dict_size, out, WordIdx());
+    dict_decode_scalar(idx, n, dict, out, i);
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
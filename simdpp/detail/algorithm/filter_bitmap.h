@@ -0,0 +1,279 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_FILTER_BITMAP_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_FILTER_BITMAP_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/cast.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/cmp_ge.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/extract_bits.h>
+#include <simdpp/core/i_sub.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/split.h>
+#include <simdpp/core/to_int8.h>
+#include <simdpp/detail/get_expr.h>
+#include <simdpp/detail/traits.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+
+/// Specifies how the results of a filter are combined with the output bitmap
+enum class filter_combine {
+    replace,    ///< the output bits are set to the results
+    intersect,  ///< the output bits are ANDed with the results
+    unite       ///< the output bits are ORed with the results
+};
+
+namespace detail {
+
+// The number of elements evaluated per output word
+static const unsigned filter_word_bits = 64;
+
+/*  Returns a 64-bit mask whose i-th bit is set if the i-th element of
+    @a mask, which is the result of a comparison of vectors of type V, is
+    set. The mask is narrowed to bytes and the bits are extracted using
+    extract_bits_any().
+*/
+template<class V, class M> SIMDPP_INL
+uint64_t filter_mask_bits(const M& mask)
+{
+    using U = typename type_of_tag<SIMDPP_TAG_UINT + V::size_tag,
+                                   V::length_bytes, void>::type;
+    uint8<64> b = to_uint8(bit_cast<U>(V(mask)));
+    uint8<32> lo, hi;
+    split(b, lo, hi);
+    return uint64_t(extract_bits_any(lo)) | (uint64_t(extract_bits_any(hi)) << 32);
+}
+
+#if SIMDPP_USE_AVX512F
+// Native AVX-512 masks already hold one bit per element
+template<class V, class M> SIMDPP_INL
+uint64_t filter_native_mask_bits(const M& mask)
+{
+    const unsigned B = M::base_length;
+    uint64_t r = 0;
+    for (unsigned i = 0; i < M::vec_length; ++i) {
+        r |= uint64_t(mask.vec(i).native()) << (i * B);
+    }
+    return r;
+}
+
+template<class V> SIMDPP_INL
+uint64_t filter_mask_bits(const mask_int32<64>& mask)
+{
+    return filter_native_mask_bits<V>(mask);
+}
+
+template<class V> SIMDPP_INL
+uint64_t filter_mask_bits(const mask_float32<64>& mask)
+{
+    return filter_native_mask_bits<V>(mask);
+}
+
+template<class V> SIMDPP_INL
+uint64_t filter_mask_bits(const mask_int64<64>& mask)
+{
+    return filter_native_mask_bits<V>(mask);
+}
+
+template<class V> SIMDPP_INL
+uint64_t filter_mask_bits(const mask_float64<64>& mask)
+{
+    return filter_native_mask_bits<V>(mask);
+}
+#endif
+
+#if SIMDPP_USE_AVX512BW
+template<class V> SIMDPP_INL
+uint64_t filter_mask_bits(const mask_int8<64>& mask)
+{
+    return mask.native();
+}
+
+template<class V> SIMDPP_INL
+uint64_t filter_mask_bits(const mask_int16<64>& mask)
+{
+    return filter_native_mask_bits<V>(mask);
+}
+#endif
+
+// Whether ordered comparisons of 64-bit integers are available
+#if SIMDPP_USE_NULL || SIMDPP_USE_AVX2 || SIMDPP_USE_AVX512F || \
+    (SIMDPP_USE_XOP && !SIMDPP_WORKAROUND_XOP_COM) || SIMDPP_USE_NEON64 || \
+    SIMDPP_USE_VSX_207 || SIMDPP_USE_MSA || SIMDPP_USE_ALTIVEC
+using filter_has_cmp_lt64 = std::true_type;
+#else
+using filter_has_cmp_lt64 = std::false_type;
+#endif
+
+/*  Evaluates lo <= x < hi for integers as (x - lo) < (hi - lo) using
+    unsigned wrapping arithmetic, which needs a single comparison. 64-bit
+    elements are evaluated one by one if 64-bit comparisons are not
+    available.
+*/
+template<class T>
+struct filter_range_int_pred {
+    using U = typename std::make_unsigned<T>::type;
+    using V = typename vector_for_element<U, filter_word_bits>::type;
+    U lo, range;
+
+    filter_range_int_pred(T l, T h) :
+        lo(U(l)), range(l < h ? U(U(h) - U(l)) : U(0)) {}
+
+    SIMDPP_INL bool operator()(T x) const
+    {
+        return U(U(x) - lo) < range;
+    }
+
+    SIMDPP_INL uint64_t bits(const T* p) const
+    {
+        using Vectorized = std::integral_constant<bool, sizeof(T) < 8 ||
+                                                        filter_has_cmp_lt64::value>;
+        return bits(p, Vectorized());
+    }
+
+    SIMDPP_INL uint64_t bits(const T* p, std::true_type /*vectorized*/) const
+    {
+        V x = load_u(p);
+        typename V::mask_vector_type m = cmp_lt(V(sub(x, splat<V>(lo))), splat<V>(range));
+        return filter_mask_bits<V>(m);
+    }
+
+    SIMDPP_INL uint64_t bits(const T* p, std::false_type /*vectorized*/) const
+    {
+        uint64_t r = 0;
+        for (unsigned i = 0; i < filter_word_bits; ++i) {
+            r |= uint64_t((*this)(p[i])) << i;
+        }
+        return r;
+    }
+};
+
+template<class T>
+struct filter_range_fp_pred {
+    using V = typename vector_for_element<T, filter_word_bits>::type;
+    T lo, hi;
+
+    filter_range_fp_pred(T l, T h) : lo(l), hi(h) {}
+
+    SIMDPP_INL bool operator()(T x) const
+    {
+        return lo <= x && x < hi;
+    }
+
+    SIMDPP_INL uint64_t bits(const T* p) const
+    {
+        V x = load_u(p);
+        typename V::mask_vector_type m = bit_and(cmp_ge(x, splat<V>(lo)),
+                                                 cmp_lt(x, splat<V>(hi)));
+        return filter_mask_bits<V>(m);
+    }
+};
+
+template<class T>
+struct filter_in_pred {
+    using V = typename vector_for_element<T, filter_word_bits>::type;
+    const T* set;
+    std::size_t size;
+
+    filter_in_pred(const T* s, std::size_t n) : set(s), size(n) {}
+
+    SIMDPP_INL bool operator()(T x) const
+    {
+        bool r = false;
+        for (std::size_t i = 0; i < size; ++i) {
+            r |= x == set[i];
+        }
+        return r;
+    }
+
+    SIMDPP_INL uint64_t bits(const T* p) const
+    {
+        if (size == 0) {
+            return 0;
+        }
+        V x = load_u(p);
+        typename V::mask_vector_type m = cmp_eq(x, splat<V>(set[0]));
+        for (std::size_t i = 1; i < size; ++i) {
+            m = bit_or(m, cmp_eq(x, splat<V>(set[i])));
+        }
+        return filter_mask_bits<V>(m);
+    }
+};
+
+template<filter_combine Op> SIMDPP_INL
+void filter_store(uint64_t& w, uint64_t bits)
+{
+    switch (Op) {
+    case filter_combine::replace: w = bits; break;
+    case filter_combine::intersect: w &= bits; break;
+    case filter_combine::unite: w |= bits; break;
+    }
+}
+
+/*  Evaluates the predicate for each 64 elements and stores the results as
+    a single output word. The elements of the last partial word are
+    evaluated one by one; its bits past @a n are computed as if the
+    predicate was false.
+*/
+template<filter_combine Op, class T, class P>
+void filter_bitmap_impl(const T* in, std::size_t n, uint64_t* out, const P& pred)
+{
+    const std::size_t B = filter_word_bits;
+    std::size_t w = 0;
+    for (; (w + 1) * B <= n; ++w) {
+        filter_store<Op>(out[w], pred.bits(in + w * B));
+    }
+    if (w * B < n) {
+        uint64_t bits = 0;
+        for (std::size_t i = w * B; i < n; ++i) {
+            bits |= uint64_t(pred(in[i])) << (i - w * B);
+        }
+        filter_store<Op>(out[w], bits);
+    }
+}
+
+template<class T, class P>
+void filter_bitmap(const T* in, std::size_t n, uint64_t* out,
+                   filter_combine op, const P& pred)
+{
+    switch (op) {
+    case filter_combine::replace:
+        filter_bitmap_impl<filter_combine::replace>(in, n, out, pred);
+        break;
+    case filter_combine::intersect:
+        filter_bitmap_impl<filter_combine::intersect>(in, n, out, pred);
+        break;
+    case filter_combine::unite:
+        filter_bitmap_impl<filter_combine::unite>(in, n, out, pred);
+        break;
+    }
+}
+
+template<class T>
+using filter_range_pred = typename std::conditional<std::is_floating_point<T>::value,
+                                                    filter_range_fp_pred<T>,
+                                                    filter_range_int_pred<T>>::type;
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
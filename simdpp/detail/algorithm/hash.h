@@ -0,0 +1,282 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_HASH_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_HASH_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/bit_xor.h>
+#include <simdpp/core/blend.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/i_mul.h>
+#include <simdpp/core/i_shift_l.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/store.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/mem_block.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+/*  The scalar and the vector versions of each function below must compute
+    exactly the same values. The functions implement the finalizers and the
+    32-bit variant of MurmurHash3.
+*/
+static const uint32_t hash_murmur_c1 = 0xcc9e2d51;
+static const uint32_t hash_murmur_c2 = 0x1b873593;
+
+static SIMDPP_INL uint32_t hash_rotl32(uint32_t x, unsigned r)
+{
+    return (x << r) | (x >> (32 - r));
+}
+
+template<unsigned R, unsigned N> SIMDPP_INL
+uint32<N> hash_rotl32(const uint32<N>& x)
+{
+    return bit_or(shift_l<R>(x), shift_r<32 - R>(x));
+}
+
+static SIMDPP_INL uint32_t hash_fmix32(uint32_t h)
+{
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+template<unsigned N> SIMDPP_INL
+uint32<N> hash_fmix32(uint32<N> h)
+{
+    h = bit_xor(h, shift_r<16>(h));
+    h = mul_lo(h, splat<uint32<N>>(0x85ebca6b));
+    h = bit_xor(h, shift_r<13>(h));
+    h = mul_lo(h, splat<uint32<N>>(0xc2b2ae35));
+    h = bit_xor(h, shift_r<16>(h));
+    return h;
+}
+
+static SIMDPP_INL uint64_t hash_fmix64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+/*  Computes the lower 64 bits of the products of the elements of @a a and
+    @a c. There is no 64-bit mul_lo, thus on x86 the product is assembled
+    from three 32x32->64-bit multiplications:
+        a * c = lo(a)*lo(c) + ((hi(a)*lo(c) + lo(a)*hi(c)) << 32)
+*/
+static SIMDPP_INL uint64<2> hash_mul64(const uint64<2>& a, uint64_t c)
+{
+#if SIMDPP_USE_AVX512DQ && SIMDPP_USE_AVX512VL
+    return _mm_mullo_epi64(a.native(), _mm_set1_epi64x(c));
+#elif SIMDPP_USE_SSE2
+    __m128i b = _mm_set1_epi64x(c);
+    __m128i lo = _mm_mul_epu32(a.native(), b);
+    __m128i t1 = _mm_mul_epu32(_mm_srli_epi64(a.native(), 32), b);
+    __m128i t2 = _mm_mul_epu32(a.native(), _mm_srli_epi64(b, 32));
+    __m128i hi = _mm_slli_epi64(_mm_add_epi64(t1, t2), 32);
+    return _mm_add_epi64(lo, hi);
+#else
+    mem_block<uint64<2>> r(a);
+    for (unsigned i = 0; i < 2; ++i) {
+        r[i] *= c;
+    }
+    return r;
+#endif
+}
+
+#if SIMDPP_USE_AVX2
+static SIMDPP_INL uint64<4> hash_mul64(const uint64<4>& a, uint64_t c)
+{
+#if SIMDPP_USE_AVX512DQ && SIMDPP_USE_AVX512VL
+    return _mm256_mullo_epi64(a.native(), _mm256_set1_epi64x(c));
+#else
+    __m256i b = _mm256_set1_epi64x(c);
+    __m256i lo = _mm256_mul_epu32(a.native(), b);
+    __m256i t1 = _mm256_mul_epu32(_mm256_srli_epi64(a.native(), 32), b);
+    __m256i t2 = _mm256_mul_epu32(a.native(), _mm256_srli_epi64(b, 32));
+    __m256i hi = _mm256_slli_epi64(_mm256_add_epi64(t1, t2), 32);
+    return _mm256_add_epi64(lo, hi);
+#endif
+}
+#endif
+
+#if SIMDPP_USE_AVX512F
+static SIMDPP_INL uint64<8> hash_mul64(const uint64<8>& a, uint64_t c)
+{
+#if SIMDPP_USE_AVX512DQ
+    return _mm512_mullo_epi64(a.native(), _mm512_set1_epi64(c));
+#else
+    __m512i b = _mm512_set1_epi64(c);
+    __m512i lo = _mm512_mul_epu32(a.native(), b);
+    __m512i t1 = _mm512_mul_epu32(_mm512_srli_epi64(a.native(), 32), b);
+    __m512i t2 = _mm512_mul_epu32(a.native(), _mm512_srli_epi64(b, 32));
+    __m512i hi = _mm512_slli_epi64(_mm512_add_epi64(t1, t2), 32);
+    return _mm512_add_epi64(lo, hi);
+#endif
+}
+#endif
+
+template<unsigned N> SIMDPP_INL
+uint64<N> hash_mul64(const uint64<N>& a, uint64_t c)
+{
+    uint64<N> r;
+    for (unsigned i = 0; i < r.vec_length; ++i) {
+        r.vec(i) = hash_mul64(a.vec(i), c);
+    }
+    return r;
+}
+
+template<unsigned N> SIMDPP_INL
+uint64<N> hash_fmix64(uint64<N> h)
+{
+    h = bit_xor(h, shift_r<33>(h));
+    h = hash_mul64(h, 0xff51afd7ed558ccdull);
+    h = bit_xor(h, shift_r<33>(h));
+    h = hash_mul64(h, 0xc4ceb9fe1a85ec53ull);
+    h = bit_xor(h, shift_r<33>(h));
+    return h;
+}
+
+// Reads a 32-bit little-endian value regardless of the byte order of the target
+static SIMDPP_INL uint32_t hash_read32le(const char* p)
+{
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(p);
+    return uint32_t(b[0]) | (uint32_t(b[1]) << 8) |
+           (uint32_t(b[2]) << 16) | (uint32_t(b[3]) << 24);
+}
+
+// Reads the 0 to 3 bytes that remain after the last full block
+static SIMDPP_INL uint32_t hash_read_tail(const char* p, std::size_t len)
+{
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(p);
+    uint32_t k = 0;
+    switch (len & 3) {
+    case 3: k ^= uint32_t(b[2]) << 16; // fall through
+    case 2: k ^= uint32_t(b[1]) << 8;  // fall through
+    case 1: k ^= uint32_t(b[0]);
+    }
+    return k;
+}
+
+static SIMDPP_INL uint32_t hash_mix_k(uint32_t k)
+{
+    k *= hash_murmur_c1;
+    k = hash_rotl32(k, 15);
+    k *= hash_murmur_c2;
+    return k;
+}
+
+template<unsigned N> SIMDPP_INL
+uint32<N> hash_mix_k(uint32<N> k)
+{
+    k = mul_lo(k, splat<uint32<N>>(hash_murmur_c1));
+    k = hash_rotl32<15>(k);
+    k = mul_lo(k, splat<uint32<N>>(hash_murmur_c2));
+    return k;
+}
+
+static SIMDPP_INL uint32_t hash_bytes_scalar(const char* p, std::size_t len,
+                                             uint32_t seed)
+{
+    uint32_t h = seed;
+    std::size_t nblocks = len / 4;
+    for (std::size_t i = 0; i < nblocks; ++i) {
+        h ^= hash_mix_k(hash_read32le(p + i * 4));
+        h = hash_rotl32(h, 13);
+        h = h * 5 + 0xe6546b64;
+    }
+    // mixing a zero tail does not change the hash
+    h ^= hash_mix_k(hash_read_tail(p + nblocks * 4, len));
+    h ^= uint32_t(len);
+    return hash_fmix32(h);
+}
+
+/*  Hashes up to N strings, one per element. The blocks of all strings are
+    processed in lockstep; the hashes of the strings that have no more full
+    blocks are kept unchanged using a blend. Thus the work is proportional to
+    the length of the longest string in the group.
+*/
+template<unsigned N>
+void hash_bytes_group(const char* const* ptrs, const std::size_t* lens,
+                      unsigned count, uint32_t* out, uint32_t seed)
+{
+    using U = uint32<N>;
+    std::size_t nblocks[N];
+    std::size_t max_blocks = 0;
+    for (unsigned i = 0; i < N; ++i) {
+        nblocks[i] = i < count ? lens[i] / 4 : 0;
+        max_blocks = std::max(max_blocks, nblocks[i]);
+    }
+
+    SIMDPP_ALIGN(N*4) uint32_t k[N];
+    SIMDPP_ALIGN(N*4) uint32_t active[N];
+    U h = splat<U>(seed);
+    for (std::size_t b = 0; b < max_blocks; ++b) {
+        for (unsigned i = 0; i < N; ++i) {
+            bool a = b < nblocks[i];
+            k[i] = a ? hash_read32le(ptrs[i] + b * 4) : 0;
+            active[i] = a ? 0xffffffff : 0;
+        }
+        U hn = bit_xor(h, hash_mix_k(load<U>(k)));
+        hn = hash_rotl32<13>(hn);
+        hn = add(mul_lo(hn, splat<U>(5)), splat<U>(0xe6546b64));
+        h = blend(hn, h, load<U>(active));
+    }
+
+    for (unsigned i = 0; i < N; ++i) {
+        k[i] = i < count ? hash_read_tail(ptrs[i] + nblocks[i] * 4, lens[i]) : 0;
+        active[i] = i < count ? uint32_t(lens[i]) : 0;
+    }
+    h = bit_xor(h, hash_mix_k(load<U>(k)));
+    h = bit_xor(h, load<U>(active));
+    h = hash_fmix32(h);
+
+    if (count == N) {
+        store_u(out, h);
+    } else {
+        store(k, h);
+        std::copy(k, k + count, out);
+    }
+}
+
+template<unsigned N>
+void hash_bytes_batch(const char* const* ptrs, const std::size_t* lens,
+                      std::size_t n, uint32_t* out, uint32_t seed)
+{
+    std::size_t i = 0;
+    for (; i + N <= n; i += N) {
+        hash_bytes_group<N>(ptrs + i, lens + i, N, out + i, seed);
+    }
+    if (i < n) {
+        hash_bytes_group<N>(ptrs + i, lens + i, unsigned(n - i), out + i, seed);
+    }
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,305 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_HISTOGRAM_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_HISTOGRAM_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/aligned_allocator.h>
+#include <simdpp/core/f_add.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/traits.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+#if SIMDPP_USE_AVX512F
+/*  Each lane of a vector of 16 keys is counted into its own sub-histogram
+    using gather, add and scatter. The lanes never access the same element,
+    thus no conflict detection is needed.
+*/
+static const unsigned histogram_num_sub = 16;
+#else
+/*  Consecutive keys are accumulated into different sub-histograms. Thus runs
+    of equal keys do not create a chain of dependent read-modify-write
+    operations on the same memory location, which would otherwise be limited
+    by the store-to-load forwarding latency.
+*/
+static const unsigned histogram_num_sub = 4;
+#endif
+
+// Sub-histograms of up to this many bins are allocated on the stack
+static const std::size_t histogram_max_stack_bins = 256;
+
+// Sub-histograms are not used if they would not fit into the L2 cache
+static const std::size_t histogram_max_sub_bytes = 256 * 1024;
+
+/*  Adds the histogram_num_sub sub-histograms of @a num_bins elements at
+    @a sub to @a dst using vector additions.
+*/
+template<class T>
+void histogram_merge(T* dst, const T* sub, std::size_t num_bins)
+{
+    using V = typename vector_for_element<T, 64 / sizeof(T)>::type;
+    const std::size_t L = V::length;
+    std::size_t i = 0;
+    for (; i + L <= num_bins; i += L) {
+        V s = load_u(dst + i);
+        for (unsigned k = 0; k < histogram_num_sub; ++k) {
+            V t = load_u(sub + k * num_bins + i);
+            s = add(s, t);
+        }
+        store_u(dst + i, s);
+    }
+    for (; i < num_bins; ++i) {
+        for (unsigned k = 0; k < histogram_num_sub; ++k) {
+            dst[i] += sub[k * num_bins + i];
+        }
+    }
+}
+
+#if SIMDPP_USE_AVX512F
+/*  The masked forms of the conversions, extracts and gathers are used with
+    all lanes enabled and a zero source, because the unmasked forms leave the
+    source undefined, which GCC reports as a possibly uninitialized value.
+*/
+static SIMDPP_INL uint32<16> histogram_load_keys(const uint8_t* p)
+{
+    uint8<16> k = load_u(p);
+    return _mm512_maskz_cvtepu8_epi32(0xffff, k.native());
+}
+
+static SIMDPP_INL uint32<16> histogram_load_keys(const uint16_t* p)
+{
+    uint16<16> k = load_u(p);
+    return _mm512_maskz_cvtepu16_epi32(0xffff, k.native());
+}
+
+static SIMDPP_INL uint32<16> histogram_load_keys(const uint32_t* p)
+{
+    uint32<16> k = load_u(p);
+    return k;
+}
+
+// Returns the indices of the keys at @a p within the per-lane sub-histograms
+template<class K> SIMDPP_INL
+uint32<16> histogram_lane_index(const K* p, const uint32<16>& lane_offsets)
+{
+    return add(histogram_load_keys(p), lane_offsets);
+}
+
+// Returns lane * num_bins for each of the 16 lanes
+static SIMDPP_INL uint32<16> histogram_lane_offsets(std::size_t num_bins)
+{
+    SIMDPP_ALIGN(64) uint32_t offsets[histogram_num_sub];
+    for (unsigned k = 0; k < histogram_num_sub; ++k) {
+        offsets[k] = uint32_t(k * num_bins);
+    }
+    return load(offsets);
+}
+
+// Adds the 16 values at @a values to the elements of @a sub at @a idx
+template<class T, unsigned Size = sizeof(T),
+         bool Float = std::is_floating_point<T>::value>
+struct histogram_add_lanes;
+
+template<class T> struct histogram_add_lanes<T,4,false> {
+    static SIMDPP_INL void run(T* sub, const uint32<16>& idx, const T* values)
+    {
+        uint32<16> v = load_u(values);
+        uint32<16> s = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xffff,
+                                                    idx.native(), sub, 4);
+        s = add(s, v);
+        _mm512_i32scatter_epi32(sub, idx.native(), s.native(), 4);
+    }
+};
+
+template<class T> struct histogram_add_lanes<T,4,true> {
+    static SIMDPP_INL void run(T* sub, const uint32<16>& idx, const T* values)
+    {
+        float32<16> v = load_u(values);
+        float32<16> s = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xffff,
+                                                  idx.native(), sub, 4);
+        s = add(s, v);
+        _mm512_i32scatter_ps(sub, idx.native(), s.native(), 4);
+    }
+};
+
+template<class T> struct histogram_add_lanes<T,8,false> {
+    static SIMDPP_INL void run(T* sub, const uint32<16>& idx, const T* values)
+    {
+        __m256i lo = _mm512_maskz_extracti64x4_epi64(0xf, idx.native(), 0);
+        __m256i hi = _mm512_maskz_extracti64x4_epi64(0xf, idx.native(), 1);
+        uint64<8> v0 = load_u(values);
+        uint64<8> v1 = load_u(values + 8);
+        uint64<8> s0 = _mm512_mask_i32gather_epi64(_mm512_setzero_si512(), 0xff, lo, sub, 8);
+        s0 = add(s0, v0);
+        _mm512_i32scatter_epi64(sub, lo, s0.native(), 8);
+        uint64<8> s1 = _mm512_mask_i32gather_epi64(_mm512_setzero_si512(), 0xff, hi, sub, 8);
+        s1 = add(s1, v1);
+        _mm512_i32scatter_epi64(sub, hi, s1.native(), 8);
+    }
+};
+
+template<class T> struct histogram_add_lanes<T,8,true> {
+    static SIMDPP_INL void run(T* sub, const uint32<16>& idx, const T* values)
+    {
+        __m256i lo = _mm512_maskz_extracti64x4_epi64(0xf, idx.native(), 0);
+        __m256i hi = _mm512_maskz_extracti64x4_epi64(0xf, idx.native(), 1);
+        float64<8> v0 = load_u(values);
+        float64<8> v1 = load_u(values + 8);
+        float64<8> s0 = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xff, lo, sub, 8);
+        s0 = add(s0, v0);
+        _mm512_i32scatter_pd(sub, lo, s0.native(), 8);
+        float64<8> s1 = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xff, hi, sub, 8);
+        s1 = add(s1, v1);
+        _mm512_i32scatter_pd(sub, hi, s1.native(), 8);
+    }
+};
+
+// Adds values[i] to sub[keys[i]] of the (i % histogram_num_sub)-th sub-histogram
+template<class K, class T>
+void histogram_accumulate_sub(const K* keys, const T* values, std::size_t n,
+                              T* sub, std::size_t num_bins)
+{
+    uint32<16> offsets = histogram_lane_offsets(num_bins);
+    std::size_t i = 0;
+    for (; i + histogram_num_sub <= n; i += histogram_num_sub) {
+        uint32<16> idx = histogram_lane_index(keys + i, offsets);
+        histogram_add_lanes<T>::run(sub, idx, values + i);
+    }
+    for (; i < n; ++i) {
+        sub[keys[i]] += values[i];
+    }
+}
+
+template<class K>
+void histogram_count_sub(const K* keys, std::size_t n,
+                         uint32_t* sub, std::size_t num_bins)
+{
+    uint32<16> offsets = histogram_lane_offsets(num_bins);
+    uint32<16> one = splat(1);
+    std::size_t i = 0;
+    for (; i + histogram_num_sub <= n; i += histogram_num_sub) {
+        uint32<16> idx = histogram_lane_index(keys + i, offsets);
+        uint32<16> s = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xffff,
+                                                    idx.native(), sub, 4);
+        s = add(s, one);
+        _mm512_i32scatter_epi32(sub, idx.native(), s.native(), 4);
+    }
+    for (; i < n; ++i) {
+        sub[keys[i]]++;
+    }
+}
+#else
+// Adds values[i] to sub[keys[i]] of the (i % histogram_num_sub)-th sub-histogram
+template<class K, class T>
+void histogram_accumulate_sub(const K* keys, const T* values, std::size_t n,
+                              T* sub, std::size_t num_bins)
+{
+    T* s0 = sub;
+    T* s1 = sub + num_bins;
+    T* s2 = sub + num_bins * 2;
+    T* s3 = sub + num_bins * 3;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0[keys[i]] += values[i];
+        s1[keys[i+1]] += values[i+1];
+        s2[keys[i+2]] += values[i+2];
+        s3[keys[i+3]] += values[i+3];
+    }
+    for (; i < n; ++i) {
+        s0[keys[i]] += values[i];
+    }
+}
+
+template<class K>
+void histogram_count_sub(const K* keys, std::size_t n,
+                         uint32_t* sub, std::size_t num_bins)
+{
+    uint32_t* s0 = sub;
+    uint32_t* s1 = sub + num_bins;
+    uint32_t* s2 = sub + num_bins * 2;
+    uint32_t* s3 = sub + num_bins * 3;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0[keys[i]]++;
+        s1[keys[i+1]]++;
+        s2[keys[i+2]]++;
+        s3[keys[i+3]]++;
+    }
+    for (; i < n; ++i) {
+        s0[keys[i]]++;
+    }
+}
+#endif
+
+/*  Returns whether sub-histograms should be used. Clearing and merging them
+    takes time proportional to the number of bins, which is worthwhile only
+    if there are more keys than bins in all sub-histograms.
+*/
+template<class T> SIMDPP_INL
+bool histogram_use_sub(std::size_t n, std::size_t num_bins)
+{
+    return n >= num_bins * histogram_num_sub &&
+           num_bins * histogram_num_sub * sizeof(T) <= histogram_max_sub_bytes;
+}
+
+template<class K>
+void histogram(const K* keys, std::size_t n, uint32_t* counts, std::size_t num_bins)
+{
+    if (!histogram_use_sub<uint32_t>(n, num_bins)) {
+        for (std::size_t i = 0; i < n; ++i) {
+            counts[keys[i]]++;
+        }
+        return;
+    }
+    if (num_bins <= histogram_max_stack_bins) {
+        SIMDPP_ALIGN(64) uint32_t sub[histogram_num_sub * histogram_max_stack_bins] = {};
+        histogram_count_sub(keys, n, sub, num_bins);
+        histogram_merge(counts, sub, num_bins);
+    } else {
+        std::vector<uint32_t, aligned_allocator<uint32_t, 64>>
+                sub(histogram_num_sub * num_bins, 0);
+        histogram_count_sub(keys, n, sub.data(), num_bins);
+        histogram_merge(counts, sub.data(), num_bins);
+    }
+}
+
+template<class K, class T>
+void group_sum(const K* keys, const T* values, std::size_t n, T* out,
+               std::size_t num_groups)
+{
+    if (!histogram_use_sub<T>(n, num_groups)) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[keys[i]] += values[i];
+        }
+        return;
+    }
+    std::vector<T, aligned_allocator<T, 64>> sub(histogram_num_sub * num_groups, T());
+    histogram_accumulate_sub(keys, values, n, sub.data(), num_groups);
+    histogram_merge(out, sub.data(), num_groups);
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
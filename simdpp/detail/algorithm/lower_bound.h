@@ -0,0 +1,239 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_LOWER_BOUND_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_LOWER_BOUND_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/cache.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/detail/algorithm/compress.h>
+#include <simdpp/detail/algorithm/sort.h>
+#include <simdpp/detail/traits.h>
+#include <algorithm>
+#include <cstddef>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+// The number of elements in a 64-byte block, which is the unit that is
+// compared against a key at once
+template<class T>
+struct search_block_length : std::integral_constant<unsigned, 64 / sizeof(T)> {};
+
+template<class T>
+using search_vector = typename vector_for_element<T, search_block_length<T>::value>::type;
+
+// Returns the number of the elements at p[0..W) that are less than key
+template<class T> SIMDPP_INL
+unsigned search_count_less(const T* p, T key, std::true_type /*vectorized*/)
+{
+    using V = search_vector<T>;
+    V v = load_u(p);
+    typename V::mask_vector_type m = cmp_lt(v, splat<V>(key));
+    return mask_count<V>(m);
+}
+
+template<class T> SIMDPP_INL
+unsigned search_count_less(const T* p, T key, std::false_type /*vectorized*/)
+{
+    unsigned c = 0;
+    for (unsigned i = 0; i < search_block_length<T>::value; ++i) {
+        c += p[i] < key;
+    }
+    return c;
+}
+
+template<class T> SIMDPP_INL
+unsigned search_count_less(const T* p, T key)
+{
+    return search_count_less(p, key, sort_is_vectorized<T>());
+}
+
+/*  Narrows the range that contains the result down to W elements using
+    branchless binary search and then counts the elements less than the key
+    in a single W-element block. The block is moved back if needed so that it
+    does not extend past the end of the array.
+*/
+template<class T>
+std::size_t search_lower_bound(const T* p, std::size_t n, T key)
+{
+    const std::size_t W = search_block_length<T>::value;
+    if (n < W) {
+        std::size_t c = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            c += p[i] < key;
+        }
+        return c;
+    }
+
+    const T* base = p;
+    std::size_t len = n;
+    while (len > W) {
+        std::size_t half = len / 2;
+        base = (base[half - 1] < key) ? base + half : base;
+        len -= half;
+    }
+    const T* block = std::min(base, p + n - W);
+    return (block - p) + search_count_less(block, key);
+}
+
+// The number of keys that lower_bound_many() and search_tree_lower_bound_many()
+// search for simultaneously
+static const unsigned search_group_size = 8;
+
+/*  Searches for a group of keys in lockstep. The lengths of the ranges do not
+    depend on the keys, thus only the bases differ. Since the searches are
+    independent, the loads of different keys overlap. The location of the
+    next probe of each key is prefetched.
+*/
+template<class T>
+void search_lower_bound_many(const T* p, std::size_t n,
+                             const T* keys, std::size_t num_keys,
+                             std::size_t* out)
+{
+    const std::size_t W = search_block_length<T>::value;
+    const unsigned G = search_group_size;
+    std::size_t k = 0;
+
+    if (n >= W) {
+        for (; k + G <= num_keys; k += G) {
+            const T* base[G];
+            for (unsigned g = 0; g < G; ++g) {
+                base[g] = p;
+            }
+
+            std::size_t len = n;
+            while (len > W) {
+                std::size_t half = len / 2;
+                len -= half;
+                for (unsigned g = 0; g < G; ++g) {
+                    const T* b = base[g];
+                    b = (b[half - 1] < keys[k + g]) ? b + half : b;
+                    if (len > W) {
+                        prefetch_read(b + len / 2 - 1);
+                    }
+                    base[g] = b;
+                }
+            }
+
+            for (unsigned g = 0; g < G; ++g) {
+                const T* block = std::min(base[g], p + n - W);
+                out[k + g] = (block - p) + search_count_less(block, keys[k + g]);
+            }
+        }
+    }
+    for (; k < num_keys; ++k) {
+        out[k] = search_lower_bound(p, n, keys[k]);
+    }
+}
+
+/*  Implicit B-tree layout: node k holds W keys and has W + 1 children at
+    indices k * (W + 1) + i + 1. The keys are assigned in in-order, thus the
+    keys of the subtree of child i lie between the keys i-1 and i of node k.
+*/
+template<class T>
+void search_tree_fill(T* nodes, std::size_t* ranks, std::size_t num_nodes,
+                      std::size_t k, const T* p, std::size_t n, std::size_t& t)
+{
+    const std::size_t W = search_block_length<T>::value;
+    if (k >= num_nodes) {
+        return;
+    }
+    for (std::size_t i = 0; i <= W; ++i) {
+        search_tree_fill(nodes, ranks, num_nodes, k * (W + 1) + i + 1, p, n, t);
+        if (i < W) {
+            if (t < n) {
+                nodes[k * W + i] = p[t];
+                ranks[k * W + i] = t;
+            }
+            t++;
+        }
+    }
+}
+
+// Marks that no candidate slot has been found during the descent
+static const std::size_t search_no_slot = ~std::size_t(0);
+
+/*  At each node the number of keys less than the searched key selects both
+    the candidate slot within the node and the child to descend to. The
+    candidate found at the deepest level is the smallest one, thus only the
+    slot index is tracked during the descent and its rank is loaded once.
+*/
+template<class T>
+std::size_t search_tree_lower_bound(const T* nodes, const std::size_t* ranks,
+                                    std::size_t num_nodes, std::size_t n, T key)
+{
+    const std::size_t W = search_block_length<T>::value;
+    std::size_t slot = search_no_slot;
+    std::size_t k = 0;
+    while (k < num_nodes) {
+        unsigned i = search_count_less(nodes + k * W, key);
+        slot = i < W ? k * W + i : slot;
+        k = k * (W + 1) + i + 1;
+    }
+    return slot == search_no_slot ? n : ranks[slot];
+}
+
+template<class T>
+void search_tree_lower_bound_many(const T* nodes, const std::size_t* ranks,
+                                  std::size_t num_nodes, std::size_t n,
+                                  const T* keys, std::size_t num_keys,
+                                  std::size_t* out)
+{
+    const std::size_t W = search_block_length<T>::value;
+    const unsigned G = search_group_size;
+    std::size_t k = 0;
+
+    for (; k + G <= num_keys; k += G) {
+        std::size_t node[G];
+        std::size_t slot[G];
+        for (unsigned g = 0; g < G; ++g) {
+            node[g] = 0;
+            slot[g] = search_no_slot;
+        }
+
+        // The depths of the leaves differ by at most one
+        bool active = num_nodes > 0;
+        while (active) {
+            active = false;
+            for (unsigned g = 0; g < G; ++g) {
+                std::size_t c = node[g];
+                if (c >= num_nodes) {
+                    continue;
+                }
+                unsigned i = search_count_less(nodes + c * W, keys[k + g]);
+                slot[g] = i < W ? c * W + i : slot[g];
+                c = c * (W + 1) + i + 1;
+                if (c < num_nodes) {
+                    prefetch_read(nodes + c * W);
+                    active = true;
+                }
+                node[g] = c;
+            }
+        }
+        for (unsigned g = 0; g < G; ++g) {
+            out[k + g] = slot[g] == search_no_slot ? n : ranks[slot[g]];
+        }
+    }
+    for (; k < num_keys; ++k) {
+        out[k] = search_tree_lower_bound(nodes, ranks, num_nodes, n, keys[k]);
+    }
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,625 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_MEMORY_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_MEMORY_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/extract_bits.h>
+#include <simdpp/core/i_reduce_add.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/i_sub.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/permute_bytes16.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/stream.h>
+#include <simdpp/detail/algorithm/bit_scan.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+// The widest byte vector that is natively supported
+using mem_vector = uint8<SIMDPP_FAST_INT8_SIZE>;
+static const std::size_t mem_vector_size = SIMDPP_FAST_INT8_SIZE;
+
+// Returns a bit mask with bit i set if the i-th elements of a and b are equal
+static SIMDPP_INL uint64_t mem_eq_bits(const uint8<16>& a, const uint8<16>& b)
+{
+    return extract_bits_any(uint8<16>(cmp_eq(a, b)));
+}
+
+static SIMDPP_INL uint64_t mem_eq_bits(const uint8<32>& a, const uint8<32>& b)
+{
+    return extract_bits_any(uint8<32>(cmp_eq(a, b)));
+}
+
+#if SIMDPP_USE_AVX512BW
+static SIMDPP_INL uint64_t mem_eq_bits(const uint8<64>& a, const uint8<64>& b)
+{
+    mask_int8<64> m = cmp_eq(a, b);
+    return m.native();
+}
+
+// Returns a mask that selects the first n bytes, n < 64
+static SIMDPP_INL __mmask64 mem_tail_mask(std::size_t n)
+{
+    return (uint64_t(1) << n) - 1;
+}
+#endif
+
+/*  Copies less than mem_vector_size bytes. On AVX-512BW a single masked load
+    and store is used. Otherwise the data is copied as two possibly
+    overlapping pieces of the largest power-of-two size not exceeding n.
+*/
+static SIMDPP_INL void copy_small(char* d, const char* s, std::size_t n)
+{
+#if SIMDPP_USE_AVX512BW
+    __mmask64 k = mem_tail_mask(n);
+    _mm512_mask_storeu_epi8(d, k, _mm512_maskz_loadu_epi8(k, s));
+#else
+    if (n >= 16) {
+        uint8<16> a = load_u(s);
+        uint8<16> b = load_u(s + n - 16);
+        store_u(d, a);
+        store_u(d + n - 16, b);
+    } else if (n >= 8) {
+        uint64_t a, b;
+        std::memcpy(&a, s, 8);
+        std::memcpy(&b, s + n - 8, 8);
+        std::memcpy(d, &a, 8);
+        std::memcpy(d + n - 8, &b, 8);
+    } else if (n >= 4) {
+        uint32_t a, b;
+        std::memcpy(&a, s, 4);
+        std::memcpy(&b, s + n - 4, 4);
+        std::memcpy(d, &a, 4);
+        std::memcpy(d + n - 4, &b, 4);
+    } else if (n >= 2) {
+        uint16_t a, b;
+        std::memcpy(&a, s, 2);
+        std::memcpy(&b, s + n - 2, 2);
+        std::memcpy(d, &a, 2);
+        std::memcpy(d + n - 2, &b, 2);
+    } else if (n == 1) {
+        *d = *s;
+    }
+#endif
+}
+
+static SIMDPP_INL void fill_small(char* d, uint8_t value, std::size_t n)
+{
+#if SIMDPP_USE_AVX512BW
+    _mm512_mask_storeu_epi8(d, mem_tail_mask(n), _mm512_set1_epi8(value));
+#else
+    if (n >= 16) {
+        uint8<16> v = make_uint(value);
+        store_u(d, v);
+        store_u(d + n - 16, v);
+    } else if (n >= 8) {
+        uint64_t v = value * 0x0101010101010101ull;
+        std::memcpy(d, &v, 8);
+        std::memcpy(d + n - 8, &v, 8);
+    } else if (n >= 4) {
+        uint32_t v = value * 0x01010101u;
+        std::memcpy(d, &v, 4);
+        std::memcpy(d + n - 4, &v, 4);
+    } else if (n >= 2) {
+        uint16_t v = value * 0x0101u;
+        std::memcpy(d, &v, 2);
+        std::memcpy(d + n - 2, &v, 2);
+    } else if (n == 1) {
+        *d = static_cast<char>(value);
+    }
+#endif
+}
+
+static SIMDPP_INL
+void copy_impl(char* d, const char* s, std::size_t n, std::size_t stream_threshold)
+{
+    const std::size_t L = mem_vector_size;
+    if (n < L) {
+        copy_small(d, s, n);
+        return;
+    }
+
+    // The last, possibly partial, vector is handled by an overlapping store
+    mem_vector last = load_u(s + n - L);
+    std::size_t i = 0;
+
+#if SIMDPP_USE_SSE2
+    if (n >= stream_threshold) {
+        // Store the head unaligned and then continue from the first aligned
+        // destination address, as required by stream()
+        mem_vector first = load_u(s);
+        store_u(d, first);
+        i = L - reinterpret_cast<std::uintptr_t>(d) % L;
+        for (; i + L <= n; i += L) {
+            mem_vector v = load_u(s + i);
+            stream(d + i, v);
+        }
+        store_u(d + n - L, last);
+        stream_fence();
+        return;
+    }
+#else
+    (void) stream_threshold;
+#endif
+
+    for (; i + L*4 <= n; i += L*4) {
+        mem_vector v0 = load_u(s + i);
+        mem_vector v1 = load_u(s + i + L);
+        mem_vector v2 = load_u(s + i + L*2);
+        mem_vector v3 = load_u(s + i + L*3);
+        store_u(d + i, v0);
+        store_u(d + i + L, v1);
+        store_u(d + i + L*2, v2);
+        store_u(d + i + L*3, v3);
+    }
+    for (; i + L <= n; i += L) {
+        mem_vector v = load_u(s + i);
+        store_u(d + i, v);
+    }
+    store_u(d + n - L, last);
+}
+
+static SIMDPP_INL
+void fill_impl(char* d, uint8_t value, std::size_t n, std::size_t stream_threshold)
+{
+    const std::size_t L = mem_vector_size;
+    if (n < L) {
+        fill_small(d, value, n);
+        return;
+    }
+
+    mem_vector v = make_uint(value);
+    std::size_t i = 0;
+
+#if SIMDPP_USE_SSE2
+    if (n >= stream_threshold) {
+        store_u(d, v);
+        i = L - reinterpret_cast<std::uintptr_t>(d) % L;
+        for (; i + L <= n; i += L) {
+            stream(d + i, v);
+        }
+        store_u(d + n - L, v);
+        stream_fence();
+        return;
+    }
+#else
+    (void) stream_threshold;
+#endif
+
+    for (; i + L*4 <= n; i += L*4) {
+        store_u(d + i, v);
+        store_u(d + i + L, v);
+        store_u(d + i + L*2, v);
+        store_u(d + i + L*3, v);
+    }
+    for (; i + L <= n; i += L) {
+        store_u(d + i, v);
+    }
+    store_u(d + n - L, v);
+}
+
+static SIMDPP_INL int compare_at(const char* a, const char* b, std::size_t i)
+{
+    return int(static_cast<unsigned char>(a[i])) -
+           int(static_cast<unsigned char>(b[i]));
+}
+
+static SIMDPP_INL int compare_impl(const char* a, const char* b, std::size_t n)
+{
+    const std::size_t L = mem_vector_size;
+    const uint64_t all = ~uint64_t(0) >> (64 - L);
+
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        mem_vector va = load_u(a + i);
+        mem_vector vb = load_u(b + i);
+        uint64_t eq = mem_eq_bits(va, vb);
+        if (eq != all) {
+            return compare_at(a, b, i + bit_scan_forward(~eq));
+        }
+    }
+    if (i == n) {
+        return 0;
+    }
+
+    if (n >= L) {
+        // The bytes before n - L are known to be equal
+        i = n - L;
+        mem_vector va = load_u(a + i);
+        mem_vector vb = load_u(b + i);
+        uint64_t eq = mem_eq_bits(va, vb);
+        if (eq != all) {
+            return compare_at(a, b, i + bit_scan_forward(~eq));
+        }
+        return 0;
+    }
+
+#if SIMDPP_USE_AVX512BW
+    __mmask64 k = mem_tail_mask(n);
+    uint8<64> va = _mm512_maskz_loadu_epi8(k, a);
+    uint8<64> vb = _mm512_maskz_loadu_epi8(k, b);
+    uint64_t eq = mem_eq_bits(va, vb);
+    if (eq != all) {
+        return compare_at(a, b, bit_scan_forward(~eq));
+    }
+#else
+    for (; i < n; ++i) {
+        if (a[i] != b[i]) {
+            return compare_at(a, b, i);
+        }
+    }
+#endif
+    return 0;
+}
+
+static SIMDPP_INL
+std::size_t find_byte_impl(const char* p, std::size_t n, uint8_t value)
+{
+    const std::size_t L = mem_vector_size;
+    mem_vector vv = make_uint(value);
+
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        mem_vector v = load_u(p + i);
+        uint64_t eq = mem_eq_bits(v, vv);
+        if (eq != 0) {
+            return i + bit_scan_forward(eq);
+        }
+    }
+    if (i == n) {
+        return n;
+    }
+
+    if (n >= L) {
+        // The bytes before n - L are known not to match
+        i = n - L;
+        mem_vector v = load_u(p + i);
+        uint64_t eq = mem_eq_bits(v, vv);
+        if (eq != 0) {
+            return i + bit_scan_forward(eq);
+        }
+        return n;
+    }
+
+#if SIMDPP_USE_AVX512BW
+    __mmask64 k = mem_tail_mask(n);
+    uint8<64> v = _mm512_maskz_loadu_epi8(k, p);
+    uint64_t eq = mem_eq_bits(v, vv) & k;
+    if (eq != 0) {
+        return bit_scan_forward(eq);
+    }
+#else
+    for (; i < n; ++i) {
+        if (static_cast<uint8_t>(p[i]) == value) {
+            return i;
+        }
+    }
+#endif
+    return n;
+}
+
+static SIMDPP_INL
+std::size_t count_byte_impl(const char* p, std::size_t n, uint8_t value)
+{
+    const std::size_t L = mem_vector_size;
+    mem_vector vv = make_uint(value);
+
+    // Each matching byte decrements its 8-bit counter by one. The counters
+    // are summed before they can overflow.
+    std::size_t r = 0;
+    std::size_t i = 0;
+    while (i + L <= n) {
+        mem_vector acc = make_zero();
+        std::size_t end = n - (n - i) % L;
+        if ((end - i) / L > 255) {
+            end = i + 255 * L;
+        }
+        for (; i < end; i += L) {
+            mem_vector v = load_u(p + i);
+            mem_vector::mask_vector_type eq = cmp_eq(v, vv);
+            acc = sub(acc, mem_vector(eq));
+        }
+        r += reduce_add(acc);
+    }
+    if (i == n) {
+        return r;
+    }
+
+    if (n >= L) {
+        // Skip the bytes before i that have already been counted
+        mem_vector v = load_u(p + n - L);
+        uint64_t eq = mem_eq_bits(v, vv);
+        return r + bit_popcount(eq >> (L - (n - i)));
+    }
+
+#if SIMDPP_USE_AVX512BW
+    __mmask64 k = mem_tail_mask(n);
+    uint8<64> v = _mm512_maskz_loadu_epi8(k, p);
+    r += bit_popcount(mem_eq_bits(v, vv) & k);
+#else
+    for (; i < n; ++i) {
+        r += static_cast<uint8_t>(p[i]) == value;
+    }
+#endif
+    return r;
+}
+
+/*  Byte b belongs to the set if the bitwise AND of lo[b & 0xf] and
+    hi[b >> 4] is nonzero in any of the first count pairs of tables. Each
+    distinct set of low nibbles that occurs with some high nibble is given
+    its own bit, thus up to 8 such sets fit into one pair of tables and any
+    set of bytes fits into two.
+*/
+struct find_any_of_lut {
+    unsigned count;
+    uint8_t lo[2][16];
+    uint8_t hi[2][16];
+
+    find_any_of_lut(const uint8_t* set, std::size_t size)
+    {
+        uint16_t low_sets[16] = {};
+        for (std::size_t i = 0; i < size; ++i) {
+            low_sets[set[i] >> 4] |= uint16_t(1) << (set[i] & 0xf);
+        }
+        std::memset(lo, 0, sizeof(lo));
+        std::memset(hi, 0, sizeof(hi));
+
+        uint16_t classes[16];
+        unsigned num = 0;
+        for (unsigned h = 0; h < 16; ++h) {
+            if (low_sets[h] == 0) {
+                continue;
+            }
+            unsigned c = 0;
+            while (c < num && classes[c] != low_sets[h]) {
+                ++c;
+            }
+            if (c == num) {
+                classes[num++] = low_sets[h];
+            }
+            uint8_t bit = uint8_t(1u << (c % 8));
+            hi[c / 8][h] |= bit;
+            for (unsigned l = 0; l < 16; ++l) {
+                if ((low_sets[h] >> l) & 1) {
+                    lo[c / 8][l] |= bit;
+                }
+            }
+        }
+        count = (num + 7) / 8;
+    }
+
+    SIMDPP_INL bool contains(uint8_t b) const
+    {
+        bool r = false;
+        for (unsigned t = 0; t < count; ++t) {
+            r |= (lo[t][b & 0xf] & hi[t][b >> 4]) != 0;
+        }
+        return r;
+    }
+};
+
+static SIMDPP_INL std::size_t find_any_of_scalar(const char* p, std::size_t i, std::size_t n,
+                                                 const find_any_of_lut& lut)
+{
+    for (; i < n; ++i) {
+        if (lut.contains(static_cast<uint8_t>(p[i]))) {
+            return i;
+        }
+    }
+    return n;
+}
+
+// Whether the byte permutations needed by the nibble lookup tables are available
+#if SIMDPP_USE_NULL || SIMDPP_USE_SSSE3 || SIMDPP_USE_NEON || SIMDPP_USE_ALTIVEC || SIMDPP_USE_MSA
+using find_any_of_is_vectorized = std::true_type;
+#else
+using find_any_of_is_vectorized = std::false_type;
+#endif
+
+// Loads a table of 16 bytes replicated to each 128-bit block of a vector
+static SIMDPP_INL mem_vector find_any_of_table(const uint8_t* t)
+{
+    SIMDPP_ALIGN(SIMDPP_FAST_INT8_SIZE) uint8_t buf[mem_vector_size];
+    for (std::size_t j = 0; j < mem_vector_size; ++j) {
+        buf[j] = t[j % 16];
+    }
+    return load(buf);
+}
+
+// Returns a vector whose bytes are nonzero where the bytes of v are in the set
+template<unsigned T> SIMDPP_INL
+mem_vector find_any_of_classify(const mem_vector& v, const mem_vector* lo_tbl,
+                                const mem_vector* hi_tbl)
+{
+    mem_vector nibble = make_uint(0x0f);
+    mem_vector lo = bit_and(v, nibble);
+    mem_vector hi = bit_and(mem_vector(shift_r<4>(uint16<mem_vector_size/2>(v))), nibble);
+    mem_vector r = bit_and(permute_bytes16(lo_tbl[0], lo), permute_bytes16(hi_tbl[0], hi));
+    if (T > 1) {
+        r = bit_or(r, bit_and(permute_bytes16(lo_tbl[1], lo), permute_bytes16(hi_tbl[1], hi)));
+    }
+    return r;
+}
+
+template<unsigned T> SIMDPP_INL
+std::size_t find_any_of_lut_impl(const char* p, std::size_t n, const find_any_of_lut& lut)
+{
+    const std::size_t L = mem_vector_size;
+    const uint64_t all = ~uint64_t(0) >> (64 - L);
+    mem_vector lo_tbl[2], hi_tbl[2];
+    for (unsigned t = 0; t < T; ++t) {
+        lo_tbl[t] = find_any_of_table(lut.lo[t]);
+        hi_tbl[t] = find_any_of_table(lut.hi[t]);
+    }
+    mem_vector zero = make_zero();
+
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        mem_vector v = load_u(p + i);
+        uint64_t found = ~mem_eq_bits(find_any_of_classify<T>(v, lo_tbl, hi_tbl), zero) & all;
+        if (found != 0) {
+            return i + bit_scan_forward(found);
+        }
+    }
+    if (i == n) {
+        return n;
+    }
+    if (n >= L) {
+        // The bytes before n - L are known not to match
+        i = n - L;
+        mem_vector v = load_u(p + i);
+        uint64_t found = ~mem_eq_bits(find_any_of_classify<T>(v, lo_tbl, hi_tbl), zero) & all;
+        if (found != 0) {
+            return i + bit_scan_forward(found);
+        }
+        return n;
+    }
+    return find_any_of_scalar(p, i, n, lut);
+}
+
+static SIMDPP_INL
+std::size_t find_any_of_vec(const char* p, std::size_t n, const uint8_t*, std::size_t,
+                            const find_any_of_lut& lut, std::true_type /*vectorized*/)
+{
+    if (lut.count == 1) {
+        return find_any_of_lut_impl<1>(p, n, lut);
+    }
+    return find_any_of_lut_impl<2>(p, n, lut);
+}
+
+/*  Without byte permutations, the bytes are compared with each element of
+    sets of up to 16 bytes.
+*/
+static SIMDPP_INL
+std::size_t find_any_of_vec(const char* p, std::size_t n, const uint8_t* set,
+                            std::size_t size, const find_any_of_lut& lut,
+                            std::false_type /*vectorized*/)
+{
+    const std::size_t L = mem_vector_size;
+    std::size_t i = 0;
+    if (size <= 16) {
+        mem_vector sv[16];
+        for (std::size_t k = 0; k < size; ++k) {
+            sv[k] = make_uint(set[k]);
+        }
+        for (; i + L <= n; i += L) {
+            mem_vector v = load_u(p + i);
+            uint64_t found = 0;
+            for (std::size_t k = 0; k < size; ++k) {
+                found |= mem_eq_bits(v, sv[k]);
+            }
+            if (found != 0) {
+                return i + bit_scan_forward(found);
+            }
+        }
+    }
+    return find_any_of_scalar(p, i, n, lut);
+}
+
+static SIMDPP_INL
+std::size_t find_any_of_impl(const char* p, std::size_t n, const uint8_t* set,
+                             std::size_t size)
+{
+    if (size == 0) {
+        return n;
+    }
+    if (size == 1) {
+        return find_byte_impl(p, n, set[0]);
+    }
+    find_any_of_lut lut(set, size);
+    return find_any_of_vec(p, n, set, size, lut, find_any_of_is_vectorized());
+}
+
+/*  Candidate positions are those where both the first and the last byte of
+    the needle match, which is checked for a vector of positions at a time.
+    Only the candidates are compared with the whole needle.
+*/
+static SIMDPP_INL
+std::size_t find_substring_impl(const char* p, std::size_t n, const char* needle,
+                                std::size_t m)
+{
+    const std::size_t L = mem_vector_size;
+    if (m == 0) {
+        return 0;
+    }
+    if (m > n) {
+        return n;
+    }
+    if (m == 1) {
+        return find_byte_impl(p, n, static_cast<uint8_t>(needle[0]));
+    }
+
+    // the number of positions at which the needle may start
+    const std::size_t P = n - m + 1;
+    mem_vector vf = make_uint(static_cast<uint8_t>(needle[0]));
+    mem_vector vl = make_uint(static_cast<uint8_t>(needle[m - 1]));
+
+    std::size_t i = 0;
+    for (; i + L <= P; i += L) {
+        mem_vector a = load_u(p + i);
+        mem_vector b = load_u(p + i + m - 1);
+        uint64_t cand = mem_eq_bits(a, vf) & mem_eq_bits(b, vl);
+        while (cand != 0) {
+            std::size_t pos = i + bit_scan_forward(cand);
+            if (std::memcmp(p + pos + 1, needle + 1, m - 2) == 0) {
+                return pos;
+            }
+            cand &= cand - 1;
+        }
+    }
+    if (i == P) {
+        return n;
+    }
+
+    if (P >= L) {
+        // Skip the positions before i that have already been checked
+        std::size_t base = P - L;
+        mem_vector a = load_u(p + base);
+        mem_vector b = load_u(p + base + m - 1);
+        uint64_t cand = mem_eq_bits(a, vf) & mem_eq_bits(b, vl);
+        cand &= ~uint64_t(0) << (i - base);
+        while (cand != 0) {
+            std::size_t pos = base + bit_scan_forward(cand);
+            if (std::memcmp(p + pos + 1, needle + 1, m - 2) == 0) {
+                return pos;
+            }
+            cand &= cand - 1;
+        }
+        return n;
+    }
+
+    for (; i < P; ++i) {
+        if (p[i] == needle[0] && p[i + m - 1] == needle[m - 1] &&
+                std::memcmp(p + i + 1, needle + 1, m - 2) == 0) {
+            return i;
+        }
+    }
+    return n;
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
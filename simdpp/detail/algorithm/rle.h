@@ -0,0 +1,160 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_RLE_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_RLE_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/cmp_neq.h>
+#include <simdpp/core/extract_bits.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/test_bits.h>
+#include <simdpp/detail/algorithm/bit_scan.h>
+#include <simdpp/detail/algorithm/scan.h>
+#include <simdpp/detail/mem_block.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+static const uint32_t rle_max_run = 0xffffffff;
+
+/*  Returns a bit mask whose i-th bit is set if the i-th element of @a ne is
+    nonzero. Byte vectors use extract_bits_any(), other vectors are
+    inspected element by element.
+*/
+template<class V> SIMDPP_INL
+uint64_t rle_boundary_bits(const V& ne)
+{
+    mem_block<V> b(ne);
+    uint64_t r = 0;
+    for (unsigned i = 0; i < V::length; ++i) {
+        r |= uint64_t(b[i] != 0) << i;
+    }
+    return r;
+}
+
+static SIMDPP_INL uint64_t rle_boundary_bits(const uint8<16>& ne)
+{
+    return extract_bits_any(ne);
+}
+
+static SIMDPP_INL uint64_t rle_boundary_bits(const uint8<32>& ne)
+{
+    return extract_bits_any(ne);
+}
+
+static SIMDPP_INL uint64_t rle_boundary_bits(const int8<16>& ne)
+{
+    return extract_bits_any(uint8<16>(ne));
+}
+
+static SIMDPP_INL uint64_t rle_boundary_bits(const int8<32>& ne)
+{
+    return extract_bits_any(uint8<32>(ne));
+}
+
+// Stores a run, splitting it if its length does not fit into 32 bits
+template<class T> SIMDPP_INL
+void rle_emit(T value, std::size_t len, T* values, uint32_t* runs, std::size_t& r)
+{
+    while (len > rle_max_run) {
+        values[r] = value;
+        runs[r++] = rle_max_run;
+        len -= rle_max_run;
+    }
+    values[r] = value;
+    runs[r++] = uint32_t(len);
+}
+
+/*  Each vector of elements is compared with the vector loaded one element
+    earlier. Vectors without run boundaries, which are common when runs are
+    long, are skipped with a single test.
+*/
+template<class T>
+std::size_t rle_encode(const T* in, std::size_t n, T* values, uint32_t* runs)
+{
+    using V = typename vector_for_element<T, scan_native_length<T>::value>::type;
+    const std::size_t L = V::length;
+    if (n == 0) {
+        return 0;
+    }
+
+    std::size_t r = 0;
+    std::size_t start = 0;
+    std::size_t i = 1;
+    for (; i + L <= n; i += L) {
+        V a = load_u(in + i);
+        V b = load_u(in + i - 1);
+        typename V::mask_vector_type ne = cmp_neq(a, b);
+        V vne = V(ne);
+        if (!test_bits_any(vne)) {
+            continue;
+        }
+        uint64_t bits = rle_boundary_bits(vne);
+        while (bits != 0) {
+            std::size_t pos = i + bit_scan_forward(bits);
+            rle_emit(in[start], pos - start, values, runs, r);
+            start = pos;
+            bits &= bits - 1;
+        }
+    }
+    for (; i < n; ++i) {
+        if (in[i] != in[i - 1]) {
+            rle_emit(in[start], i - start, values, runs, r);
+            start = i;
+        }
+    }
+    rle_emit(in[start], n - start, values, runs, r);
+    return r;
+}
+
+/*  Each run is filled with whole vectors. The last vector of a run may
+    write past its end; these elements are overwritten by the following
+    runs. Only the stores that would pass the end of the output are done
+    element by element.
+*/
+template<class T>
+std::size_t rle_decode(const T* values, const uint32_t* runs, std::size_t num_runs, T* out)
+{
+    using V = typename vector_for_element<T, scan_native_length<T>::value>::type;
+    const std::size_t L = V::length;
+
+    std::size_t total = 0;
+    for (std::size_t r = 0; r < num_runs; ++r) {
+        total += runs[r];
+    }
+
+    std::size_t p = 0;
+    for (std::size_t r = 0; r < num_runs; ++r) {
+        std::size_t len = runs[r];
+        V v = splat<V>(values[r]);
+        std::size_t j = 0;
+        for (; j < len && p + j + L <= total; j += L) {
+            store_u(out + p + j, v);
+        }
+        for (; j < len; ++j) {
+            out[p + j] = values[r];
+        }
+        p += len;
+    }
+    return total;
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,111 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_SCAN_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_SCAN_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/f_add.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/prefix_sum.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/traits.h>
+#include <cstddef>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+// The number of elements of type T in the native vector
+template<class T>
+struct scan_native_length : std::integral_constant<unsigned,
+    std::is_floating_point<T>::value ?
+        (sizeof(T) == 4 ? SIMDPP_FAST_FLOAT32_SIZE : SIMDPP_FAST_FLOAT64_SIZE) :
+    sizeof(T) == 1 ? SIMDPP_FAST_INT8_SIZE :
+    sizeof(T) == 2 ? SIMDPP_FAST_INT16_SIZE :
+    sizeof(T) == 4 ? SIMDPP_FAST_INT32_SIZE : SIMDPP_FAST_INT64_SIZE> {};
+
+/*  The total of the preceding elements is kept broadcast in a vector, so
+    that the dependency chain between consecutive vectors consists of a
+    single addition and a broadcast.
+*/
+template<class T>
+void inclusive_scan(const T* in, T* out, std::size_t n)
+{
+    using V = typename vector_for_element<T, scan_native_length<T>::value>::type;
+    const std::size_t L = V::length;
+
+    V carry = splat<V>(0);
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        V v = load_u(in + i);
+        v = add(prefix_sum(v), carry);
+        store_u(out + i, v);
+        carry = splat<L - 1>(v);
+    }
+    T c = i > 0 ? out[i - 1] : T(0);
+    for (; i < n; ++i) {
+        c += in[i];
+        out[i] = c;
+    }
+}
+
+/*  out[i] is the inclusive sum of the input moved by one element, thus each
+    output vector is computed from the input loaded at in + i - 1. The input
+    vector is loaded before the preceding results are stored, so that @a in
+    may be equal to @a out.
+*/
+template<class T>
+void exclusive_scan(const T* in, T* out, std::size_t n, T init)
+{
+    using V = typename vector_for_element<T, scan_native_length<T>::value>::type;
+    const std::size_t L = V::length;
+
+    if (n == 0) {
+        return;
+    }
+    T x = in[0];
+    std::size_t i = 1;
+    if (i + L <= n) {
+        V carry = splat<V>(init);
+        V y = load_u(in);
+        for (;;) {
+            V v = add(prefix_sum(y), carry);
+            carry = splat<L - 1>(v);
+            if (i + 2 * L > n) {
+                x = in[i + L - 1];
+                store_u(out + i, v);
+                i += L;
+                break;
+            }
+            y = load_u(in + i + L - 1);
+            store_u(out + i, v);
+            i += L;
+        }
+    }
+    out[0] = init;
+    T c = out[i - 1];
+    for (; i < n; ++i) {
+        T t = in[i];
+        c += x;
+        out[i] = c;
+        x = t;
+    }
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
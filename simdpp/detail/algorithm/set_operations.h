@@ -0,0 +1,346 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_SET_OPERATIONS_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_SET_OPERATIONS_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_not.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/cmp_neq.h>
+#include <simdpp/core/load_splat.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/detail/algorithm/compress.h>
+#include <simdpp/detail/algorithm/sort.h>
+#include <simdpp/detail/get_expr.h>
+#include <algorithm>
+#include <cstddef>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+// If one input is this many times larger than the other, the intersection
+// searches the elements of the smaller input in the larger one.
+static const std::size_t set_gallop_ratio = 32;
+
+/*  Returns a mask that selects the elements of @a va that are equal to any of
+    the @a n elements at @a b, 0 < n <= L. Each element of @a b is broadcast
+    and compared against all elements of @a va.
+*/
+template<class U> SIMDPP_INL
+typename U::mask_vector_type set_match_any(const U& va,
+                                           const typename U::element_type* b,
+                                           std::size_t n)
+{
+    using M = typename U::mask_vector_type;
+    M m = cmp_eq(va, load_splat<U>(b));
+    for (std::size_t k = 1; k < n; ++k) {
+        m = bit_or(m, cmp_eq(va, load_splat<U>(b + k)));
+    }
+    return m;
+}
+
+// Returns the first position in [first, last) whose element is not less than x
+template<class T> SIMDPP_INL
+const T* set_gallop(const T* first, const T* last, T x)
+{
+    std::size_t step = 1;
+    while (step < std::size_t(last - first) && first[step] < x) {
+        first += step;
+        step *= 2;
+    }
+    const T* end = step < std::size_t(last - first) ? first + step + 1 : last;
+    return std::lower_bound(first, end, x);
+}
+
+template<class T>
+std::size_t set_intersect_scalar(const T* a, std::size_t na,
+                                 const T* b, std::size_t nb, T* out)
+{
+    std::size_t i = 0, j = 0, c = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            out[c++] = a[i];
+            i++;
+            j++;
+        }
+    }
+    return c;
+}
+
+// Intersects a small input @a a with a much larger input @a b
+template<class T>
+std::size_t set_intersect_gallop(const T* a, std::size_t na,
+                                 const T* b, std::size_t nb, T* out)
+{
+    const T* pb = b;
+    const T* eb = b + nb;
+    std::size_t c = 0;
+    for (std::size_t i = 0; i < na && pb != eb; ++i) {
+        pb = set_gallop(pb, eb, a[i]);
+        if (pb != eb && !(a[i] < *pb)) {
+            out[c++] = a[i];
+        }
+    }
+    return c;
+}
+
+/*  Compares a block of L elements of @a a with up to L elements of @a b.
+    The block with the smaller last element is advanced, thus each element
+    of @a a is compared with all elements of @a b that may be equal to it.
+*/
+template<class T>
+std::size_t set_intersect(const T* a, std::size_t na,
+                          const T* b, std::size_t nb, T* out)
+{
+    if (na > nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (na * set_gallop_ratio < nb) {
+        return set_intersect_gallop(a, na, b, nb, out);
+    }
+
+    using T2 = typename std::make_unsigned<T>::type;
+    using U = typename vector_for_element<T2, sort_native_length<T>::value>::type;
+    const std::size_t L = U::length;
+    const T2* ua = reinterpret_cast<const T2*>(a);
+    const T2* ub = reinterpret_cast<const T2*>(b);
+
+    std::size_t i = 0, j = 0, c = 0;
+    while (i + L <= na && j < nb) {
+        std::size_t nbl = std::min(L, nb - j);
+        U va = load_u(ua + i);
+        c += compress_store(reinterpret_cast<T2*>(out) + c, va,
+                            set_match_any(va, ub + j, nbl));
+        T amax = a[i + L - 1];
+        T bmax = b[j + nbl - 1];
+        if (!(bmax < amax)) {
+            i += L;
+        }
+        if (!(amax < bmax)) {
+            j += nbl;
+        }
+    }
+    return c + set_intersect_scalar(a + i, na - i, b + j, nb - j, out + c);
+}
+
+template<class T>
+std::size_t set_difference_scalar(const T* a, std::size_t na,
+                                  const T* b, std::size_t nb, T* out)
+{
+    std::size_t i = 0, j = 0, c = 0;
+    while (i < na) {
+        if (j == nb || a[i] < b[j]) {
+            out[c++] = a[i++];
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            i++;
+            j++;
+        }
+    }
+    return c;
+}
+
+/*  Each block of L elements of @a a is compared with the blocks of @a b that
+    may contain equal elements and the elements that did not match any of
+    them are stored.
+*/
+template<class T>
+std::size_t set_difference(const T* a, std::size_t na,
+                           const T* b, std::size_t nb, T* out)
+{
+    using T2 = typename std::make_unsigned<T>::type;
+    using U = typename vector_for_element<T2, sort_native_length<T>::value>::type;
+    using M = typename U::mask_vector_type;
+    const std::size_t L = U::length;
+    const T2* ua = reinterpret_cast<const T2*>(a);
+    const T2* ub = reinterpret_cast<const T2*>(b);
+
+    std::size_t i = 0, j = 0, c = 0;
+    for (; i + L <= na && j < nb; i += L) {
+        U va = load_u(ua + i);
+        T amax = a[i + L - 1];
+        std::size_t nbl = std::min(L, nb - j);
+        M m = set_match_any(va, ub + j, nbl);
+        while (!(amax < b[j + nbl - 1])) {
+            j += nbl;
+            if (j == nb) {
+                break;
+            }
+            nbl = std::min(L, nb - j);
+            m = bit_or(m, set_match_any(va, ub + j, nbl));
+        }
+        M nm = bit_not(m);
+        c += compress_store(reinterpret_cast<T2*>(out) + c, va, nm);
+    }
+    return c + set_difference_scalar(a + i, na - i, b + j, nb - j, out + c);
+}
+
+/*  Stores the merged elements of the sorted vector @a v. If Unique is set,
+    the elements equal to the preceding one are skipped. @a last holds the
+    last stored element, @a has_last is false if nothing was stored yet.
+*/
+template<class V, class T> SIMDPP_INL
+void set_emit(T* out, std::size_t& c, const V& v, T& last, bool& has_last,
+              std::false_type /*Unique*/)
+{
+    store_u(out + c, v);
+    c += V::length;
+    (void) last; (void) has_last;
+}
+
+template<class V, class T> SIMDPP_INL
+void set_emit(T* out, std::size_t& c, const V& v, T& last, bool& has_last,
+              std::true_type /*Unique*/)
+{
+    using T2 = typename std::make_unsigned<T>::type;
+    using U = typename get_expr_nosign<V>::type;
+    const unsigned L = V::length;
+
+    // prev[i] = v[i-1], prev[0] = last
+    T2 buf[L * 2];
+    U u = U(v);
+    store_u(buf + L, u);
+    buf[L - 1] = has_last ? T2(last) : T2(~buf[L]);
+    U prev = load_u(buf + L - 1);
+
+    typename U::mask_vector_type m = cmp_neq(u, prev);
+    c += compress_store(reinterpret_cast<T2*>(out) + c, u, m);
+    last = T(buf[L * 2 - 1]);
+    has_last = true;
+}
+
+template<class T, bool Unique>
+std::size_t set_merge_scalar(const T* a, std::size_t na,
+                             const T* b, std::size_t nb, T* out,
+                             T last, bool has_last)
+{
+    std::size_t i = 0, j = 0, c = 0;
+    while (i < na || j < nb) {
+        T x;
+        if (j == nb || (i < na && !(b[j] < a[i]))) {
+            x = a[i++];
+        } else {
+            x = b[j++];
+        }
+        if (!Unique || !has_last || last < x) {
+            out[c++] = x;
+            last = x;
+            has_last = true;
+        }
+    }
+    return c;
+}
+
+/*  Merges two sorted inputs. The next block of L elements is taken from the
+    input whose next element is smaller and merged with the L largest
+    elements seen so far using a bitonic merging network. The smaller half of
+    the result is final.
+*/
+template<bool Unique, class T>
+std::size_t set_merge(const T* a, std::size_t na,
+                      const T* b, std::size_t nb, T* out, std::true_type)
+{
+    using V = sort_vector<T>;
+    const std::size_t L = V::length;
+    using Uniq = std::integral_constant<bool, Unique>;
+
+    T last = T();
+    bool has_last = false;
+    if (na < L || nb < L) {
+        return set_merge_scalar<T, Unique>(a, na, b, nb, out, last, has_last);
+    }
+
+    V lo = load_u(a);
+    V hi = load_u(b);
+    std::size_t i = L, j = L, c = 0;
+    sort_bitonic_merge2(lo, hi);
+    set_emit(out, c, lo, last, has_last, Uniq());
+
+    for (;;) {
+        if (i < na && (j == nb || !(b[j] < a[i]))) {
+            if (i + L > na) {
+                break;
+            }
+            lo = load_u(a + i);
+            i += L;
+        } else {
+            if (j + L > nb) {
+                break;
+            }
+            lo = load_u(b + j);
+            j += L;
+        }
+        sort_bitonic_merge2(lo, hi);
+        set_emit(out, c, lo, last, has_last, Uniq());
+    }
+
+    // Merge the remaining elements of both inputs with the L elements in hi
+    T rest[L];
+    store_u(rest, hi);
+    std::size_t k = 0;
+    while (k < L) {
+        T x = rest[k];
+        unsigned src = 0;
+        if (i < na && a[i] < x) {
+            x = a[i];
+            src = 1;
+        }
+        if (j < nb && b[j] < x) {
+            x = b[j];
+            src = 2;
+        }
+        if (src == 0) {
+            k++;
+        } else if (src == 1) {
+            i++;
+        } else {
+            j++;
+        }
+        if (!Unique || !has_last || last < x) {
+            out[c++] = x;
+            last = x;
+            has_last = true;
+        }
+    }
+    return c + set_merge_scalar<T, Unique>(a + i, na - i, b + j, nb - j,
+                                           out + c, last, has_last);
+}
+
+// Used when min and max are not available for the element type
+template<bool Unique, class T>
+std::size_t set_merge(const T* a, std::size_t na,
+                      const T* b, std::size_t nb, T* out, std::false_type)
+{
+    return set_merge_scalar<T, Unique>(a, na, b, nb, out, T(), false);
+}
+
+template<bool Unique, class T> SIMDPP_INL
+std::size_t set_merge(const T* a, std::size_t na,
+                      const T* b, std::size_t nb, T* out)
+{
+    return set_merge<Unique>(a, na, b, nb, out, sort_is_vectorized<T>());
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
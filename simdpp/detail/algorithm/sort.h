@@ -0,0 +1,544 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_SORT_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_SORT_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/blend.h>
+#include <simdpp/core/cmp_le.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/f_max.h>
+#include <simdpp/core/f_min.h>
+#include <simdpp/core/i_max.h>
+#include <simdpp/core/i_min.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/permute2.h>
+#include <simdpp/core/permute4.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/store.h>
+#include <simdpp/detail/algorithm/bit_scan.h>
+#include <simdpp/detail/algorithm/compress.h>
+#include <simdpp/detail/get_expr.h>
+#include <simdpp/detail/insn/shuffle128.h>
+#include <simdpp/detail/mem_block.h>
+#include <simdpp/detail/traits.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+// The number of elements of type T in the native vector
+template<class T>
+struct sort_native_length : std::integral_constant<unsigned,
+    std::is_floating_point<T>::value ?
+        (sizeof(T) == 4 ? SIMDPP_FAST_FLOAT32_SIZE : SIMDPP_FAST_FLOAT64_SIZE) :
+        (sizeof(T) == 4 ? SIMDPP_FAST_INT32_SIZE : SIMDPP_FAST_INT64_SIZE)> {};
+
+template<class T>
+using sort_vector = typename vector_for_element<T, sort_native_length<T>::value>::type;
+
+// Whether the vectorized sort can be used for elements of type T. Ordered
+// comparisons, min and max are not available for 64-bit integer vectors on
+// some instruction sets.
+template<class T>
+struct sort_is_vectorized : std::integral_constant<bool,
+#if SIMDPP_USE_NULL || SIMDPP_USE_AVX2 || SIMDPP_USE_NEON64 || SIMDPP_USE_ALTIVEC || SIMDPP_USE_MSA
+    true
+#else
+    std::is_floating_point<T>::value || sizeof(T) == 4
+#endif
+    > {};
+
+// -----------------------------------------------------------------------------
+// Swaps the elements at distance D within a single native vector, that is,
+// returns r[i] = a[i ^ D]
+
+template<class V> SIMDPP_INL
+V sort_swap128(const any_vec<32,V>& a)
+{
+    using U = typename get_expr_nosign<V>::type;
+    U u = a.wrapped();
+    return V(shuffle1_128<1,0>(u, u));
+}
+
+#if SIMDPP_USE_AVX512F
+template<class V> SIMDPP_INL
+V sort_swap128(const any_vec<64,V>& a)
+{
+    using U = typename get_expr_nosign<V>::type;
+    U u = a.wrapped();
+    return V(permute4_128<1,0,3,2>(u));
+}
+
+template<class V> SIMDPP_INL
+V sort_swap256(const any_vec<64,V>& a)
+{
+    using U = typename get_expr_nosign<V>::type;
+    U u = a.wrapped();
+    return V(permute4_128<2,3,0,1>(u));
+}
+#endif
+
+template<unsigned DistBytes, unsigned ElemBytes> struct sort_swap_impl;
+
+template<> struct sort_swap_impl<4,4> {
+    template<class V> static SIMDPP_INL V run(const V& a) { return permute4<1,0,3,2>(a); }
+};
+template<> struct sort_swap_impl<8,4> {
+    template<class V> static SIMDPP_INL V run(const V& a) { return permute4<2,3,0,1>(a); }
+};
+template<> struct sort_swap_impl<8,8> {
+    template<class V> static SIMDPP_INL V run(const V& a) { return permute2<1,0>(a); }
+};
+template<unsigned E> struct sort_swap_impl<16,E> {
+    template<class V> static SIMDPP_INL V run(const V& a) { return sort_swap128(a); }
+};
+#if SIMDPP_USE_AVX512F
+template<unsigned E> struct sort_swap_impl<32,E> {
+    template<class V> static SIMDPP_INL V run(const V& a) { return sort_swap256(a); }
+};
+#endif
+
+template<unsigned D, class V> SIMDPP_INL
+V sort_swap(const V& a)
+{
+    using E = typename V::element_type;
+    return sort_swap_impl<D * sizeof(E), sizeof(E)>::run(a);
+}
+
+// Reverses the order of elements within each group of S elements
+template<unsigned S> struct sort_reverse_impl {
+    template<class V> static SIMDPP_INL
+    V run(const V& a) { return sort_reverse_impl<S/2>::run(sort_swap<S/2>(a)); }
+};
+template<> struct sort_reverse_impl<1> {
+    template<class V> static SIMDPP_INL
+    V run(const V& a) { return a; }
+};
+
+template<unsigned S, class V> SIMDPP_INL
+V sort_reverse(const V& a)
+{
+    return sort_reverse_impl<S>::run(a);
+}
+
+// Returns a mask that selects the elements whose index has the bit D set
+template<unsigned D> struct sort_upper_mask;
+
+template<> struct sort_upper_mask<1> {
+    template<class M> static SIMDPP_INL M make()
+    {
+        return make_uint(0, ~uint64_t(0));
+    }
+};
+template<> struct sort_upper_mask<2> {
+    template<class M> static SIMDPP_INL M make()
+    {
+        return make_uint(0, 0, ~uint64_t(0), ~uint64_t(0));
+    }
+};
+template<> struct sort_upper_mask<4> {
+    template<class M> static SIMDPP_INL M make()
+    {
+        const uint64_t o = ~uint64_t(0);
+        return make_uint(0, 0, 0, 0, o, o, o, o);
+    }
+};
+template<> struct sort_upper_mask<8> {
+    template<class M> static SIMDPP_INL M make()
+    {
+        const uint64_t o = ~uint64_t(0);
+        return make_uint(0, 0, 0, 0, 0, 0, 0, 0, o, o, o, o, o, o, o, o);
+    }
+};
+
+/*  Compare-exchanges the elements of @a a with the corresponding elements of
+    @a partner, which contains the elements of @a a permuted so that the
+    partner of each element whose index has the bit D clear has that bit set.
+    The smaller values are placed to the former positions.
+*/
+template<unsigned D, class V> SIMDPP_INL
+void sort_cmpx_inner(V& a, const V& partner)
+{
+    using E = typename V::element_type;
+    using M = typename vector_for_element<E, V::length, sizeof(E), false, false>::type;
+    V mn = min(a, partner);
+    V mx = max(a, partner);
+    a = blend(mx, mn, sort_upper_mask<D>::template make<M>());
+}
+
+template<class V> SIMDPP_INL
+void sort_cmpx(V& a, V& b)
+{
+    V mn = min(a, b);
+    b = max(a, b);
+    a = mn;
+}
+
+// -----------------------------------------------------------------------------
+// Bitonic sorting network on an array of M native vectors, which are treated
+// as a single sequence of M * L elements. Each merge stage of size S first
+// compares the element i with i ^ (S - 1) and then runs half-cleaners of
+// decreasing distance, thus all compare-exchanges are ascending.
+
+template<unsigned S, unsigned M, class V> SIMDPP_INL
+void sort_mirror(V (&a)[M], std::true_type /*within vector*/)
+{
+    for (unsigned j = 0; j < M; ++j) {
+        sort_cmpx_inner<S/2>(a[j], sort_reverse<S>(a[j]));
+    }
+}
+
+template<unsigned S, unsigned M, class V> SIMDPP_INL
+void sort_mirror(V (&a)[M], std::false_type /*across vectors*/)
+{
+    const unsigned G = S / V::length;
+    for (unsigned j = 0; j < M; ++j) {
+        if ((j & (G/2)) != 0) {
+            continue;
+        }
+        unsigned k = j ^ (G - 1);
+        V r = sort_reverse<V::length>(a[k]);
+        V mn = min(a[j], r);
+        V mx = max(a[j], r);
+        a[j] = mn;
+        a[k] = sort_reverse<V::length>(mx);
+    }
+}
+
+template<unsigned D, unsigned M, class V> SIMDPP_INL
+void sort_half_clean_step(V (&a)[M], std::true_type /*within vector*/)
+{
+    for (unsigned j = 0; j < M; ++j) {
+        sort_cmpx_inner<D>(a[j], sort_swap<D>(a[j]));
+    }
+}
+
+template<unsigned D, unsigned M, class V> SIMDPP_INL
+void sort_half_clean_step(V (&a)[M], std::false_type /*across vectors*/)
+{
+    const unsigned G = D / V::length;
+    for (unsigned j = 0; j < M; ++j) {
+        if ((j & G) == 0) {
+            sort_cmpx(a[j], a[j + G]);
+        }
+    }
+}
+
+template<unsigned D> struct sort_half_clean {
+    template<unsigned M, class V> static SIMDPP_INL
+    void run(V (&a)[M])
+    {
+        sort_half_clean_step<D>(a, std::integral_constant<bool, (D < V::length)>());
+        sort_half_clean<D/2>::run(a);
+    }
+};
+
+template<> struct sort_half_clean<0> {
+    template<unsigned M, class V> static SIMDPP_INL
+    void run(V (&)[M]) {}
+};
+
+// Merges two sorted sequences of S/2 elements within each group of S elements
+template<unsigned S, unsigned M, class V> SIMDPP_INL
+void sort_merge_stage(V (&a)[M])
+{
+    sort_mirror<S>(a, std::integral_constant<bool, (S <= V::length)>());
+    sort_half_clean<S/4>::run(a);
+}
+
+template<unsigned S, unsigned Total, bool Done = (S > Total)>
+struct sort_bitonic_impl {
+    template<unsigned M, class V> static SIMDPP_INL
+    void run(V (&a)[M])
+    {
+        sort_merge_stage<S>(a);
+        sort_bitonic_impl<S*2, Total>::run(a);
+    }
+};
+
+template<unsigned S, unsigned Total> struct sort_bitonic_impl<S, Total, true> {
+    template<unsigned M, class V> static SIMDPP_INL
+    void run(V (&)[M]) {}
+};
+
+// Sorts the M * L elements of the given native vectors
+template<unsigned M, class V> SIMDPP_INL
+void sort_bitonic(V (&a)[M])
+{
+    sort_bitonic_impl<2, M * V::length>::run(a);
+}
+
+/*  Merges two sorted vectors of arbitrary width. The smaller half of the
+    elements is stored to @a a, the larger half to @a b.
+*/
+template<class V> SIMDPP_INL
+void sort_bitonic_merge2(V& a, V& b)
+{
+    using B = typename V::base_vector_type;
+    const unsigned C = V::vec_length;
+
+    B v[C * 2];
+    for (unsigned i = 0; i < C; ++i) {
+        v[i] = a.vec(i);
+        v[C + i] = b.vec(i);
+    }
+    sort_merge_stage<V::length * 2>(v);
+    for (unsigned i = 0; i < C; ++i) {
+        a.vec(i) = v[i];
+        b.vec(i) = v[C + i];
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Sorting of arrays
+
+template<class T>
+T sort_padding_value(std::true_type /*floating-point*/)
+{
+    return std::numeric_limits<T>::infinity();
+}
+
+template<class T>
+T sort_padding_value(std::false_type /*integer*/)
+{
+    return std::numeric_limits<T>::max();
+}
+
+// Sorts n <= M * L elements using a bitonic network
+template<class T, unsigned M> SIMDPP_INL
+void sort_small_impl(T* p, std::size_t n)
+{
+    using V = sort_vector<T>;
+    const unsigned L = V::length;
+
+    SIMDPP_ALIGN(64) T buf[M * L];
+    std::memcpy(buf, p, n * sizeof(T));
+    T pad = sort_padding_value<T>(std::is_floating_point<T>());
+    for (std::size_t i = n; i < M * L; ++i) {
+        buf[i] = pad;
+    }
+
+    V v[M];
+    for (unsigned j = 0; j < M; ++j) {
+        v[j] = load(buf + j * L);
+    }
+    sort_bitonic(v);
+    for (unsigned j = 0; j < M; ++j) {
+        store(buf + j * L, v[j]);
+    }
+    std::memcpy(p, buf, n * sizeof(T));
+}
+
+template<class T>
+void sort_small(T* p, std::size_t n)
+{
+    const std::size_t L = sort_vector<T>::length;
+    if (n <= 1) {
+        return;
+    }
+    if (n <= L) {
+        sort_small_impl<T, 1>(p, n);
+    } else if (n <= L * 2) {
+        sort_small_impl<T, 2>(p, n);
+    } else if (n <= L * 4) {
+        sort_small_impl<T, 4>(p, n);
+    } else if (n <= L * 8) {
+        sort_small_impl<T, 8>(p, n);
+    } else {
+        sort_small_impl<T, 16>(p, n);
+    }
+}
+
+static const unsigned sort_small_vectors = 16;
+
+/*  Writes the elements of @a v that satisfy the partition predicate to the
+    left write position and the rest to the right write position, which
+    moves downwards.
+*/
+#if SIMDPP_USE_AVX512F
+template<class V> SIMDPP_INL
+typename V::mask_vector_type sort_partition_mask(const V& v, const V& pivot,
+                                                 std::true_type /*strict*/)
+{
+    return cmp_lt(v, pivot);
+}
+
+template<class V> SIMDPP_INL
+typename V::mask_vector_type sort_partition_mask(const V& v, const V& pivot,
+                                                 std::false_type /*strict*/)
+{
+    return cmp_le(v, pivot);
+}
+
+template<bool Strict, class T, class V> SIMDPP_INL
+void sort_partition_vec(T* p, std::size_t& wl, std::size_t& wr,
+                        const V& v, const V& vpivot, T)
+{
+    using U = typename get_expr_nosign<V>::type;
+    typename V::mask_vector_type m = sort_partition_mask(v, vpivot,
+                                        std::integral_constant<bool, Strict>());
+    auto k = m.native();
+    unsigned c = bit_popcount(k);
+    compress_store_k(p + wl, k, U(v));
+    wl += c;
+    wr -= V::length - c;
+    compress_store_k(p + wr, static_cast<decltype(k)>(~k), U(v));
+}
+#else
+template<bool Strict, class T, class V> SIMDPP_INL
+void sort_partition_vec(T* p, std::size_t& wl, std::size_t& wr,
+                        const V& v, const V&, T pivot)
+{
+    // Both write positions are known to be free, thus each element is
+    // written to both and only the corresponding position is advanced.
+    mem_block<V> b(v);
+    for (unsigned i = 0; i < V::length; ++i) {
+        T x = b[i];
+        bool left = Strict ? (x < pivot) : !(pivot < x);
+        p[wl] = x;
+        p[wr - 1] = x;
+        wl += left;
+        wr -= !left;
+    }
+}
+#endif
+
+/*  Partitions the n >= 2 * L elements at @a p so that the elements less than
+    (if Strict) or not greater than (otherwise) @a pivot precede the rest.
+    Returns the number of elements in the first part.
+
+    The first and the last vector are loaded up front, which leaves one
+    vector of free space at each end. Each subsequent vector is read from the
+    side with less free space and its elements are written to both ends, so
+    that no unread element is ever overwritten.
+*/
+template<bool Strict, class T>
+std::size_t sort_partition(T* p, std::size_t n, T pivot)
+{
+    using V = sort_vector<T>;
+    const std::size_t L = V::length;
+    V vp = splat(pivot);
+
+    V first = load_u(p);
+    V last = load_u(p + n - L);
+    std::size_t l = L, r = n - L;
+    std::size_t wl = 0, wr = n;
+
+    while (r - l >= L) {
+        V v;
+        if (l - wl <= wr - r) {
+            v = load_u(p + l);
+            l += L;
+        } else {
+            r -= L;
+            v = load_u(p + r);
+        }
+        sort_partition_vec<Strict>(p, wl, wr, v, vp, pivot);
+    }
+
+    // The rest of the unread elements are saved, thus [wl, wr) is free
+    T tail[sort_native_length<T>::value];
+    std::size_t t = r - l;
+    std::memcpy(tail, p + l, t * sizeof(T));
+    for (std::size_t i = 0; i < t; ++i) {
+        T x = tail[i];
+        bool left = Strict ? (x < pivot) : !(pivot < x);
+        if (left) {
+            p[wl++] = x;
+        } else {
+            p[--wr] = x;
+        }
+    }
+    sort_partition_vec<Strict>(p, wl, wr, first, vp, pivot);
+    sort_partition_vec<Strict>(p, wl, wr, last, vp, pivot);
+    return wl;
+}
+
+template<class T> SIMDPP_INL
+T sort_median3(T a, T b, T c)
+{
+    if (b < a) std::swap(a, b);
+    if (c < b) std::swap(b, c);
+    if (b < a) std::swap(a, b);
+    return b;
+}
+
+template<class T>
+void sort_impl(T* p, std::size_t n, unsigned depth)
+{
+    const std::size_t small = sort_small_vectors * sort_vector<T>::length;
+
+    while (n > small) {
+        if (depth == 0) {
+            std::sort(p, p + n);
+            return;
+        }
+        depth--;
+
+        T pivot = sort_median3(p[0], p[n/2], p[n-1]);
+        std::size_t k = sort_partition<true>(p, n, pivot);
+        if (k == 0) {
+            // The pivot is the smallest element. Separate all elements equal
+            // to it, which need no further sorting.
+            k = sort_partition<false>(p, n, pivot);
+            p += k;
+            n -= k;
+            continue;
+        }
+
+        if (k < n - k) {
+            sort_impl(p, k, depth);
+            p += k;
+            n -= k;
+        } else {
+            sort_impl(p + k, n - k, depth);
+            n = k;
+        }
+    }
+    sort_small(p, n);
+}
+
+template<class T>
+void sort_array(T* p, std::size_t n, std::true_type)
+{
+    unsigned depth = 0;
+    for (std::size_t i = n; i > 1; i >>= 1) {
+        depth += 2;
+    }
+    sort_impl(p, n, depth);
+}
+
+template<class T>
+void sort_array(T* p, std::size_t n, std::false_type)
+{
+    std::sort(p, p + n);
+}
+
+template<class T> SIMDPP_INL
+void sort_array(T* p, std::size_t n)
+{
+    sort_array(p, n, sort_is_vectorized<T>());
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
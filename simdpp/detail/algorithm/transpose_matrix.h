@@ -0,0 +1,218 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_TRANSPOSE_MATRIX_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_TRANSPOSE_MATRIX_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/cache.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/stream.h>
+#include <simdpp/core/transpose.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+/*  Describes the register-sized block that is transposed at once for elements
+    of the given size. K is the number of rows and columns in the block and
+    tile is the number of rows and columns in the cache-sized tile the matrix
+    is split into. The tiles are sized so that the source and destination
+    parts of a tile take 4-8 KiB each and thus stay in L1 while the tile is
+    being processed.
+*/
+template<unsigned Size> struct transpose_matrix_block;
+
+template<> struct transpose_matrix_block<1> {
+    using V = uint8<16>;
+    static const unsigned K = 16;
+    static const unsigned tile = 64;
+
+    static SIMDPP_INL void transpose(V (&a)[16])
+    {
+        transpose16(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7],
+                    a[8], a[9], a[10], a[11], a[12], a[13], a[14], a[15]);
+    }
+};
+
+template<> struct transpose_matrix_block<2> {
+    using V = uint16<8>;
+    static const unsigned K = 8;
+    static const unsigned tile = 64;
+
+    static SIMDPP_INL void transpose(V (&a)[8])
+    {
+        transpose8(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+    }
+};
+
+#if SIMDPP_USE_AVX2 || SIMDPP_USE_AVX512F
+template<> struct transpose_matrix_block<4> {
+    using V = uint32<8>;
+    static const unsigned K = 8;
+    static const unsigned tile = 32;
+
+    static SIMDPP_INL void transpose(V (&a)[8])
+    {
+        transpose8(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+    }
+};
+#else
+template<> struct transpose_matrix_block<4> {
+    using V = uint32<4>;
+    static const unsigned K = 4;
+    static const unsigned tile = 32;
+
+    static SIMDPP_INL void transpose(V (&a)[4])
+    {
+        transpose4(a[0], a[1], a[2], a[3]);
+    }
+};
+#endif
+
+#if SIMDPP_USE_AVX512F
+template<> struct transpose_matrix_block<8> {
+    using V = uint64<8>;
+    static const unsigned K = 8;
+    static const unsigned tile = 32;
+
+    static SIMDPP_INL void transpose(V (&a)[8])
+    {
+        transpose8(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+    }
+};
+#else
+template<> struct transpose_matrix_block<8> {
+    using V = uint64<2>;
+    static const unsigned K = 2;
+    static const unsigned tile = 32;
+
+    static SIMDPP_INL void transpose(V (&a)[2])
+    {
+        transpose2(a[0], a[1]);
+    }
+};
+#endif
+
+template<class T> SIMDPP_INL
+void transpose_matrix_scalar(const T* src, T* dst,
+                             std::size_t r0, std::size_t r1,
+                             std::size_t c0, std::size_t c1,
+                             std::size_t src_stride, std::size_t dst_stride)
+{
+    for (std::size_t r = r0; r < r1; ++r) {
+        for (std::size_t c = c0; c < c1; ++c) {
+            dst[c * dst_stride + r] = src[r * src_stride + c];
+        }
+    }
+}
+
+template<class T> SIMDPP_INL
+void transpose_matrix_prefetch_tile(const T* src, T* dst,
+                                    std::size_t r0, std::size_t r1,
+                                    std::size_t c0, std::size_t c1,
+                                    std::size_t src_stride, std::size_t dst_stride,
+                                    bool prefetch_dst)
+{
+    const std::size_t line = 64 / sizeof(T);
+    for (std::size_t r = r0; r < r1; ++r) {
+        for (std::size_t c = c0; c < c1; c += line) {
+            prefetch_read(src + r * src_stride + c);
+        }
+    }
+    if (prefetch_dst) {
+        for (std::size_t c = c0; c < c1; ++c) {
+            for (std::size_t r = r0; r < r1; r += line) {
+                prefetch_write(dst + c * dst_stride + r);
+            }
+        }
+    }
+}
+
+template<class T, bool Stream>
+void transpose_matrix_impl(const T* src, T* dst,
+                           std::size_t rows, std::size_t cols,
+                           std::size_t src_stride, std::size_t dst_stride)
+{
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+                  "Only 8, 16, 32 and 64-bit elements are supported");
+    using Block = transpose_matrix_block<sizeof(T)>;
+    using V = typename Block::V;
+    const std::size_t K = Block::K;
+    const std::size_t S = Block::tile;
+
+    // Non-temporal stores require each destination block row to be aligned
+    bool use_stream = Stream &&
+        reinterpret_cast<std::uintptr_t>(dst) % V::length_bytes == 0 &&
+        (dst_stride * sizeof(T)) % V::length_bytes == 0;
+
+    for (std::size_t ti = 0; ti < rows; ti += S) {
+        std::size_t rend = ti + S < rows ? ti + S : rows;
+
+        for (std::size_t tj = 0; tj < cols; tj += S) {
+            std::size_t cend = tj + S < cols ? tj + S : cols;
+
+            // fetch the next tile while the current one is being transposed
+            std::size_t nj = tj + S;
+            std::size_t ni = ti;
+            if (nj >= cols) {
+                nj = 0;
+                ni = ti + S;
+            }
+            if (ni < rows) {
+                std::size_t nrend = ni + S < rows ? ni + S : rows;
+                std::size_t ncend = nj + S < cols ? nj + S : cols;
+                transpose_matrix_prefetch_tile(src, dst, ni, nrend, nj, ncend,
+                                               src_stride, dst_stride, !use_stream);
+            }
+
+            std::size_t r = ti;
+            for (; r + K <= rend; r += K) {
+                std::size_t c = tj;
+                for (; c + K <= cend; c += K) {
+                    V a[Block::K];
+                    for (unsigned i = 0; i < K; ++i) {
+                        a[i] = load_u(src + (r + i) * src_stride + c);
+                    }
+                    Block::transpose(a);
+                    if (use_stream) {
+                        for (unsigned i = 0; i < K; ++i) {
+                            stream(dst + (c + i) * dst_stride + r, a[i]);
+                        }
+                    } else {
+                        for (unsigned i = 0; i < K; ++i) {
+                            store_u(dst + (c + i) * dst_stride + r, a[i]);
+                        }
+                    }
+                }
+                transpose_matrix_scalar(src, dst, r, r + K, c, cend,
+                                        src_stride, dst_stride);
+            }
+            transpose_matrix_scalar(src, dst, r, rend, tj, cend,
+                                    src_stride, dst_stride);
+        }
+    }
+
+    if (use_stream) {
+        // make the non-temporal stores globally visible before returning
+        stream_fence();
+    }
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,549 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_UTF8_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_UTF8_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/bit_xor.h>
+#include <simdpp/core/blend.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/cmp_ge.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/cmp_neq.h>
+#include <simdpp/core/combine.h>
+#include <simdpp/core/extract_bits.h>
+#include <simdpp/core/i_shift_l.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/i_sub_sat.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/move_r.h>
+#include <simdpp/core/permute_bytes16.h>
+#include <simdpp/core/split.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/test_bits.h>
+#include <simdpp/core/to_int8.h>
+#include <simdpp/core/to_int16.h>
+#include <simdpp/core/to_int32.h>
+#include <simdpp/detail/algorithm/bit_scan.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+static SIMDPP_INL bool utf8_validate_scalar(const uint8_t* p, std::size_t n)
+{
+    std::size_t i = 0;
+    while (i < n) {
+        uint8_t b = p[i];
+        if (b < 0x80) {
+            ++i;
+            continue;
+        }
+        std::size_t len;
+        uint32_t cp, min;
+        if ((b & 0xe0) == 0xc0) {
+            len = 2; cp = b & 0x1f; min = 0x80;
+        } else if ((b & 0xf0) == 0xe0) {
+            len = 3; cp = b & 0x0f; min = 0x800;
+        } else if ((b & 0xf8) == 0xf0) {
+            len = 4; cp = b & 0x07; min = 0x10000;
+        } else {
+            return false;
+        }
+        if (n - i < len) {
+            return false;
+        }
+        for (std::size_t k = 1; k < len; ++k) {
+            if ((p[i + k] & 0xc0) != 0x80) {
+                return false;
+            }
+            cp = (cp << 6) | (p[i + k] & 0x3f);
+        }
+        if (cp < min || cp > 0x10ffff || (cp >= 0xd800 && cp <= 0xdfff)) {
+            return false;
+        }
+        i += len;
+    }
+    return true;
+}
+
+// Whether the byte permutations needed by the lookup tables are available
+#if SIMDPP_USE_NULL || SIMDPP_USE_SSSE3 || SIMDPP_USE_NEON || SIMDPP_USE_ALTIVEC || SIMDPP_USE_MSA
+using utf8_is_vectorized = std::true_type;
+#else
+using utf8_is_vectorized = std::false_type;
+#endif
+
+using utf8_vector = uint8<SIMDPP_FAST_INT8_SIZE>;
+
+/*  Returns a vector whose bytes are nonzero where the byte of @a cur, given
+    the preceding bytes @a prev1, @a prev2 and @a prev3, is in an invalid
+    position.
+
+    Errors within two-byte windows are classified by three 16-entry tables
+    indexed by the high and low nibble of the previous byte and the high
+    nibble of the current byte; each bit of the entries denotes one kind of
+    error, which is present only if all three entries have it. The third
+    and fourth bytes of longer sequences are checked using the lead bytes
+    two and three positions earlier (Keiser and Lemire, 2021).
+*/
+static SIMDPP_INL utf8_vector utf8_block_errors(const utf8_vector& cur,
+                                                const utf8_vector& prev1,
+                                                const utf8_vector& prev2,
+                                                const utf8_vector& prev3)
+{
+    const uint8_t too_short = 1 << 0;   // 11______ 0_______, 11______ 11______
+    const uint8_t too_long = 1 << 1;    // 0_______ 10______
+    const uint8_t overlong_3 = 1 << 2;  // 11100000 100_____
+    const uint8_t too_large = 1 << 3;   // 11110100 1001____, 11110101+ 10______
+    const uint8_t surrogate = 1 << 4;   // 11101101 101_____
+    const uint8_t overlong_2 = 1 << 5;  // 1100000_ 10______
+    const uint8_t too_large_1000 = 1 << 6; // 11110101+ 1000____
+    const uint8_t overlong_4 = 1 << 6;  // 11110000 1000____
+    const uint8_t two_conts = 1 << 7;   // 10______ 10______
+    const uint8_t carry = too_short | too_long | two_conts;
+
+    utf8_vector t1h = make_uint(
+        too_long, too_long, too_long, too_long,
+        too_long, too_long, too_long, too_long,
+        two_conts, two_conts, two_conts, two_conts,
+        too_short | overlong_2,
+        too_short,
+        too_short | overlong_3 | surrogate,
+        too_short | too_large | too_large_1000 | overlong_4);
+    utf8_vector t1l = make_uint(
+        carry | overlong_3 | overlong_2 | overlong_4,
+        carry | overlong_2,
+        carry,
+        carry,
+        carry | too_large,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000 | surrogate,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000);
+    utf8_vector t2h = make_uint(
+        too_short, too_short, too_short, too_short,
+        too_short, too_short, too_short, too_short,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_short, too_short, too_short, too_short);
+
+    utf8_vector nibble = make_uint(0x0f);
+    utf8_vector b1h = permute_bytes16(t1h, utf8_vector(shift_r<4>(prev1)));
+    utf8_vector b1l = permute_bytes16(t1l, utf8_vector(bit_and(prev1, nibble)));
+    utf8_vector b2h = permute_bytes16(t2h, utf8_vector(shift_r<4>(cur)));
+    utf8_vector special = bit_and(bit_and(b1h, b1l), b2h);
+
+    // only the bytes at least 0xe0 and 0xf0 respectively saturate to >= 0x80
+    utf8_vector third = sub_sat(prev2, utf8_vector(make_uint(0xe0 - 0x80)));
+    utf8_vector fourth = sub_sat(prev3, utf8_vector(make_uint(0xf0 - 0x80)));
+    utf8_vector must23 = bit_and(bit_or(third, fourth), utf8_vector(make_uint(0x80)));
+    return bit_xor(must23, special);
+}
+
+/*  Each block is loaded together with the three preceding bytes. The first
+    block and the blocks that reach the end of the input are copied to a
+    buffer padded with zero bytes; a block past the end is always checked so
+    that sequences truncated by the end of input are detected. Blocks
+    consisting only of ASCII bytes, including the preceding ones, are
+    skipped.
+*/
+static SIMDPP_INL bool utf8_validate(const uint8_t* p, std::size_t n,
+                                     std::true_type /*vectorized*/)
+{
+    const std::size_t L = utf8_vector::length;
+    utf8_vector err = make_zero();
+    utf8_vector high = make_uint(0x80);
+    SIMDPP_ALIGN(SIMDPP_FAST_INT8_SIZE) uint8_t buf[SIMDPP_FAST_INT8_SIZE + 3];
+
+    for (std::size_t i = 0; i <= n; i += L) {
+        utf8_vector cur, prev1, prev2, prev3;
+        if (i >= 3 && i + L <= n) {
+            cur = load_u(p + i);
+            prev1 = load_u(p + i - 1);
+            prev2 = load_u(p + i - 2);
+            prev3 = load_u(p + i - 3);
+        } else {
+            for (std::size_t k = 0; k < L + 3; ++k) {
+                std::size_t j = i + k - 3;
+                buf[k] = (i + k >= 3 && j < n) ? p[j] : 0;
+            }
+            cur = load_u(buf + 3);
+            prev1 = load_u(buf + 2);
+            prev2 = load_u(buf + 1);
+            prev3 = load_u(buf);
+        }
+        if (!test_bits_any(bit_and(bit_or(cur, prev3), high))) {
+            continue;
+        }
+        err = bit_or(err, utf8_block_errors(cur, prev1, prev2, prev3));
+    }
+    return !test_bits_any(err);
+}
+
+static SIMDPP_INL bool utf8_validate(const uint8_t* p, std::size_t n,
+                                     std::false_type /*vectorized*/)
+{
+    return utf8_validate_scalar(p, n);
+}
+
+/*  Decodes the valid sequence at @a p to @a out[r], advances @a r by the
+    number of stored units and returns the length of the sequence.
+*/
+static SIMDPP_INL std::size_t utf8_decode_one(const uint8_t* p, char16_t* out,
+                                              std::size_t& r)
+{
+    uint8_t b = p[0];
+    if (b < 0x80) {
+        out[r++] = b;
+        return 1;
+    }
+    if (b < 0xe0) {
+        out[r++] = char16_t(((b & 0x1f) << 6) | (p[1] & 0x3f));
+        return 2;
+    }
+    if (b < 0xf0) {
+        out[r++] = char16_t(((b & 0x0f) << 12) | ((p[1] & 0x3f) << 6) | (p[2] & 0x3f));
+        return 3;
+    }
+    uint32_t cp = (uint32_t(b & 0x07) << 18) | (uint32_t(p[1] & 0x3f) << 12) |
+                  ((p[2] & 0x3f) << 6) | (p[3] & 0x3f);
+    cp -= 0x10000;
+    out[r++] = char16_t(0xd800 | (cp >> 10));
+    out[r++] = char16_t(0xdc00 | (cp & 0x3ff));
+    return 4;
+}
+
+/*  Byte permutation masks that pack the elements selected by an index to
+    the front of a 128-bit vector. pack16 selects the 16-bit elements whose
+    bits are set in the index. pack8 selects the leading bytes of each of the
+    four 32-bit elements; the number of bytes is one plus the number of set
+    bits in the respective pair of bits of the index.
+*/
+struct utf8_tables {
+    SIMDPP_ALIGN(16) uint8_t pack16[256][16];
+    SIMDPP_ALIGN(16) uint8_t pack8[256][16];
+
+    utf8_tables()
+    {
+        for (unsigned c = 0; c < 256; ++c) {
+            unsigned off = 0;
+            for (unsigned k = 0; k < 8; ++k) {
+                if (c & (1 << k)) {
+                    pack16[c][off++] = uint8_t(k * 2);
+                    pack16[c][off++] = uint8_t(k * 2 + 1);
+                }
+            }
+            for (; off < 16; ++off) {
+                pack16[c][off] = 0;
+            }
+
+            off = 0;
+            for (unsigned k = 0; k < 4; ++k) {
+                unsigned pair = (c >> (k * 2)) & 3;
+                unsigned len = 1 + (pair & 1) + (pair >> 1);
+                for (unsigned s = 0; s < len; ++s) {
+                    pack8[c][off++] = uint8_t(k * 4 + s);
+                }
+            }
+            for (; off < 16; ++off) {
+                pack8[c][off] = 0;
+            }
+        }
+    }
+};
+
+inline const utf8_tables& utf8_get_tables()
+{
+    static const utf8_tables tables;
+    return tables;
+}
+
+/*  Transcodes a block of 16 bytes that is not ASCII, starting at @a in[i].
+    The last sequence may extend past the block.
+*/
+static SIMDPP_INL void utf8_to_utf16_block(const uint8_t* in, std::size_t& i,
+                                           char16_t* out, std::size_t& r,
+                                           const utf8_tables&,
+                                           std::false_type /*vectorized*/)
+{
+    std::size_t end = i + 16;
+    while (i < end) {
+        i += utf8_decode_one(in + i, out, r);
+    }
+}
+
+/*  Blocks without four-byte sequences are decoded at each byte: the code
+    point of the sequence ending at the byte is computed from the byte and the
+    two preceding ones, which are obtained using move16_r(). The values at the
+    last bytes of complete sequences are then packed by permuting each half
+    of the block using a mask from the pack16 table that is indexed by the
+    respective bits of the sequence ends. The block is advanced past its last
+    complete sequence. Up to 8 units past the stored ones are overwritten.
+*/
+static SIMDPP_INL void utf8_to_utf16_block(const uint8_t* in, std::size_t& i,
+                                           char16_t* out, std::size_t& r,
+                                           const utf8_tables& t,
+                                           std::true_type /*vectorized*/)
+{
+    uint8<16> v = load_u(in + i);
+    uint8<16> high = make_uint(0x80);
+    uint8<16>::mask_vector_type four = cmp_ge(v, uint8<16>(make_uint(0xf0)));
+    if (test_bits_any(uint8<16>(four))) {
+        utf8_to_utf16_block(in, i, out, r, t, std::false_type());
+        return;
+    }
+
+    uint8<16> next = load_u(in + i + 1);
+    uint8<16>::mask_vector_type end8 = cmp_neq(bit_and(next, uint8<16>(make_uint(0xc0))), high);
+    unsigned ends = extract_bits_any(uint8<16>(end8));
+
+    uint16<16> c = to_uint16(v);
+    uint16<16> p1 = to_uint16(uint8<16>(move16_r<1>(v)));
+    uint16<16> p2 = to_uint16(uint8<16>(move16_r<2>(v)));
+    uint16<16> x3f = make_uint(0x3f);
+    uint16<16> low = bit_and(c, x3f);
+    uint16<16> two = bit_or(shift_l<6>(bit_and(p1, uint16<16>(make_uint(0x1f)))), low);
+    uint16<16> three = bit_or(bit_or(shift_l<12>(p2), shift_l<6>(bit_and(p1, x3f))), low);
+    uint16<16>::mask_vector_type p1_lead = cmp_ge(p1, uint16<16>(make_uint(0xc0)));
+    uint16<16>::mask_vector_type ascii = cmp_lt(c, uint16<16>(make_uint(0x80)));
+    uint16<16> u = blend(c, blend(two, three, p1_lead), ascii);
+
+    uint8<16> mask_lo = load(t.pack16[ends & 0xff]);
+    uint8<16> mask_hi = load(t.pack16[ends >> 8]);
+    uint16<16> packed = permute_bytes16(u, uint16<16>(combine(mask_lo, mask_hi)));
+    uint16<8> u_lo, u_hi;
+    split(packed, u_lo, u_hi);
+    store_u(out + r, u_lo);
+    r += bit_popcount(ends & 0xff);
+    store_u(out + r, u_hi);
+    r += bit_popcount(ends >> 8);
+    i += bit_scan_reverse(ends) + 1;
+}
+
+/*  Transcodes valid input. Blocks of ASCII are widened. The stores of the
+    blocks stay within the first @a n units of @a out, since at most one unit
+    is stored per byte of the block and each block is followed by at least
+    one byte.
+*/
+template<class Vectorized> SIMDPP_INL
+std::size_t utf8_to_utf16_valid(const uint8_t* in, std::size_t n, char16_t* out,
+                                Vectorized vectorized)
+{
+    const utf8_tables& t = utf8_get_tables();
+    std::size_t i = 0;
+    std::size_t r = 0;
+    uint8<16> high = make_uint(0x80);
+
+    while (i + 17 <= n) {
+        uint8<16> v = load_u(in + i);
+        if (!test_bits_any(bit_and(v, high))) {
+            store_u(out + r, to_uint16(v));
+            i += 16;
+            r += 16;
+            continue;
+        }
+        utf8_to_utf16_block(in, i, out, r, t, vectorized);
+    }
+    while (i < n) {
+        i += utf8_decode_one(in + i, out, r);
+    }
+    return r;
+}
+
+/*  Encodes the code point starting at @a in[i] to @a out[r], advances @a r
+    by the number of stored bytes and returns the number of consumed units,
+    or 0 if the units are not valid UTF-16.
+*/
+static SIMDPP_INL std::size_t utf16_encode_one(const char16_t* in, std::size_t i,
+                                               std::size_t n, uint8_t* out,
+                                               std::size_t& r)
+{
+    uint32_t u = in[i];
+    if (u < 0x80) {
+        out[r++] = uint8_t(u);
+        return 1;
+    }
+    if (u < 0x800) {
+        out[r++] = uint8_t(0xc0 | (u >> 6));
+        out[r++] = uint8_t(0x80 | (u & 0x3f));
+        return 1;
+    }
+    if (u < 0xd800 || u >= 0xe000) {
+        out[r++] = uint8_t(0xe0 | (u >> 12));
+        out[r++] = uint8_t(0x80 | ((u >> 6) & 0x3f));
+        out[r++] = uint8_t(0x80 | (u & 0x3f));
+        return 1;
+    }
+    if (u >= 0xdc00 || i + 1 >= n) {
+        return 0;
+    }
+    uint32_t l = in[i + 1];
+    if (l < 0xdc00 || l >= 0xe000) {
+        return 0;
+    }
+    uint32_t cp = 0x10000 + ((u - 0xd800) << 10) + (l - 0xdc00);
+    out[r++] = uint8_t(0xf0 | (cp >> 18));
+    out[r++] = uint8_t(0x80 | ((cp >> 12) & 0x3f));
+    out[r++] = uint8_t(0x80 | ((cp >> 6) & 0x3f));
+    out[r++] = uint8_t(0x80 | (cp & 0x3f));
+    return 2;
+}
+
+/*  Encodes the units of a block of 16 that contains at least one non-ASCII
+    unit, starting at @a in[i]. Returns false if the units are not valid
+    UTF-16. The last surrogate pair may extend past the block.
+*/
+static SIMDPP_INL bool utf16_to_utf8_block(const char16_t* in, std::size_t& i,
+                                           std::size_t n, uint8_t* out, std::size_t& r,
+                                           const utf8_tables&,
+                                           std::false_type /*vectorized*/)
+{
+    std::size_t end = i + 16;
+    while (i < end) {
+        std::size_t k = utf16_encode_one(in, i, n, out, r);
+        if (k == 0) {
+            return false;
+        }
+        i += k;
+    }
+    return true;
+}
+
+/*  Encodes 8 units without surrogates by computing up to three bytes in
+    each 32-bit element. Bits 1 and 2 of each element of the mask of used
+    bytes are gathered to form an 8-bit index for each group of 4 elements,
+    which selects a mask from the pack8 table that packs the used bytes of the
+    group. Up to 12 bytes past the stored ones are overwritten.
+*/
+static SIMDPP_INL void utf16_to_utf8_half(const uint16<8>& x, uint8_t* out, std::size_t& r,
+                                          const utf8_tables& t)
+{
+    uint32<8> x3f = make_uint(0x3f);
+    uint32<8> x80 = make_uint(0x80);
+#if SIMDPP_BIG_ENDIAN
+    uint32<8> keep1 = make_uint(0x00ff0000);
+    uint32<8> keep2 = make_uint(0x0000ff00);
+#else
+    uint32<8> keep1 = make_uint(0x0000ff00);
+    uint32<8> keep2 = make_uint(0x00ff0000);
+#endif
+
+    uint32<8> u = to_uint32(x);
+    uint32<8>::mask_vector_type ge80 = cmp_ge(u, x80);
+    uint32<8>::mask_vector_type ge800 = cmp_ge(u, uint32<8>(make_uint(0x800)));
+    uint32<8> t0 = bit_or(shift_r<12>(u), uint32<8>(make_uint(0xe0)));
+    uint32<8> w0 = bit_or(shift_r<6>(u), uint32<8>(make_uint(0xc0)));
+    uint32<8> t1 = bit_or(bit_and(shift_r<6>(u), x3f), x80);
+    uint32<8> last = bit_or(bit_and(u, x3f), x80);
+    uint32<8> b0 = blend(blend(t0, w0, ge800), u, ge80);
+    uint32<8> b1 = blend(t1, last, ge800);
+#if SIMDPP_BIG_ENDIAN
+    uint32<8> bytes = bit_or(bit_or(shift_l<24>(b0), shift_l<16>(b1)), shift_l<8>(last));
+#else
+    uint32<8> bytes = bit_or(bit_or(b0, shift_l<8>(b1)), shift_l<16>(last));
+#endif
+    uint32<8> keep = bit_or(bit_and(keep1, uint32<8>(ge80)),
+                            bit_and(keep2, uint32<8>(ge800)));
+
+    uint32_t idx = (extract_bits_any(uint8<32>(keep)) >> 1) & 0x33333333;
+    idx = (idx | (idx >> 2)) & 0x0f0f0f0f;
+    idx = (idx | (idx >> 4)) & 0x00ff00ff;
+
+    uint8<16> mask_lo = load(t.pack8[idx & 0xff]);
+    uint8<16> mask_hi = load(t.pack8[idx >> 16]);
+    uint8<32> packed = permute_bytes16(uint8<32>(bytes), combine(mask_lo, mask_hi));
+    uint8<16> p_lo, p_hi;
+    split(packed, p_lo, p_hi);
+    store_u(out + r, p_lo);
+    r += 4 + bit_popcount(idx & 0xff);
+    store_u(out + r, p_hi);
+    r += 4 + bit_popcount(idx >> 16);
+}
+
+/*  Blocks without surrogates are encoded 8 units at a time using
+    utf16_to_utf8_half().
+*/
+static SIMDPP_INL bool utf16_to_utf8_block(const char16_t* in, std::size_t& i,
+                                           std::size_t n, uint8_t* out, std::size_t& r,
+                                           const utf8_tables& t,
+                                           std::true_type /*vectorized*/)
+{
+    uint16<16> x = load_u(in + i);
+    uint16<16>::mask_vector_type sur = cmp_eq(bit_and(x, uint16<16>(make_uint(0xf800))),
+                                              uint16<16>(make_uint(0xd800)));
+    if (test_bits_any(uint16<16>(sur))) {
+        return utf16_to_utf8_block(in, i, n, out, r, t, std::false_type());
+    }
+    utf16_to_utf8_half(load_u(in + i), out, r, t);
+    utf16_to_utf8_half(load_u(in + i + 8), out, r, t);
+    i += 16;
+    return true;
+}
+
+/*  Blocks of ASCII are narrowed. A block starting at the i-th unit starts at
+    most at the 3*i-th byte and stores at most 3*16 + 4 bytes, thus the
+    stores stay within the first 3 * @a n bytes of @a out if at least two
+    units follow the block.
+*/
+template<class Vectorized> SIMDPP_INL
+std::size_t utf16_to_utf8(const char16_t* in, std::size_t n, uint8_t* out,
+                          Vectorized vectorized)
+{
+    const utf8_tables& t = utf8_get_tables();
+    std::size_t i = 0;
+    std::size_t r = 0;
+    uint16<16> non_ascii = make_uint(0xff80);
+
+    while (i + 18 <= n) {
+        uint16<16> x = load_u(in + i);
+        if (!test_bits_any(bit_and(x, non_ascii))) {
+            store_u(out + r, to_uint8(x));
+            i += 16;
+            r += 16;
+            continue;
+        }
+        if (!utf16_to_utf8_block(in, i, n, out, r, t, vectorized)) {
+            return 0;
+        }
+    }
+    while (i < n) {
+        std::size_t k = utf16_encode_one(in, i, n, out, r);
+        if (k == 0) {
+            return 0;
+        }
+        i += k;
+    }
+    return r;
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
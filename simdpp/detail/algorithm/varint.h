@@ -0,0 +1,360 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_VARINT_H
+#define LIBSIMDPP_SIMDPP_DETAIL_ALGORITHM_VARINT_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/cmp_lt.h>
+#include <simdpp/core/combine.h>
+#include <simdpp/core/extract_bits.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/permute_zbytes16.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/store_u.h>
+#include <simdpp/core/to_int32.h>
+#include <simdpp/detail/algorithm/bit_scan.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+// Whether the byte permutations needed by Stream VByte are available
+#if SIMDPP_USE_NULL || SIMDPP_USE_SSSE3 || SIMDPP_USE_NEON || SIMDPP_USE_ALTIVEC || SIMDPP_USE_MSA
+using svb_is_vectorized = std::true_type;
+#else
+using svb_is_vectorized = std::false_type;
+#endif
+
+// The number of bytes needed to store x, 1 to 4
+static SIMDPP_INL unsigned svb_value_length(uint32_t x)
+{
+    return 1 + (x > 0xff) + (x > 0xffff) + (x > 0xffffff);
+}
+
+/*  Byte permutation masks and data lengths for each of the 256 control
+    bytes. The decode mask moves the data bytes of 4 values to their 32-bit
+    elements and zeroes the remaining bytes; the encode mask does the
+    reverse.
+*/
+struct svb_tables {
+    SIMDPP_ALIGN(16) uint8_t decode[256][16];
+    SIMDPP_ALIGN(16) uint8_t encode[256][16];
+    uint8_t length[256];
+
+    svb_tables()
+    {
+        for (unsigned c = 0; c < 256; ++c) {
+            unsigned off = 0;
+            std::memset(decode[c], 0x80, 16);
+            std::memset(encode[c], 0x80, 16);
+            for (unsigned k = 0; k < 4; ++k) {
+                unsigned len = ((c >> (k * 2)) & 3) + 1;
+                for (unsigned s = 0; s < len; ++s) {
+#if SIMDPP_BIG_ENDIAN
+                    unsigned pos = k * 4 + 3 - s;
+#else
+                    unsigned pos = k * 4 + s;
+#endif
+                    decode[c][pos] = uint8_t(off + s);
+                    encode[c][off + s] = uint8_t(pos);
+                }
+                off += len;
+            }
+            length[c] = uint8_t(off);
+        }
+    }
+};
+
+inline const svb_tables& svb_get_tables()
+{
+    static const svb_tables tables;
+    return tables;
+}
+
+static SIMDPP_INL std::size_t svb_control_bytes(std::size_t n)
+{
+    return (n + 3) / 4;
+}
+
+static SIMDPP_INL uint32_t svb_read(const uint8_t* p, unsigned len)
+{
+    uint32_t r = 0;
+    for (unsigned s = 0; s < len; ++s) {
+        r |= uint32_t(p[s]) << (s * 8);
+    }
+    return r;
+}
+
+static SIMDPP_INL void svb_write(uint8_t* p, uint32_t x, unsigned len)
+{
+    for (unsigned s = 0; s < len; ++s) {
+        p[s] = uint8_t(x >> (s * 8));
+    }
+}
+
+// Encodes up to 4 values of a group and returns the number of data bytes
+static SIMDPP_INL unsigned svb_encode_group_scalar(const uint32_t* in, unsigned count,
+                                                   uint8_t* ctrl, uint8_t* data)
+{
+    unsigned c = 0;
+    unsigned off = 0;
+    for (unsigned k = 0; k < count; ++k) {
+        unsigned len = svb_value_length(in[k]);
+        svb_write(data + off, in[k], len);
+        c |= (len - 1) << (k * 2);
+        off += len;
+    }
+    *ctrl = uint8_t(c);
+    return off;
+}
+
+static SIMDPP_INL unsigned svb_encode_group(const uint32_t* in, uint8_t* ctrl, uint8_t* data,
+                                            const svb_tables&, std::false_type /*vectorized*/)
+{
+    return svb_encode_group_scalar(in, 4, ctrl, data);
+}
+
+/*  All 16 bytes are stored, thus up to 16 - length bytes past the data of
+    the group are overwritten.
+*/
+static SIMDPP_INL unsigned svb_encode_group(const uint32_t* in, uint8_t* ctrl, uint8_t* data,
+                                            const svb_tables& t, std::true_type /*vectorized*/)
+{
+    unsigned c = (svb_value_length(in[0]) - 1) |
+                 ((svb_value_length(in[1]) - 1) << 2) |
+                 ((svb_value_length(in[2]) - 1) << 4) |
+                 ((svb_value_length(in[3]) - 1) << 6);
+    uint8<16> v = load_u(in);
+    uint8<16> mask = load(t.encode[c]);
+    store_u(data, permute_zbytes16(v, mask));
+    *ctrl = uint8_t(c);
+    return t.length[c];
+}
+
+static SIMDPP_INL std::size_t svb_encode(const uint32_t* in, std::size_t n, uint8_t* out)
+{
+    const svb_tables& t = svb_get_tables();
+    uint8_t* ctrl = out;
+    uint8_t* data = out + svb_control_bytes(n);
+
+    /*  A group that starts at the i-th value starts at most at 4*i data
+        bytes, thus the 16-byte stores of full groups never reach past
+        svb_max_encoded_size(n).
+    */
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        data += svb_encode_group(in + i, ctrl++, data, t, svb_is_vectorized());
+    }
+    if (i < n) {
+        data += svb_encode_group_scalar(in + i, unsigned(n - i), ctrl, data);
+    }
+    return data - out;
+}
+
+// Loads the data and the decode masks of G consecutive groups
+template<unsigned G>
+struct svb_load_groups {
+    static SIMDPP_INL unsigned run(const uint8_t* ctrl, const uint8_t* data, const svb_tables& t,
+                                   uint8<G*16>& d, uint8<G*16>& m)
+    {
+        uint8<G*8> d0, d1, m0, m1;
+        unsigned len0 = svb_load_groups<G/2>::run(ctrl, data, t, d0, m0);
+        unsigned len1 = svb_load_groups<G/2>::run(ctrl + G/2, data + len0, t, d1, m1);
+        d = combine(d0, d1);
+        m = combine(m0, m1);
+        return len0 + len1;
+    }
+};
+
+template<>
+struct svb_load_groups<1> {
+    static SIMDPP_INL unsigned run(const uint8_t* ctrl, const uint8_t* data, const svb_tables& t,
+                                   uint8<16>& d, uint8<16>& m)
+    {
+        d = load_u(data);
+        m = load(t.decode[*ctrl]);
+        return t.length[*ctrl];
+    }
+};
+
+/*  Decodes the full groups of 4 values using G groups per iteration. Returns
+    the number of decoded groups; the data pointer is advanced past their
+    data. Each group reads 16 bytes, thus decoding stops before the last
+    group whose read would pass @a data_end.
+*/
+template<unsigned G> SIMDPP_INL
+std::size_t svb_decode_groups(const uint8_t* ctrl, std::size_t groups,
+                              const uint8_t*& data, const uint8_t* data_end,
+                              uint32_t* out, std::true_type /*vectorized*/)
+{
+    const svb_tables& t = svb_get_tables();
+    std::size_t i = 0;
+    for (; i + G <= groups && std::size_t(data_end - data) >= G * 16; i += G) {
+        uint8<G*16> d, m;
+        data += svb_load_groups<G>::run(ctrl + i, data, t, d, m);
+        store_u(out + i * 4, uint32<G*4>(permute_zbytes16(d, m)));
+    }
+    for (; i < groups && data_end - data >= 16; ++i) {
+        uint8<16> d, m;
+        data += svb_load_groups<1>::run(ctrl + i, data, t, d, m);
+        store_u(out + i * 4, uint32<4>(permute_zbytes16(d, m)));
+    }
+    return i;
+}
+
+template<unsigned G> SIMDPP_INL
+std::size_t svb_decode_groups(const uint8_t*, std::size_t, const uint8_t*&,
+                              const uint8_t*, uint32_t*, std::false_type /*vectorized*/)
+{
+    return 0;
+}
+
+static SIMDPP_INL std::size_t svb_decode(const uint8_t* in, std::size_t n, uint32_t* out)
+{
+    const svb_tables& t = svb_get_tables();
+    const uint8_t* ctrl = in;
+    const uint8_t* data = in + svb_control_bytes(n);
+    std::size_t groups = n / 4;
+
+    // The data length is needed to avoid reading past the end of the input
+    std::size_t data_bytes = 0;
+    for (std::size_t i = 0; i < groups; ++i) {
+        data_bytes += t.length[ctrl[i]];
+    }
+    const uint8_t* data_end = data + data_bytes;
+
+    const unsigned G = SIMDPP_FAST_INT32_SIZE / 4;
+    std::size_t i = svb_decode_groups<G>(ctrl, groups, data, data_end, out,
+                                         svb_is_vectorized());
+    for (; i * 4 < n; ++i) {
+        unsigned c = ctrl[i];
+        for (unsigned k = 0; k < 4 && i * 4 + k < n; ++k) {
+            unsigned len = ((c >> (k * 2)) & 3) + 1;
+            out[i * 4 + k] = svb_read(data, len);
+            data += len;
+        }
+    }
+    return data - in;
+}
+
+// -----------------------------------------------------------------------------
+
+static SIMDPP_INL std::size_t leb128_encode(const uint32_t* in, std::size_t n, uint8_t* out)
+{
+    uint8_t* o = out;
+    for (std::size_t i = 0; i < n; ++i) {
+        uint32_t x = in[i];
+        while (x >= 0x80) {
+            *o++ = uint8_t(x | 0x80);
+            x >>= 7;
+        }
+        *o++ = uint8_t(x);
+    }
+    return o - out;
+}
+
+/*  Decodes a value of @a len bytes, 1 to 5, from the lower bytes of the
+    little-endian word @a w. Returns false if the value does not fit into 32
+    bits.
+*/
+static SIMDPP_INL bool leb128_decode_word(uint64_t w, unsigned len, uint32_t& r)
+{
+    w &= ~uint64_t(0) >> (64 - len * 8);
+    if (len == 5 && (w >> 32) > 0x0f) {
+        return false;
+    }
+    r = uint32_t((w & 0x7f) |
+                 ((w >> 1) & (0x7fu << 7)) |
+                 ((w >> 2) & (0x7fu << 14)) |
+                 ((w >> 3) & (0x7fu << 21)) |
+                 ((w >> 4) & (0x0fu << 28)));
+    return true;
+}
+
+static SIMDPP_INL std::size_t leb128_decode_scalar(const uint8_t* in, const uint8_t* end,
+                                                   uint32_t& r)
+{
+    uint64_t w = 0;
+    for (unsigned len = 1; len <= 5 && len <= std::size_t(end - in); ++len) {
+        w |= uint64_t(in[len - 1]) << ((len - 1) * 8);
+        if (in[len - 1] < 0x80) {
+            return leb128_decode_word(w, len, r) ? len : 0;
+        }
+    }
+    return 0;
+}
+
+/*  The input is processed in chunks of 16 bytes. The terminating bytes,
+    which have the high bit clear, are found with a single comparison and
+    a bit mask extraction. Chunks of 16 single-byte values are widened
+    directly; otherwise each value is decoded from the bytes up to the next
+    terminator without any per-byte branches.
+*/
+static SIMDPP_INL std::size_t leb128_decode(const uint8_t* in, std::size_t in_size,
+                                            uint32_t* out, std::size_t n)
+{
+    const uint8_t* p = in;
+    const uint8_t* end = in + in_size;
+    std::size_t i = 0;
+
+    while (i < n && end - p >= 16) {
+        uint8<16> v = load_u(p);
+        mask_int8<16> is_term = cmp_lt(v, splat<uint8<16>>(0x80));
+        unsigned term = extract_bits_any(uint8<16>(is_term));
+
+        if (term == 0xffff && i + 16 <= n) {
+            store_u(out + i, to_uint32(v));
+            i += 16;
+            p += 16;
+            continue;
+        }
+
+        SIMDPP_ALIGN(16) uint8_t buf[24] = {};
+        store_u(buf, v);
+        unsigned pos = 0;
+        while (i < n && (term >> pos) != 0) {
+            unsigned len = bit_scan_forward(term >> pos) + 1;
+            uint64_t w = 0;
+            for (unsigned s = 0; s < 8; ++s) {
+                w |= uint64_t(buf[pos + s]) << (s * 8);
+            }
+            if (len > 5 || !leb128_decode_word(w, len, out[i])) {
+                return 0;
+            }
+            pos += len;
+            i++;
+        }
+        if (pos == 0) {
+            return 0; // no terminator within 16 bytes
+        }
+        p += pos;
+    }
+
+    for (; i < n; ++i) {
+        std::size_t len = leb128_decode_scalar(p, end, out[i]);
+        if (len == 0) {
+            return 0;
+        }
+        p += len;
+    }
+    return p - in;
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,160 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_BLOOM_FILTER_H
+#define LIBSIMDPP_SIMDPP_DETAIL_BLOOM_FILTER_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_andnot.h>
+#include <simdpp/core/bit_or.h>
+#include <simdpp/core/cmp_eq.h>
+#include <simdpp/core/i_mul.h>
+#include <simdpp/core/i_shift_l.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/load.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/store.h>
+#include <simdpp/core/test_bits.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+/*  The filter consists of 256-bit blocks of eight 32-bit words. The upper
+    32 bits of the hash of a key select the block and the lower 32 bits,
+    multiplied by a different odd constant for each word, select one bit in
+    each word. The layout and the constants are the same as in the split block
+    Bloom filters of Apache Parquet.
+*/
+static const unsigned bloom_block_words = 8;
+
+static SIMDPP_INL uint32<8> bloom_salt()
+{
+    return make_uint(0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d,
+                     0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31);
+}
+
+static SIMDPP_INL uint32_t bloom_salt(unsigned i)
+{
+    static const uint32_t salt[bloom_block_words] = {
+        0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d,
+        0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31
+    };
+    return salt[i];
+}
+
+static SIMDPP_INL std::size_t bloom_block_index(uint64_t h, std::size_t num_blocks)
+{
+    return static_cast<std::size_t>(((h >> 32) * num_blocks) >> 32);
+}
+
+// Returns the bits to set in each word of the block
+static SIMDPP_INL uint32<8> bloom_block_mask(uint64_t h)
+{
+    uint32<8> bits = mul_lo(splat<uint32<8>>(uint32_t(h)), bloom_salt());
+    bits = shift_r<27>(bits);
+    return shift_l(splat<uint32<8>>(1), bits);
+}
+
+static SIMDPP_INL void bloom_insert(uint32_t* block, uint64_t h)
+{
+    uint32<8> b = load(block);
+    b = bit_or(b, bloom_block_mask(h));
+    store(block, b);
+}
+
+static SIMDPP_INL bool bloom_contains(const uint32_t* block, uint64_t h)
+{
+    uint32<8> b = load(block);
+    return !test_bits_any(bit_andnot(bloom_block_mask(h), b));
+}
+
+/*  Batch probes check N keys at once, one per vector element. The i-th word
+    of the block of each key is gathered into a single vector and tested
+    against the i-th bits of the keys.
+*/
+#if SIMDPP_USE_AVX512F
+static const unsigned bloom_gather_width = 16;
+
+static SIMDPP_INL uint32<16> bloom_gather(const uint32_t* p, const uint32<16>& idx)
+{
+    return _mm512_i32gather_epi32(idx.native(), p, 4);
+}
+#elif SIMDPP_USE_AVX2
+static const unsigned bloom_gather_width = 8;
+
+static SIMDPP_INL uint32<8> bloom_gather(const uint32_t* p, const uint32<8>& idx)
+{
+    return _mm256_i32gather_epi32(reinterpret_cast<const int*>(p),
+                                  idx.native(), 4);
+}
+#endif
+
+#if SIMDPP_USE_AVX512F || SIMDPP_USE_AVX2
+// The indices of the gathered words must fit into signed 32-bit integers
+static const std::size_t bloom_gather_max_blocks = (std::size_t(1) << 31) /
+                                                   bloom_block_words;
+
+template<unsigned N>
+void bloom_contains_gather(const uint32_t* blocks, std::size_t num_blocks,
+                           const uint64_t* hashes, bool* out)
+{
+    using U = uint32<N>;
+    SIMDPP_ALIGN(N*4) uint32_t idx[N];
+    SIMDPP_ALIGN(N*4) uint32_t lo[N];
+    for (unsigned i = 0; i < N; ++i) {
+        idx[i] = uint32_t(bloom_block_index(hashes[i], num_blocks) * bloom_block_words);
+        lo[i] = uint32_t(hashes[i]);
+    }
+    U vidx = load(idx);
+    U vlo = load(lo);
+    U missing = splat<U>(0);
+    for (unsigned w = 0; w < bloom_block_words; ++w) {
+        U bits = shift_r<27>(mul_lo(vlo, splat<U>(bloom_salt(w))));
+        U mask = shift_l(splat<U>(1), bits);
+        missing = bit_or(missing, bit_andnot(mask, bloom_gather(blocks + w, vidx)));
+    }
+    typename U::mask_vector_type found = cmp_eq(missing, splat<U>(0));
+    store(idx, U(found));
+    for (unsigned i = 0; i < N; ++i) {
+        out[i] = idx[i] != 0;
+    }
+}
+#endif
+
+static SIMDPP_INL void bloom_contains_many(const uint32_t* blocks,
+                                           std::size_t num_blocks,
+                                           const uint64_t* hashes,
+                                           std::size_t n, bool* out)
+{
+    std::size_t i = 0;
+#if SIMDPP_USE_AVX512F || SIMDPP_USE_AVX2
+    if (num_blocks <= bloom_gather_max_blocks) {
+        const unsigned N = bloom_gather_width;
+        for (; i + N <= n; i += N) {
+            bloom_contains_gather<N>(blocks, num_blocks, hashes + i, out + i);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        std::size_t b = bloom_block_index(hashes[i], num_blocks);
+        out[i] = bloom_contains(blocks + b * bloom_block_words, hashes[i]);
+    }
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
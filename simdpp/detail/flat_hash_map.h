@@ -0,0 +1,101 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_FLAT_HASH_MAP_H
+#define LIBSIMDPP_SIMDPP_DETAIL_FLAT_HASH_MAP_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/load_u.h>
+#include <simdpp/core/make_uint.h>
+#include <simdpp/detail/algorithm/bit_scan.h>
+#include <simdpp/detail/algorithm/memory.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+/*  Each slot has a control byte. The control byte of a full slot holds the
+    lower 7 bits of the hash of its key (H2) and has the highest bit cleared.
+    The remaining bits of the hash (H1) select the position at which the
+    probing starts.
+*/
+static const uint8_t hash_ctrl_empty = 0x80;
+static const uint8_t hash_ctrl_deleted = 0xfe;
+
+// Mixes the bits of the hash so that both H1 and H2 are well distributed
+// even if the hash function is the identity
+static SIMDPP_INL uint64_t hash_mix(uint64_t h)
+{
+    h *= 0x9e3779b97f4a7c15ull;
+    return h ^ (h >> 32);
+}
+
+static SIMDPP_INL std::size_t hash_h1(uint64_t h)
+{
+    return static_cast<std::size_t>(h >> 7);
+}
+
+static SIMDPP_INL uint8_t hash_h2(uint64_t h)
+{
+    return static_cast<uint8_t>(h & 0x7f);
+}
+
+// Returns a bit mask of the slots in the group at ctrl whose control byte is c
+static SIMDPP_INL uint64_t hash_group_match(const uint8_t* ctrl, uint8_t c)
+{
+    mem_vector g = load_u(ctrl);
+    return mem_eq_bits(g, mem_vector(make_uint(c)));
+}
+
+// Returns a bit mask of the empty and deleted slots in the group at ctrl
+static SIMDPP_INL uint64_t hash_group_match_free(const uint8_t* ctrl)
+{
+    mem_vector msb = make_uint(0x80);
+    mem_vector g = load_u(ctrl);
+    g = bit_and(g, msb);
+    return mem_eq_bits(g, msb);
+}
+
+/*  The probe sequence visits groups of mem_vector_size slots starting at
+    arbitrary positions. The distance between the groups grows by the group
+    size at each step, which visits every group if the capacity is a power of
+    two.
+*/
+class hash_probe_seq {
+public:
+    hash_probe_seq(std::size_t h1, std::size_t mask) :
+        pos_(h1 & mask), step_(0), mask_(mask) {}
+
+    std::size_t pos() const { return pos_; }
+
+    // Returns the slot index of the i-th element of the current group
+    std::size_t index(unsigned i) const { return (pos_ + i) & mask_; }
+
+    void next()
+    {
+        step_ += mem_vector_size;
+        pos_ = (pos_ + step_) & mask_;
+    }
+
+private:
+    std::size_t pos_;
+    std::size_t step_;
+    std::size_t mask_;
+};
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,61 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_INSN_BIT_TRANSPOSE_H
+#define LIBSIMDPP_SIMDPP_DETAIL_INSN_BIT_TRANSPOSE_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/bit_and.h>
+#include <simdpp/core/bit_xor.h>
+#include <simdpp/core/i_shift_l.h>
+#include <simdpp/core/i_shift_r.h>
+#include <simdpp/core/splat.h>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+namespace insn {
+
+// Swaps the bits selected by mask with the bits S positions higher
+template<unsigned S, unsigned N> SIMDPP_INL
+uint64<N> v_bit_delta_swap(const uint64<N>& x, uint64_t mask)
+{
+    uint64<N> t = bit_and(bit_xor(x, shift_r<S>(x)), splat<uint64<N>>(mask));
+    return bit_xor(bit_xor(x, t), shift_l<S>(t));
+}
+
+/*  Each 64-bit element holds one matrix. Each bit (i,j) is swapped with the
+    bit (j,i) in three steps that transpose 2x2, 4x4 and 8x8 blocks of
+    bits. Row i is the byte at memory offset i, thus the distances between
+    the swapped bits depend on the byte order.
+*/
+template<unsigned N> SIMDPP_INL
+uint8<N> i_bit_transpose8x8(const uint8<N>& a)
+{
+    uint64<N/8> x = uint64<N/8>(a);
+#if SIMDPP_BIG_ENDIAN
+    x = v_bit_delta_swap<9>(x, 0x0055005500550055);
+    x = v_bit_delta_swap<18>(x, 0x0000333300003333);
+    x = v_bit_delta_swap<36>(x, 0x000000000f0f0f0f);
+#else
+    x = v_bit_delta_swap<7>(x, 0x00aa00aa00aa00aa);
+    x = v_bit_delta_swap<14>(x, 0x0000cccc0000cccc);
+    x = v_bit_delta_swap<28>(x, 0x00000000f0f0f0f0);
+#endif
+    return uint8<N>(x);
+}
+
+} // namespace insn
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
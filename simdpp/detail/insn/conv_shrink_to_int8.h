@@ -18,6 +18,8 @@
 #include <simdpp/core/permute_bytes16.h>
 #include <simdpp/core/shuffle4x2.h>
 #include <simdpp/core/unzip_lo.h>
+#include <simdpp/core/zip_hi.h>
+#include <simdpp/core/zip_lo.h>
 #include <simdpp/detail/insn/conv_shrink_to_int16.h>
 #include <simdpp/detail/insn/conv_shrink_to_int32.h>
 
@@ -166,8 +168,8 @@ SIMDPP_INL uint8<32> i_to_uint8(const uint32<32>& a)
     a64_1 = zip4_lo(a32_2, a32_3);
     a32_0 = zip2_lo(a64_0, a64_1);
     split(a32_0, b32_0, b32_1);
-    c32_0 = unzip4_lo(b32_0, b32_1);
-    c32_1 = unzip4_hi(b32_0, b32_1);
+    c32_0 = zip4_lo(b32_0, b32_1);
+    c32_1 = zip4_hi(b32_0, b32_1);
     return (uint8<32>) combine(c32_0, c32_1);
 #endif
 }
@@ -90,6 +90,17 @@ SIMDPP_INL uint32_t i_extract_bits_any(const uint8<32>& ca)
 #endif
 }
 
+SIMDPP_INL uint64_t i_extract_bits_any(const uint8<64>& ca)
+{
+#if SIMDPP_USE_AVX512BW
+    return _mm512_movepi8_mask(ca.native());
+#else
+    uint8<32> lo, hi;
+    split(ca, lo, hi);
+    return uint64_t(i_extract_bits_any(lo)) | (uint64_t(i_extract_bits_any(hi)) << 32);
+#endif
+}
+
 template<unsigned id> SIMDPP_INL
 uint16_t i_extract_bits(const uint8<16>& ca)
 {
@@ -141,6 +152,19 @@ uint32_t i_extract_bits(const uint8<32>& ca)
 #endif
 }
 
+template<unsigned id> SIMDPP_INL
+uint64_t i_extract_bits(const uint8<64>& ca)
+{
+#if SIMDPP_USE_AVX512BW
+    uint8<64> a = (uint8<64>) shift_l<7-id>((uint16<32>) ca);
+    return i_extract_bits_any(a);
+#else
+    uint8<32> lo, hi;
+    split(ca, lo, hi);
+    return uint64_t(i_extract_bits<id>(lo)) | (uint64_t(i_extract_bits<id>(hi)) << 32);
+#endif
+}
+
 } // namespace insn
 } // namespace detail
 } // namespace SIMDPP_ARCH_NAMESPACE
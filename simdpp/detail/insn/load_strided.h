@@ -0,0 +1,303 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_INSN_LOAD_STRIDED_H
+#define LIBSIMDPP_SIMDPP_DETAIL_INSN_LOAD_STRIDED_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/insert.h>
+#include <simdpp/core/load_splat.h>
+#include <simdpp/detail/insn/load_u.h>
+#include <simdpp/detail/insn/mem_unpack.h>
+#include <simdpp/detail/mem_block.h>
+#include <cstring>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+namespace insn {
+
+/*  Selects the implementation of a strided load or store of a single native
+    vector: 0 - element by element, 1 - contiguous access, 2, 3, 4 - shuffles
+    (mem_unpack / mem_pack) of that many contiguous vectors.
+*/
+template<unsigned Stride>
+using strided_kind = std::integral_constant<unsigned,
+        (Stride <= 4 && !SIMDPP_USE_NULL) ? Stride : (Stride == 1 ? 1 : 0)>;
+
+// Loads elements one by one and inserts them into successive vector lanes.
+// On NEON this compiles to a chain of vld1q_lane instructions.
+template<unsigned Stride, unsigned I, unsigned L>
+struct load_strided_lanes {
+    template<class V> static SIMDPP_INL
+    void run(V& a, const char* p)
+    {
+        using E = typename V::element_type;
+        E el;
+        std::memcpy(&el, p + I * Stride * sizeof(E), sizeof(E));
+        a = insert<I>(a, el);
+        load_strided_lanes<Stride, I+1, L>::run(a, p);
+    }
+};
+
+template<unsigned Stride, unsigned L>
+struct load_strided_lanes<Stride, L, L> {
+    template<class V> static SIMDPP_INL
+    void run(V&, const char*) {}
+};
+
+template<unsigned Stride, class V> SIMDPP_INL
+void v_load_strided(V& a, const char* p, std::integral_constant<unsigned, 0>)
+{
+#if SIMDPP_USE_NEON
+    a = load_splat(reinterpret_cast<const typename V::element_type*>(p));
+    load_strided_lanes<Stride, 1, V::length>::run(a, p);
+#else
+    using E = typename V::element_type;
+    mem_block<V> r;
+    for (unsigned i = 0; i < V::length; ++i) {
+        std::memcpy(&r[i], p + i * Stride * sizeof(E), sizeof(E));
+    }
+    a = r;
+#endif
+}
+
+template<unsigned Stride, class V> SIMDPP_INL
+void v_load_strided(V& a, const char* p, std::integral_constant<unsigned, 1>)
+{
+    i_load_u(a, p);
+}
+
+template<unsigned Stride, class V> SIMDPP_INL
+void v_load_strided(V& a, const char* p, std::integral_constant<unsigned, 2>)
+{
+    V b;
+    i_load_u(a, p);
+    i_load_u(b, p + V::length_bytes);
+    mem_unpack2(a, b);
+}
+
+template<unsigned Stride, class V> SIMDPP_INL
+void v_load_strided(V& a, const char* p, std::integral_constant<unsigned, 3>)
+{
+    V b, c;
+    i_load_u(a, p);
+    i_load_u(b, p + V::length_bytes);
+    i_load_u(c, p + V::length_bytes * 2);
+    mem_unpack3(a, b, c);
+}
+
+template<unsigned Stride, class V> SIMDPP_INL
+void v_load_strided(V& a, const char* p, std::integral_constant<unsigned, 4>)
+{
+    V b, c, d;
+    i_load_u(a, p);
+    i_load_u(b, p + V::length_bytes);
+    i_load_u(c, p + V::length_bytes * 2);
+    i_load_u(d, p + V::length_bytes * 3);
+    mem_unpack4(a, b, c, d);
+}
+
+// Loads a single native vector
+template<unsigned Stride, class V> SIMDPP_INL
+void i_load_strided_v(V& a, const char* p)
+{
+    v_load_strided<Stride>(a, p, strided_kind<Stride>());
+}
+
+// -----------------------------------------------------------------------------
+// Gathers are used for strides that can't be handled by shuffles. The masked
+// variants with zeroed source are used to break the dependency on the
+// previous value of the destination register.
+
+#if SIMDPP_USE_AVX2
+template<unsigned Stride> SIMDPP_INL
+void i_load_strided_v(uint32<4>& a, const char* p)
+{
+    if (Stride <= 4) {
+        v_load_strided<Stride>(a, p, strided_kind<Stride>());
+        return;
+    }
+    __m128i idx = _mm_setr_epi32(0, Stride, Stride*2, Stride*3);
+    a = _mm_mask_i32gather_epi32(_mm_setzero_si128(),
+                                 reinterpret_cast<const int*>(p), idx,
+                                 _mm_set1_epi32(-1), 4);
+}
+
+template<unsigned Stride> SIMDPP_INL
+void i_load_strided_v(uint32<8>& a, const char* p)
+{
+    if (Stride <= 4) {
+        v_load_strided<Stride>(a, p, strided_kind<Stride>());
+        return;
+    }
+    __m256i idx = _mm256_setr_epi32(0, Stride, Stride*2, Stride*3,
+                                    Stride*4, Stride*5, Stride*6, Stride*7);
+    a = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(),
+                                    reinterpret_cast<const int*>(p), idx,
+                                    _mm256_set1_epi32(-1), 4);
+}
+
+template<unsigned Stride> SIMDPP_INL
+void i_load_strided_v(uint64<2>& a, const char* p)
+{
+    if (Stride <= 4) {
+        v_load_strided<Stride>(a, p, strided_kind<Stride>());
+        return;
+    }
+    __m128i idx = _mm_setr_epi32(0, Stride, 0, 0);
+    a = _mm_mask_i32gather_epi64(_mm_setzero_si128(),
+                                 reinterpret_cast<const long long*>(p), idx,
+                                 _mm_set1_epi32(-1), 8);
+}
+
+template<unsigned Stride> SIMDPP_INL
+void i_load_strided_v(uint64<4>& a, const char* p)
+{
+    if (Stride <= 4) {
+        v_load_strided<Stride>(a, p, strided_kind<Stride>());
+        return;
+    }
+    __m128i idx = _mm_setr_epi32(0, Stride, Stride*2, Stride*3);
+    a = _mm256_mask_i32gather_epi64(_mm256_setzero_si256(),
+                                    reinterpret_cast<const long long*>(p), idx,
+                                    _mm256_set1_epi32(-1), 8);
+}
+
+template<unsigned Stride> SIMDPP_INL
+void i_load_strided_v(float32<4>& a, const char* p)
+{
+    if (Stride <= 4) {
+        v_load_strided<Stride>(a, p, strided_kind<Stride>());
+        return;
+    }
+    __m128i idx = _mm_setr_epi32(0, Stride, Stride*2, Stride*3);
+    a = _mm_mask_i32gather_ps(_mm_setzero_ps(),
+                              reinterpret_cast<const float*>(p), idx,
+                              _mm_castsi128_ps(_mm_set1_epi32(-1)), 4);
+}
+
+template<unsigned Stride> SIMDPP_INL
+void i_load_strided_v(float32<8>& a, const char* p)
+{
+    if (Stride <= 4) {
+        v_load_strided<Stride>(a, p, strided_kind<Stride>());
+        return;
+    }
+    __m256i idx = _mm256_setr_epi32(0, Stride, Stride*2, Stride*3,
+                                    Stride*4, Stride*5, Stride*6, Stride*7);
+    a = _mm256_mask_i32gather_ps(_mm256_setzero_ps(),
+                                 reinterpret_cast<const float*>(p), idx,
+                                 _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4);
+}
+
+template<unsigned Stride> SIMDPP_INL
+void i_load_strided_v(float64<2>& a, const char* p)
+{
+    if (Stride <= 4) {
+        v_load_strided<Stride>(a, p, strided_kind<Stride>());
+        return;
+    }
+    __m128i idx = _mm_setr_epi32(0, Stride, 0, 0);
+    a = _mm_mask_i32gather_pd(_mm_setzero_pd(),
+                              reinterpret_cast<const double*>(p), idx,
+                              _mm_castsi128_pd(_mm_set1_epi32(-1)), 8);
+}
+
+template<unsigned Stride> SIMDPP_INL
+void i_load_strided_v(float64<4>& a, const char* p)
+{
+    if (Stride <= 4) {
+        v_load_strided<Stride>(a, p, strided_kind<Stride>());
+        return;
+    }
+    __m128i idx = _mm_setr_epi32(0, Stride, Stride*2, Stride*3);
+    a = _mm256_mask_i32gather_pd(_mm256_setzero_pd(),
+                                 reinterpret_cast<const double*>(p), idx,
+                                 _mm256_castsi256_pd(_mm256_set1_epi32(-1)), 8);
+}
+#endif
+
+#if SIMDPP_USE_AVX512F
+template<unsigned Stride> SIMDPP_INL
+void i_load_strided_v(uint32<16>& a, const char* p)
+{
+    if (Stride <= 4) {
+        v_load_strided<Stride>(a, p, strided_kind<Stride>());
+        return;
+    }
+    __m512i idx = _mm512_setr_epi32(0, Stride, Stride*2, Stride*3,
+                                    Stride*4, Stride*5, Stride*6, Stride*7,
+                                    Stride*8, Stride*9, Stride*10, Stride*11,
+                                    Stride*12, Stride*13, Stride*14, Stride*15);
+    a = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xffff, idx, p, 4);
+}
+
+template<unsigned Stride> SIMDPP_INL
+void i_load_strided_v(uint64<8>& a, const char* p)
+{
+    if (Stride <= 4) {
+        v_load_strided<Stride>(a, p, strided_kind<Stride>());
+        return;
+    }
+    __m256i idx = _mm256_setr_epi32(0, Stride, Stride*2, Stride*3,
+                                    Stride*4, Stride*5, Stride*6, Stride*7);
+    a = _mm512_mask_i32gather_epi64(_mm512_setzero_si512(), 0xff, idx, p, 8);
+}
+
+template<unsigned Stride> SIMDPP_INL
+void i_load_strided_v(float32<16>& a, const char* p)
+{
+    if (Stride <= 4) {
+        v_load_strided<Stride>(a, p, strided_kind<Stride>());
+        return;
+    }
+    __m512i idx = _mm512_setr_epi32(0, Stride, Stride*2, Stride*3,
+                                    Stride*4, Stride*5, Stride*6, Stride*7,
+                                    Stride*8, Stride*9, Stride*10, Stride*11,
+                                    Stride*12, Stride*13, Stride*14, Stride*15);
+    a = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xffff, idx, p, 4);
+}
+
+template<unsigned Stride> SIMDPP_INL
+void i_load_strided_v(float64<8>& a, const char* p)
+{
+    if (Stride <= 4) {
+        v_load_strided<Stride>(a, p, strided_kind<Stride>());
+        return;
+    }
+    __m256i idx = _mm256_setr_epi32(0, Stride, Stride*2, Stride*3,
+                                    Stride*4, Stride*5, Stride*6, Stride*7);
+    a = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xff, idx, p, 8);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+template<unsigned Stride, class V> SIMDPP_INL
+void i_load_strided(V& a, const char* p)
+{
+    using E = typename V::element_type;
+    const unsigned step = V::base_length * Stride * sizeof(E);
+
+    for (unsigned i = 0; i < V::vec_length; ++i) {
+        i_load_strided_v<Stride>(a.vec(i), p);
+        p += step;
+    }
+}
+
+} // namespace insn
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,103 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_INSN_PREFIX_SUM_H
+#define LIBSIMDPP_SIMDPP_DETAIL_INSN_PREFIX_SUM_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/combine.h>
+#include <simdpp/core/f_add.h>
+#include <simdpp/core/i_add.h>
+#include <simdpp/core/move_r.h>
+#include <simdpp/core/splat.h>
+#include <simdpp/core/split.h>
+#include <simdpp/detail/traits.h>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+namespace insn {
+
+// Moves the elements of V to the right by S positions within each 128-bit block
+template<unsigned S, class V> SIMDPP_INL
+V i_prefix_sum_move(const V& a, std::integral_constant<unsigned, 1>) { return move16_r<S>(a); }
+
+template<unsigned S, class V> SIMDPP_INL
+V i_prefix_sum_move(const V& a, std::integral_constant<unsigned, 2>) { return move8_r<S>(a); }
+
+template<unsigned S, class V> SIMDPP_INL
+V i_prefix_sum_move(const V& a, std::integral_constant<unsigned, 4>) { return move4_r<S>(a); }
+
+template<unsigned S, class V> SIMDPP_INL
+V i_prefix_sum_move(const V& a, std::integral_constant<unsigned, 8>) { return move2_r<S>(a); }
+
+/*  Computes the prefix sums within each 128-bit block. After the step with
+    shift S each element holds the sum of up to 2*S preceding elements,
+    including itself.
+*/
+template<unsigned S, unsigned L>
+struct i_prefix_sum_block {
+    template<class V> SIMDPP_INL
+    static V run(V a)
+    {
+        using Size = std::integral_constant<unsigned, sizeof(typename V::element_type)>;
+        V t = i_prefix_sum_move<S>(a, Size());
+        a = add(a, t);
+        return i_prefix_sum_block<S*2, L>::run(a);
+    }
+};
+
+template<unsigned L>
+struct i_prefix_sum_block<L, L> {
+    template<class V> SIMDPP_INL
+    static V run(const V& a) { return a; }
+};
+
+/*  Adds the total of each 128-bit block to all following blocks. The vector
+    is split into halves recursively, thus log2(number of blocks) broadcasts
+    are needed.
+*/
+template<class V> SIMDPP_INL
+V i_prefix_sum_carry(const V& a, std::true_type /*single block*/)
+{
+    return a;
+}
+
+template<class V> SIMDPP_INL
+V i_prefix_sum_carry(const V& a, std::false_type /*single block*/)
+{
+    using E = typename V::element_type;
+    using H = typename vector_for_element<E, V::length / 2>::type;
+    using Single = std::integral_constant<bool, H::length_bytes == 16>;
+    H lo, hi;
+    split(a, lo, hi);
+    lo = i_prefix_sum_carry(lo, Single());
+    hi = i_prefix_sum_carry(hi, Single());
+    H c = splat<H::length - 1>(lo);
+    hi = add(hi, c);
+    return combine(lo, hi);
+}
+
+template<class V> SIMDPP_INL
+V i_prefix_sum(const V& a)
+{
+    const unsigned L = 16 / sizeof(typename V::element_type);
+    using Single = std::integral_constant<bool, V::length_bytes == 16>;
+    V r = i_prefix_sum_block<1, L>::run(a);
+    return i_prefix_sum_carry(r, Single());
+}
+
+} // namespace insn
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -0,0 +1,137 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_INSN_STORE_STRIDED_H
+#define LIBSIMDPP_SIMDPP_DETAIL_INSN_STORE_STRIDED_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/core/extract.h>
+#include <simdpp/detail/insn/store_u.h>
+#include <simdpp/detail/mem_block.h>
+#include <cstring>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+namespace insn {
+
+// Extracts successive vector lanes and stores them one by one. On NEON this
+// compiles to a chain of vst1q_lane instructions.
+template<unsigned Stride, unsigned I, unsigned L>
+struct store_strided_lanes {
+    template<class V> static SIMDPP_INL
+    void run(char* p, const V& a)
+    {
+        using E = typename V::element_type;
+        E el = extract<I>(a);
+        std::memcpy(p + I * Stride * sizeof(E), &el, sizeof(E));
+        store_strided_lanes<Stride, I+1, L>::run(p, a);
+    }
+};
+
+template<unsigned Stride, unsigned L>
+struct store_strided_lanes<Stride, L, L> {
+    template<class V> static SIMDPP_INL
+    void run(char*, const V&) {}
+};
+
+// Stores a single native vector. Only the addressed elements may be written,
+// thus shuffles can't be used for strides larger than one.
+template<unsigned Stride, class V> SIMDPP_INL
+void i_store_strided_v(char* p, const V& a)
+{
+    if (Stride == 1) {
+        i_store_u(p, a);
+        return;
+    }
+#if SIMDPP_USE_NEON
+    store_strided_lanes<Stride, 0, V::length>::run(p, a);
+#else
+    using E = typename V::element_type;
+    mem_block<V> r = a;
+    for (unsigned i = 0; i < V::length; ++i) {
+        std::memcpy(p + i * Stride * sizeof(E), &r[i], sizeof(E));
+    }
+#endif
+}
+
+#if SIMDPP_USE_AVX512F
+template<unsigned Stride> SIMDPP_INL
+void i_store_strided_v(char* p, const uint32<16>& a)
+{
+    if (Stride == 1) {
+        i_store_u(p, a);
+        return;
+    }
+    __m512i idx = _mm512_setr_epi32(0, Stride, Stride*2, Stride*3,
+                                    Stride*4, Stride*5, Stride*6, Stride*7,
+                                    Stride*8, Stride*9, Stride*10, Stride*11,
+                                    Stride*12, Stride*13, Stride*14, Stride*15);
+    _mm512_i32scatter_epi32(p, idx, a.native(), 4);
+}
+
+template<unsigned Stride> SIMDPP_INL
+void i_store_strided_v(char* p, const uint64<8>& a)
+{
+    if (Stride == 1) {
+        i_store_u(p, a);
+        return;
+    }
+    __m256i idx = _mm256_setr_epi32(0, Stride, Stride*2, Stride*3,
+                                    Stride*4, Stride*5, Stride*6, Stride*7);
+    _mm512_i32scatter_epi64(p, idx, a.native(), 8);
+}
+
+template<unsigned Stride> SIMDPP_INL
+void i_store_strided_v(char* p, const float32<16>& a)
+{
+    if (Stride == 1) {
+        i_store_u(p, a);
+        return;
+    }
+    __m512i idx = _mm512_setr_epi32(0, Stride, Stride*2, Stride*3,
+                                    Stride*4, Stride*5, Stride*6, Stride*7,
+                                    Stride*8, Stride*9, Stride*10, Stride*11,
+                                    Stride*12, Stride*13, Stride*14, Stride*15);
+    _mm512_i32scatter_ps(p, idx, a.native(), 4);
+}
+
+template<unsigned Stride> SIMDPP_INL
+void i_store_strided_v(char* p, const float64<8>& a)
+{
+    if (Stride == 1) {
+        i_store_u(p, a);
+        return;
+    }
+    __m256i idx = _mm256_setr_epi32(0, Stride, Stride*2, Stride*3,
+                                    Stride*4, Stride*5, Stride*6, Stride*7);
+    _mm512_i32scatter_pd(p, idx, a.native(), 8);
+}
+#endif
+
+template<unsigned Stride, class V> SIMDPP_INL
+void i_store_strided(char* p, const V& a)
+{
+    using E = typename V::element_type;
+    const unsigned step = V::base_length * Stride * sizeof(E);
+
+    for (unsigned i = 0; i < V::vec_length; ++i) {
+        i_store_strided_v<Stride>(p, a.vec(i));
+        p += step;
+    }
+}
+
+} // namespace insn
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
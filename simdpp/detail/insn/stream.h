@@ -15,6 +15,7 @@
 #include <simdpp/types.h>
 #include <simdpp/detail/align.h>
 #include <simdpp/core/store.h>
+#include <simdpp/detail/insn/load.h>
 #include <simdpp/detail/null/memory.h>
 
 namespace simdpp {
@@ -218,6 +219,197 @@ void i_stream(char* p, const V& ca)
     }
 }
 
+// -----------------------------------------------------------------------------
+
+static SIMDPP_INL
+void i_stream_load(uint8<16>& a, const char* p)
+{
+    p = detail::assume_aligned(p, 16);
+#if SIMDPP_USE_SSE4_1
+    a = _mm_stream_load_si128(reinterpret_cast<__m128i*>(const_cast<char*>(p)));
+#else
+    i_load(a, p);
+#endif
+}
+
+#if SIMDPP_USE_AVX2
+static SIMDPP_INL
+void i_stream_load(uint8<32>& a, const char* p)
+{
+    p = detail::assume_aligned(p, 32);
+    a = _mm256_stream_load_si256(reinterpret_cast<const __m256i*>(p));
+}
+#endif
+
+#if SIMDPP_USE_AVX512BW
+SIMDPP_INL void i_stream_load(uint8<64>& a, const char* p)
+{
+    p = detail::assume_aligned(p, 64);
+    a = _mm512_stream_load_si512(const_cast<char*>(p));
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+static SIMDPP_INL
+void i_stream_load(uint16<8>& a, const char* p)
+{
+    uint8<16> r; i_stream_load(r, p); a = r;
+}
+
+#if SIMDPP_USE_AVX2
+static SIMDPP_INL
+void i_stream_load(uint16<16>& a, const char* p)
+{
+    uint8<32> r; i_stream_load(r, p); a = r;
+}
+#endif
+
+#if SIMDPP_USE_AVX512BW
+SIMDPP_INL void i_stream_load(uint16<32>& a, const char* p)
+{
+    uint8<64> r; i_stream_load(r, p); a = r;
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+static SIMDPP_INL
+void i_stream_load(uint32<4>& a, const char* p)
+{
+    uint8<16> r; i_stream_load(r, p); a = r;
+}
+
+#if SIMDPP_USE_AVX2
+static SIMDPP_INL
+void i_stream_load(uint32<8>& a, const char* p)
+{
+    uint8<32> r; i_stream_load(r, p); a = r;
+}
+#endif
+
+#if SIMDPP_USE_AVX512F
+static SIMDPP_INL
+void i_stream_load(uint32<16>& a, const char* p)
+{
+    p = detail::assume_aligned(p, 64);
+    a = _mm512_stream_load_si512(const_cast<char*>(p));
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+static SIMDPP_INL
+void i_stream_load(uint64<2>& a, const char* p)
+{
+#if SIMDPP_USE_SSE4_1
+    uint8<16> r; i_stream_load(r, p); a = r;
+#else
+    i_load(a, p);
+#endif
+}
+
+#if SIMDPP_USE_AVX2
+static SIMDPP_INL
+void i_stream_load(uint64<4>& a, const char* p)
+{
+    uint8<32> r; i_stream_load(r, p); a = r;
+}
+#endif
+
+#if SIMDPP_USE_AVX512F
+static SIMDPP_INL
+void i_stream_load(uint64<8>& a, const char* p)
+{
+    p = detail::assume_aligned(p, 64);
+    a = _mm512_stream_load_si512(const_cast<char*>(p));
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+static SIMDPP_INL
+void i_stream_load(float32<4>& a, const char* p)
+{
+#if SIMDPP_USE_SSE4_1
+    uint8<16> r; i_stream_load(r, p);
+    a = _mm_castsi128_ps(r.native());
+#else
+    i_load(a, p);
+#endif
+}
+
+#if SIMDPP_USE_AVX
+static SIMDPP_INL
+void i_stream_load(float32<8>& a, const char* p)
+{
+#if SIMDPP_USE_AVX2
+    uint8<32> r; i_stream_load(r, p);
+    a = _mm256_castsi256_ps(r.native());
+#else
+    i_load(a, p);
+#endif
+}
+#endif
+
+#if SIMDPP_USE_AVX512F
+static SIMDPP_INL
+void i_stream_load(float32<16>& a, const char* p)
+{
+    p = detail::assume_aligned(p, 64);
+    a = _mm512_castsi512_ps(_mm512_stream_load_si512(const_cast<char*>(p)));
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+static SIMDPP_INL
+void i_stream_load(float64<2>& a, const char* p)
+{
+#if SIMDPP_USE_SSE4_1
+    uint8<16> r; i_stream_load(r, p);
+    a = _mm_castsi128_pd(r.native());
+#else
+    i_load(a, p);
+#endif
+}
+
+#if SIMDPP_USE_AVX
+static SIMDPP_INL
+void i_stream_load(float64<4>& a, const char* p)
+{
+#if SIMDPP_USE_AVX2
+    uint8<32> r; i_stream_load(r, p);
+    a = _mm256_castsi256_pd(r.native());
+#else
+    i_load(a, p);
+#endif
+}
+#endif
+
+#if SIMDPP_USE_AVX512F
+static SIMDPP_INL
+void i_stream_load(float64<8>& a, const char* p)
+{
+    p = detail::assume_aligned(p, 64);
+    a = _mm512_castsi512_pd(_mm512_stream_load_si512(const_cast<char*>(p)));
+}
+#endif
+
+// -----------------------------------------------------------------------------
+
+template<class V> SIMDPP_INL
+void i_stream_load(V& a, const char* p)
+{
+    const unsigned veclen = V::base_vector_type::length_bytes;
+
+    p = detail::assume_aligned(p, veclen);
+    for (unsigned i = 0; i < V::vec_length; ++i) {
+        i_stream_load(a.vec(i), p);
+        p += veclen;
+    }
+}
+
 } // namespace insn
 } // namespace detail
 } // namespace SIMDPP_ARCH_NAMESPACE
@@ -14,6 +14,9 @@
 #include <simdpp/core/permute_bytes16.h>
 #include <simdpp/core/zip_lo.h>
 #include <simdpp/core/zip_hi.h>
+#include <simdpp/detail/insn/combine.h>
+#include <simdpp/detail/insn/shuffle128.h>
+#include <simdpp/detail/insn/split.h>
 #include <simdpp/detail/null/transpose.h>
 #include <simdpp/detail/neon/shuffle.h>
 #include <simdpp/detail/vector_array_macros.h>
@@ -570,6 +573,278 @@ void i_transpose4(float32<N>& a0, float32<N>& a1, float32<N>& a2, float32<N>& a3
     SIMDPP_VEC_ARRAY_IMPL_REF4(float32<N>, i_transpose4, a0, a1, a2, a3);
 }
 
+
+// -----------------------------------------------------------------------------
+// Transposes of 128-bit blocks across vectors. These are the cross-lane steps
+// that complement the per-128-bit-lane transposes above.
+
+/*  Transposes a 2x2 matrix of 128-bit blocks within two 256-bit vectors.
+
+    @code
+    a0 = [ a0[0..127]   ; a1[0..127]   ]
+    a1 = [ a0[128..255] ; a1[128..255] ]
+    @endcode
+*/
+template<class V> SIMDPP_INL
+void v_transpose2_128_native(V& a0, V& a1)
+{
+    V b0;
+    b0 = shuffle1_128<0,0>(a0, a1);
+    a1 = shuffle1_128<1,1>(a0, a1);
+    a0 = b0;
+}
+
+static SIMDPP_INL
+void i_transpose2_128(uint32<8>& a0, uint32<8>& a1) { v_transpose2_128_native(a0, a1); }
+static SIMDPP_INL
+void i_transpose2_128(uint64<4>& a0, uint64<4>& a1) { v_transpose2_128_native(a0, a1); }
+static SIMDPP_INL
+void i_transpose2_128(float32<8>& a0, float32<8>& a1) { v_transpose2_128_native(a0, a1); }
+static SIMDPP_INL
+void i_transpose2_128(float64<4>& a0, float64<4>& a1) { v_transpose2_128_native(a0, a1); }
+
+/*  Transposes a 4x4 matrix of 128-bit blocks within four 512-bit vectors.
+
+    @code
+    a0 = [ a0[0..127]   ; a1[0..127]   ; a2[0..127]   ; a3[0..127]   ]
+    a1 = [ a0[128..255] ; a1[128..255] ; a2[128..255] ; a3[128..255] ]
+    a2 = [ a0[256..383] ; a1[256..383] ; a2[256..383] ; a3[256..383] ]
+    a3 = [ a0[384..511] ; a1[384..511] ; a2[384..511] ; a3[384..511] ]
+    @endcode
+*/
+#if SIMDPP_USE_AVX512F
+template<class V> SIMDPP_INL
+void v_transpose4_128_native(V& a0, V& a1, V& a2, V& a3)
+{
+    V b0, b1, b2, b3;
+    b0 = shuffle2_128<0,1,0,1>(a0, a1);
+    b1 = shuffle2_128<2,3,2,3>(a0, a1);
+    b2 = shuffle2_128<0,1,0,1>(a2, a3);
+    b3 = shuffle2_128<2,3,2,3>(a2, a3);
+    // [a0_0, a0_1, a1_0, a1_1]
+    // [a0_2, a0_3, a1_2, a1_3]
+    // [a2_0, a2_1, a3_0, a3_1]
+    // [a2_2, a2_3, a3_2, a3_3]
+    a0 = shuffle2_128<0,2,0,2>(b0, b2);
+    a1 = shuffle2_128<1,3,1,3>(b0, b2);
+    a2 = shuffle2_128<0,2,0,2>(b1, b3);
+    a3 = shuffle2_128<1,3,1,3>(b1, b3);
+}
+
+static SIMDPP_INL
+void i_transpose4_128(uint32<16>& a0, uint32<16>& a1, uint32<16>& a2, uint32<16>& a3)
+{
+    v_transpose4_128_native(a0, a1, a2, a3);
+}
+
+static SIMDPP_INL
+void i_transpose4_128(uint64<8>& a0, uint64<8>& a1, uint64<8>& a2, uint64<8>& a3)
+{
+    v_transpose4_128_native(a0, a1, a2, a3);
+}
+
+static SIMDPP_INL
+void i_transpose4_128(float32<16>& a0, float32<16>& a1, float32<16>& a2, float32<16>& a3)
+{
+    v_transpose4_128_native(a0, a1, a2, a3);
+}
+
+static SIMDPP_INL
+void i_transpose4_128(float64<8>& a0, float64<8>& a1, float64<8>& a2, float64<8>& a3)
+{
+    v_transpose4_128_native(a0, a1, a2, a3);
+}
+#endif
+
+/*  Generic version: the 4x4 block matrix is split into four 2x2 block
+    matrices, which are transposed within 256-bit halves. The off-diagonal
+    2x2 blocks are then swapped by recombining the halves.
+*/
+template<class V, class H> SIMDPP_INL
+void v_transpose4_128_split(V& a0, V& a1, V& a2, V& a3)
+{
+    H l0, h0, l1, h1, l2, h2, l3, h3;
+    i_split(a0, l0, h0);
+    i_split(a1, l1, h1);
+    i_split(a2, l2, h2);
+    i_split(a3, l3, h3);
+    i_transpose2_128(l0, l1);
+    i_transpose2_128(h0, h1);
+    i_transpose2_128(l2, l3);
+    i_transpose2_128(h2, h3);
+    a0 = i_combine<V>(l0, l2);
+    a1 = i_combine<V>(l1, l3);
+    a2 = i_combine<V>(h0, h2);
+    a3 = i_combine<V>(h1, h3);
+}
+
+template<unsigned N> SIMDPP_INL
+void i_transpose4_128(uint32<N>& a0, uint32<N>& a1, uint32<N>& a2, uint32<N>& a3)
+{
+    static_assert(N == 16, "Only 512-bit vectors are supported");
+    v_transpose4_128_split<uint32<N>, uint32<N/2>>(a0, a1, a2, a3);
+}
+
+template<unsigned N> SIMDPP_INL
+void i_transpose4_128(uint64<N>& a0, uint64<N>& a1, uint64<N>& a2, uint64<N>& a3)
+{
+    static_assert(N == 8, "Only 512-bit vectors are supported");
+    v_transpose4_128_split<uint64<N>, uint64<N/2>>(a0, a1, a2, a3);
+}
+
+template<unsigned N> SIMDPP_INL
+void i_transpose4_128(float32<N>& a0, float32<N>& a1, float32<N>& a2, float32<N>& a3)
+{
+    static_assert(N == 16, "Only 512-bit vectors are supported");
+    v_transpose4_128_split<float32<N>, float32<N/2>>(a0, a1, a2, a3);
+}
+
+template<unsigned N> SIMDPP_INL
+void i_transpose4_128(float64<N>& a0, float64<N>& a1, float64<N>& a2, float64<N>& a3)
+{
+    static_assert(N == 8, "Only 512-bit vectors are supported");
+    v_transpose4_128_split<float64<N>, float64<N/2>>(a0, a1, a2, a3);
+}
+
+// -----------------------------------------------------------------------------
+// Transposes of matrices that span whole 128-bit lanes. Each step interleaves
+// row i with row i+K/2; after log2(K) steps the bits of the row and column
+// indices have been rotated into each other, i.e. the matrix is transposed.
+// Since zips operate within 128-bit lanes, each lane of wider vectors holds an
+// independent matrix.
+
+template<class V> SIMDPP_INL
+void v_transpose8_zip_step(V (&a)[8])
+{
+    V b[8];
+    for (unsigned i = 0; i < 4; ++i) {
+        b[2*i] = zip8_lo(a[i], a[i+4]);
+        b[2*i+1] = zip8_hi(a[i], a[i+4]);
+    }
+    for (unsigned i = 0; i < 8; ++i) {
+        a[i] = b[i];
+    }
+}
+
+template<unsigned N> SIMDPP_INL
+void i_transpose8(uint16<N>& a0, uint16<N>& a1, uint16<N>& a2, uint16<N>& a3,
+                  uint16<N>& a4, uint16<N>& a5, uint16<N>& a6, uint16<N>& a7)
+{
+    uint16<N> a[8] = { a0, a1, a2, a3, a4, a5, a6, a7 };
+    v_transpose8_zip_step(a);
+    v_transpose8_zip_step(a);
+    v_transpose8_zip_step(a);
+    a0 = a[0];  a1 = a[1];  a2 = a[2];  a3 = a[3];
+    a4 = a[4];  a5 = a[5];  a6 = a[6];  a7 = a[7];
+}
+
+template<class V> SIMDPP_INL
+void v_transpose16_zip_step(V (&a)[16])
+{
+    V b[16];
+    for (unsigned i = 0; i < 8; ++i) {
+        b[2*i] = zip16_lo(a[i], a[i+8]);
+        b[2*i+1] = zip16_hi(a[i], a[i+8]);
+    }
+    for (unsigned i = 0; i < 16; ++i) {
+        a[i] = b[i];
+    }
+}
+
+template<unsigned N> SIMDPP_INL
+void i_transpose16(uint8<N> (&a)[16])
+{
+    v_transpose16_zip_step(a);
+    v_transpose16_zip_step(a);
+    v_transpose16_zip_step(a);
+    v_transpose16_zip_step(a);
+}
+
+// -----------------------------------------------------------------------------
+// 8x8 and 16x16 32-bit transposes. The rows are first transposed as 4x4
+// blocks within 128-bit lanes, then the 128-bit blocks are transposed across
+// the vectors.
+
+template<class V> SIMDPP_INL
+void v_transpose8x32(V& a0, V& a1, V& a2, V& a3,
+                     V& a4, V& a5, V& a6, V& a7)
+{
+    i_transpose4(a0, a1, a2, a3);
+    i_transpose4(a4, a5, a6, a7);
+    i_transpose2_128(a0, a4);
+    i_transpose2_128(a1, a5);
+    i_transpose2_128(a2, a6);
+    i_transpose2_128(a3, a7);
+}
+
+template<unsigned N> SIMDPP_INL
+void i_transpose8(uint32<N>& a0, uint32<N>& a1, uint32<N>& a2, uint32<N>& a3,
+                  uint32<N>& a4, uint32<N>& a5, uint32<N>& a6, uint32<N>& a7)
+{
+    v_transpose8x32(a0, a1, a2, a3, a4, a5, a6, a7);
+}
+
+template<unsigned N> SIMDPP_INL
+void i_transpose8(float32<N>& a0, float32<N>& a1, float32<N>& a2, float32<N>& a3,
+                  float32<N>& a4, float32<N>& a5, float32<N>& a6, float32<N>& a7)
+{
+    v_transpose8x32(a0, a1, a2, a3, a4, a5, a6, a7);
+}
+
+template<class V> SIMDPP_INL
+void v_transpose16x32(V (&a)[16])
+{
+    i_transpose4(a[0], a[1], a[2], a[3]);
+    i_transpose4(a[4], a[5], a[6], a[7]);
+    i_transpose4(a[8], a[9], a[10], a[11]);
+    i_transpose4(a[12], a[13], a[14], a[15]);
+    for (unsigned i = 0; i < 4; ++i) {
+        i_transpose4_128(a[i], a[i+4], a[i+8], a[i+12]);
+    }
+}
+
+template<unsigned N> SIMDPP_INL
+void i_transpose16(uint32<N> (&a)[16])
+{
+    v_transpose16x32(a);
+}
+
+template<unsigned N> SIMDPP_INL
+void i_transpose16(float32<N> (&a)[16])
+{
+    v_transpose16x32(a);
+}
+
+// -----------------------------------------------------------------------------
+// 8x8 64-bit transposes. The rows are first transposed as 2x2 blocks within
+// 128-bit lanes, then the 128-bit blocks are transposed across the vectors.
+
+template<class V> SIMDPP_INL
+void v_transpose8x64(V& a0, V& a1, V& a2, V& a3,
+                     V& a4, V& a5, V& a6, V& a7)
+{
+    i_transpose2(a0, a1);
+    i_transpose2(a2, a3);
+    i_transpose2(a4, a5);
+    i_transpose2(a6, a7);
+    i_transpose4_128(a0, a2, a4, a6);
+    i_transpose4_128(a1, a3, a5, a7);
+}
+
+template<unsigned N> SIMDPP_INL
+void i_transpose8(uint64<N>& a0, uint64<N>& a1, uint64<N>& a2, uint64<N>& a3,
+                  uint64<N>& a4, uint64<N>& a5, uint64<N>& a6, uint64<N>& a7)
+{
+    v_transpose8x64(a0, a1, a2, a3, a4, a5, a6, a7);
+}
+
+template<unsigned N> SIMDPP_INL
+void i_transpose8(float64<N>& a0, float64<N>& a1, float64<N>& a2, float64<N>& a3,
+                  float64<N>& a4, float64<N>& a5, float64<N>& a6, float64<N>& a7)
+{
+    v_transpose8x64(a0, a1, a2, a3, a4, a5, a6, a7);
+}
+
 // -----------------------------------------------------------------------------
 
 template<class V, class D> SIMDPP_INL
@@ -0,0 +1,344 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef LIBSIMDPP_SIMDPP_DETAIL_SOA_VECTOR_H
+#define LIBSIMDPP_SIMDPP_DETAIL_SOA_VECTOR_H
+
+#ifndef LIBSIMDPP_SIMD_H
+    #error "This file must be included through simd.h"
+#endif
+
+#include <simdpp/types.h>
+#include <simdpp/detail/insn/load.h>
+#include <simdpp/detail/insn/load_u.h>
+#include <simdpp/detail/insn/mem_pack.h>
+#include <simdpp/detail/insn/mem_unpack.h>
+#include <simdpp/detail/insn/store.h>
+#include <simdpp/detail/insn/store_u.h>
+#include <simdpp/detail/traits.h>
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+namespace simdpp {
+namespace SIMDPP_ARCH_NAMESPACE {
+namespace detail {
+
+// The largest size of the given types
+template<class... Fields> struct soa_max_size;
+template<> struct soa_max_size<> {
+    static const std::size_t value = 0;
+};
+template<class F, class... Rest> struct soa_max_size<F, Rest...> {
+    static const std::size_t value = sizeof(F) > soa_max_size<Rest...>::value ?
+                                     sizeof(F) : soa_max_size<Rest...>::value;
+};
+
+// The total size of the given types
+template<class... Fields> struct soa_sum_size;
+template<> struct soa_sum_size<> {
+    static const std::size_t value = 0;
+};
+template<class F, class... Rest> struct soa_sum_size<F, Rest...> {
+    static const std::size_t value = sizeof(F) + soa_sum_size<Rest...>::value;
+};
+
+// Whether all given types are 32-bit or 64-bit arithmetic types
+template<class... Fields> struct soa_valid_fields : std::true_type {};
+template<class F, class... Rest> struct soa_valid_fields<F, Rest...> :
+    std::integral_constant<bool, std::is_arithmetic<F>::value &&
+                                 (sizeof(F) == 4 || sizeof(F) == 8) &&
+                                 soa_valid_fields<Rest...>::value> {};
+
+// Whether all given types are the same
+template<class... Fields> struct soa_all_same : std::true_type {};
+template<class F, class G, class... Rest> struct soa_all_same<F, G, Rest...> :
+    std::integral_constant<bool, std::is_same<F, G>::value &&
+                                 soa_all_same<G, Rest...>::value> {};
+
+static constexpr std::size_t soa_round_up(std::size_t n, std::size_t align)
+{
+    return (n + align - 1) / align * align;
+}
+
+/*  The layout of a single block of B elements. The block stores B values of
+    each field contiguously one field after another. The values of each field
+    occupy a multiple of @a align bytes, so that the vectors of all fields are
+    aligned.
+*/
+template<unsigned B, class... Fields>
+struct soa_layout {
+    static const std::size_t align = B * (soa_max_size<Fields...>::value > 4 ?
+                                          soa_max_size<Fields...>::value : 4);
+
+    template<unsigned I, class... F> struct offset_impl;
+    template<class F, class... Rest> struct offset_impl<0, F, Rest...> {
+        static const std::size_t value = 0;
+        static const std::size_t aos_value = 0;
+    };
+    template<unsigned I, class F, class... Rest> struct offset_impl<I, F, Rest...> {
+        static const std::size_t value = soa_round_up(B * sizeof(F), align) +
+                                         offset_impl<I-1, Rest...>::value;
+        static const std::size_t aos_value = sizeof(F) +
+                                             offset_impl<I-1, Rest...>::aos_value;
+    };
+
+    // The offset of the I-th field within a block
+    template<unsigned I> struct offset {
+        static const std::size_t value = offset_impl<I, Fields...>::value;
+    };
+
+    // The offset of the I-th field within a packed record
+    template<unsigned I> struct aos_offset {
+        static const std::size_t value = offset_impl<I, Fields...>::aos_value;
+    };
+
+    using last_field = typename std::tuple_element<sizeof...(Fields) - 1,
+                                                   std::tuple<Fields...>>::type;
+
+    static const std::size_t block_bytes = offset<sizeof...(Fields)-1>::value +
+            soa_round_up(B * sizeof(last_field), align);
+
+    static const std::size_t record_bytes = soa_sum_size<Fields...>::value;
+};
+
+/*  Selects the implementation of the conversion from and to packed records:
+    0 - element by element, 2, 3, 4 - mem_unpack / mem_pack of that many
+    fields of the same type.
+*/
+template<class... Fields>
+using soa_aos_kind = std::integral_constant<unsigned,
+        (soa_all_same<Fields...>::value && sizeof...(Fields) >= 2 &&
+         sizeof...(Fields) <= 4) ? sizeof...(Fields) : 0>;
+
+// Copies the fields of n elements starting at element index i one by one
+template<class Layout, unsigned I, unsigned K>
+struct soa_aos_fields {
+    template<class Field, class... Rest> static SIMDPP_INL
+    void from_aos(char* block, const char* src, unsigned i, unsigned n)
+    {
+        char* d = block + Layout::template offset<I>::value;
+        const char* s = src + Layout::template aos_offset<I>::value;
+        for (unsigned j = i; j < i + n; ++j) {
+            std::memcpy(d + j * sizeof(Field),
+                        s + j * Layout::record_bytes, sizeof(Field));
+        }
+        soa_aos_fields<Layout, I+1, K>::template from_aos<Rest...>(block, src, i, n);
+    }
+
+    template<class Field, class... Rest> static SIMDPP_INL
+    void to_aos(char* dst, const char* block, unsigned i, unsigned n)
+    {
+        const char* s = block + Layout::template offset<I>::value;
+        char* d = dst + Layout::template aos_offset<I>::value;
+        for (unsigned j = i; j < i + n; ++j) {
+            std::memcpy(d + j * Layout::record_bytes,
+                        s + j * sizeof(Field), sizeof(Field));
+        }
+        soa_aos_fields<Layout, I+1, K>::template to_aos<Rest...>(dst, block, i, n);
+    }
+};
+
+template<class Layout, unsigned K>
+struct soa_aos_fields<Layout, K, K> {
+    template<class... F> static SIMDPP_INL
+    void from_aos(char*, const char*, unsigned, unsigned) {}
+    template<class... F> static SIMDPP_INL
+    void to_aos(char*, const char*, unsigned, unsigned) {}
+};
+
+// Converts the first n elements of a single block element by element
+template<class Layout, class... Fields> SIMDPP_INL
+void soa_from_aos_scalar(char* block, const char* src, unsigned n)
+{
+    soa_aos_fields<Layout, 0, sizeof...(Fields)>::template
+            from_aos<Fields...>(block, src, 0, n);
+}
+
+template<class Layout, class... Fields> SIMDPP_INL
+void soa_to_aos_scalar(char* dst, const char* block, unsigned n)
+{
+    soa_aos_fields<Layout, 0, sizeof...(Fields)>::template
+            to_aos<Fields...>(dst, block, 0, n);
+}
+
+// The vector type with B elements used for the shuffles. mem_unpack and
+// mem_pack support only unsigned integer and floating-point vectors.
+template<class T, unsigned B>
+using soa_shuffle_vector = typename vector_for_element<T, B, sizeof(T),
+        std::is_floating_point<T>::value,
+        std::is_floating_point<T>::value>::type;
+
+template<class Layout, unsigned B, class T, class... Rest> SIMDPP_INL
+void soa_from_aos_block(char* block, const char* src,
+                        std::integral_constant<unsigned, 2>)
+{
+    using V = typename soa_shuffle_vector<T, B>::base_vector_type;
+    const unsigned L = V::length_bytes;
+    const unsigned C = soa_round_up(B * sizeof(T), Layout::align);
+    for (unsigned j = 0; j < B * sizeof(T) / L; ++j) {
+        V a, b;
+        insn::i_load_u(a, src + j * L * 2);
+        insn::i_load_u(b, src + j * L * 2 + L);
+        insn::mem_unpack2(a, b);
+        insn::i_store(block + j * L, a);
+        insn::i_store(block + C + j * L, b);
+    }
+}
+
+template<class Layout, unsigned B, class T, class... Rest> SIMDPP_INL
+void soa_from_aos_block(char* block, const char* src,
+                        std::integral_constant<unsigned, 3>)
+{
+    using V = typename soa_shuffle_vector<T, B>::base_vector_type;
+    const unsigned L = V::length_bytes;
+    const unsigned C = soa_round_up(B * sizeof(T), Layout::align);
+    for (unsigned j = 0; j < B * sizeof(T) / L; ++j) {
+        V a, b, c;
+        insn::i_load_u(a, src + j * L * 3);
+        insn::i_load_u(b, src + j * L * 3 + L);
+        insn::i_load_u(c, src + j * L * 3 + L * 2);
+        insn::mem_unpack3(a, b, c);
+        insn::i_store(block + j * L, a);
+        insn::i_store(block + C + j * L, b);
+        insn::i_store(block + C * 2 + j * L, c);
+    }
+}
+
+template<class Layout, unsigned B, class T, class... Rest> SIMDPP_INL
+void soa_from_aos_block(char* block, const char* src,
+                        std::integral_constant<unsigned, 4>)
+{
+    using V = typename soa_shuffle_vector<T, B>::base_vector_type;
+    const unsigned L = V::length_bytes;
+    const unsigned C = soa_round_up(B * sizeof(T), Layout::align);
+    for (unsigned j = 0; j < B * sizeof(T) / L; ++j) {
+        V a, b, c, d;
+        insn::i_load_u(a, src + j * L * 4);
+        insn::i_load_u(b, src + j * L * 4 + L);
+        insn::i_load_u(c, src + j * L * 4 + L * 2);
+        insn::i_load_u(d, src + j * L * 4 + L * 3);
+        insn::mem_unpack4(a, b, c, d);
+        insn::i_store(block + j * L, a);
+        insn::i_store(block + C + j * L, b);
+        insn::i_store(block + C * 2 + j * L, c);
+        insn::i_store(block + C * 3 + j * L, d);
+    }
+}
+
+template<class Layout, unsigned B, class T, class... Rest> SIMDPP_INL
+void soa_to_aos_block(char* dst, const char* block,
+                      std::integral_constant<unsigned, 2>)
+{
+    using V = typename soa_shuffle_vector<T, B>::base_vector_type;
+    const unsigned L = V::length_bytes;
+    const unsigned C = soa_round_up(B * sizeof(T), Layout::align);
+    for (unsigned j = 0; j < B * sizeof(T) / L; ++j) {
+        V a, b;
+        insn::i_load(a, block + j * L);
+        insn::i_load(b, block + C + j * L);
+        insn::mem_pack2(a, b);
+        insn::i_store_u(dst + j * L * 2, a);
+        insn::i_store_u(dst + j * L * 2 + L, b);
+    }
+}
+
+template<class Layout, unsigned B, class T, class... Rest> SIMDPP_INL
+void soa_to_aos_block(char* dst, const char* block,
+                      std::integral_constant<unsigned, 3>)
+{
+    using V = typename soa_shuffle_vector<T, B>::base_vector_type;
+    const unsigned L = V::length_bytes;
+    const unsigned C = soa_round_up(B * sizeof(T), Layout::align);
+    for (unsigned j = 0; j < B * sizeof(T) / L; ++j) {
+        V a, b, c;
+        insn::i_load(a, block + j * L);
+        insn::i_load(b, block + C + j * L);
+        insn::i_load(c, block + C * 2 + j * L);
+        insn::mem_pack3(a, b, c);
+        insn::i_store_u(dst + j * L * 3, a);
+        insn::i_store_u(dst + j * L * 3 + L, b);
+        insn::i_store_u(dst + j * L * 3 + L * 2, c);
+    }
+}
+
+template<class Layout, unsigned B, class T, class... Rest> SIMDPP_INL
+void soa_to_aos_block(char* dst, const char* block,
+                      std::integral_constant<unsigned, 4>)
+{
+    using V = typename soa_shuffle_vector<T, B>::base_vector_type;
+    const unsigned L = V::length_bytes;
+    const unsigned C = soa_round_up(B * sizeof(T), Layout::align);
+    for (unsigned j = 0; j < B * sizeof(T) / L; ++j) {
+        V a, b, c, d;
+        insn::i_load(a, block + j * L);
+        insn::i_load(b, block + C + j * L);
+        insn::i_load(c, block + C * 2 + j * L);
+        insn::i_load(d, block + C * 3 + j * L);
+        insn::mem_pack4(a, b, c, d);
+        insn::i_store_u(dst + j * L * 4, a);
+        insn::i_store_u(dst + j * L * 4 + L, b);
+        insn::i_store_u(dst + j * L * 4 + L * 2, c);
+        insn::i_store_u(dst + j * L * 4 + L * 3, d);
+    }
+}
+
+template<class Layout, unsigned B, class... Fields> SIMDPP_INL
+void soa_from_aos_block(char* block, const char* src,
+                        std::integral_constant<unsigned, 0>)
+{
+    soa_from_aos_scalar<Layout, Fields...>(block, src, B);
+}
+
+template<class Layout, unsigned B, class... Fields> SIMDPP_INL
+void soa_to_aos_block(char* dst, const char* block,
+                      std::integral_constant<unsigned, 0>)
+{
+    soa_to_aos_scalar<Layout, Fields...>(dst, block, B);
+}
+
+/*  Converts n packed records to blocks of B elements. The last block may be
+    partial.
+*/
+template<unsigned B, class... Fields> SIMDPP_INL
+void soa_from_aos(char* blocks, const char* src, std::size_t n)
+{
+    using Layout = soa_layout<B, Fields...>;
+    using Kind = soa_aos_kind<Fields...>;
+
+    for (; n >= B; n -= B) {
+        soa_from_aos_block<Layout, B, Fields...>(blocks, src, Kind());
+        blocks += Layout::block_bytes;
+        src += B * Layout::record_bytes;
+    }
+    if (n > 0) {
+        soa_from_aos_scalar<Layout, Fields...>(blocks, src, n);
+    }
+}
+
+template<unsigned B, class... Fields> SIMDPP_INL
+void soa_to_aos(char* dst, const char* blocks, std::size_t n)
+{
+    using Layout = soa_layout<B, Fields...>;
+    using Kind = soa_aos_kind<Fields...>;
+
+    for (; n >= B; n -= B) {
+        soa_to_aos_block<Layout, B, Fields...>(dst, blocks, Kind());
+        blocks += Layout::block_bytes;
+        dst += B * Layout::record_bytes;
+    }
+    if (n > 0) {
+        soa_to_aos_scalar<Layout, Fields...>(dst, blocks, n);
+    }
+}
+
+} // namespace detail
+} // namespace SIMDPP_ARCH_NAMESPACE
+} // namespace simdpp
+
+#endif
@@ -13,6 +13,7 @@
 #endif
 
 #include <simdpp/types.h>
+#include <type_traits>
 
 namespace simdpp {
 namespace SIMDPP_ARCH_NAMESPACE {
@@ -49,6 +50,24 @@ struct remove_mask<mask_float32<N,E>> { using type = float32<N>; using expr = fl
 template<unsigned N, class E>
 struct remove_mask<mask_float64<N,E>> { using type = float64<N>; using expr = float64<N,E>; };
 
+/*  Returns the vector type with N elements of the scalar type T.
+*/
+template<class T, unsigned N, unsigned Size = sizeof(T),
+         bool Float = std::is_floating_point<T>::value,
+         bool Signed = std::is_signed<T>::value>
+struct vector_for_element;
+
+template<class T, unsigned N> struct vector_for_element<T,N,1,false,true>  { using type = int8<N>; };
+template<class T, unsigned N> struct vector_for_element<T,N,1,false,false> { using type = uint8<N>; };
+template<class T, unsigned N> struct vector_for_element<T,N,2,false,true>  { using type = int16<N>; };
+template<class T, unsigned N> struct vector_for_element<T,N,2,false,false> { using type = uint16<N>; };
+template<class T, unsigned N> struct vector_for_element<T,N,4,false,true>  { using type = int32<N>; };
+template<class T, unsigned N> struct vector_for_element<T,N,4,false,false> { using type = uint32<N>; };
+template<class T, unsigned N> struct vector_for_element<T,N,8,false,true>  { using type = int64<N>; };
+template<class T, unsigned N> struct vector_for_element<T,N,8,false,false> { using type = uint64<N>; };
+template<class T, unsigned N> struct vector_for_element<T,N,4,true,true>   { using type = float32<N>; };
+template<class T, unsigned N> struct vector_for_element<T,N,8,true,true>   { using type = float64<N>; };
+
 } // namespace detail
 } // namespace SIMDPP_ARCH_NAMESPACE
 } // namespace simdpp
@@ -22,8 +22,10 @@
 #include <simdpp/core/bit_andnot.h>
 #include <simdpp/core/bit_not.h>
 #include <simdpp/core/bit_or.h>
+#include <simdpp/core/bit_transpose.h>
 #include <simdpp/core/bit_xor.h>
 #include <simdpp/core/blend.h>
+#include <simdpp/core/bloom_filter.h>
 #include <simdpp/core/cache.h>
 #include <simdpp/core/cast.h>
 #include <simdpp/core/cmp_eq.h>
@@ -59,6 +61,7 @@
 #include <simdpp/core/f_sqrt.h>
 #include <simdpp/core/f_sub.h>
 #include <simdpp/core/f_trunc.h>
+#include <simdpp/core/flat_hash_map.h>
 #include <simdpp/core/for_each.h>
 #include <simdpp/core/i_abs.h>
 #include <simdpp/core/i_add.h>
@@ -88,6 +91,7 @@
 #include <simdpp/core/load_packed2.h>
 #include <simdpp/core/load_packed3.h>
 #include <simdpp/core/load_packed4.h>
+#include <simdpp/core/load_strided.h>
 #include <simdpp/core/load_splat.h>
 #include <simdpp/core/load_u.h>
 #include <simdpp/core/make_float.h>
@@ -100,12 +104,16 @@
 #include <simdpp/core/permute4.h>
 #include <simdpp/core/permute_bytes16.h>
 #include <simdpp/core/permute_zbytes16.h>
+#include <simdpp/core/prefix_sum.h>
 #include <simdpp/core/set_splat.h>
 #include <simdpp/core/shuffle1.h>
 #include <simdpp/core/shuffle2.h>
 #include <simdpp/core/shuffle4x2.h>
 #include <simdpp/core/shuffle_bytes16.h>
 #include <simdpp/core/shuffle_zbytes16.h>
+#include <simdpp/core/simd_arena.h>
+#include <simdpp/core/simd_vector.h>
+#include <simdpp/core/soa_vector.h>
 #include <simdpp/core/splat.h>
 #include <simdpp/core/splat_n.h>
 #include <simdpp/core/store_first.h>
@@ -115,6 +123,7 @@
 #include <simdpp/core/store_packed2.h>
 #include <simdpp/core/store_packed3.h>
 #include <simdpp/core/store_packed4.h>
+#include <simdpp/core/store_strided.h>
 #include <simdpp/core/store_u.h>
 #include <simdpp/core/stream.h>
 #include <simdpp/core/test_bits.h>
@@ -196,6 +205,24 @@
 #include <simdpp/operators/i_shift_r.h>
 #include <simdpp/operators/i_sub.h>
 
+#include <simdpp/algorithm/base64.h>
+#include <simdpp/algorithm/bitmap.h>
+#include <simdpp/algorithm/bitpack.h>
+#include <simdpp/algorithm/bitslice.h>
+#include <simdpp/algorithm/dict_decode.h>
+#include <simdpp/algorithm/filter_bitmap.h>
+#include <simdpp/algorithm/hash.h>
+#include <simdpp/algorithm/histogram.h>
+#include <simdpp/algorithm/lower_bound.h>
+#include <simdpp/algorithm/memory.h>
+#include <simdpp/algorithm/rle.h>
+#include <simdpp/algorithm/scan.h>
+#include <simdpp/algorithm/set_operations.h>
+#include <simdpp/algorithm/sort.h>
+#include <simdpp/algorithm/transpose_matrix.h>
+#include <simdpp/algorithm/utf8.h>
+#include <simdpp/algorithm/varint.h>
+
 /** @def SIMDPP_NO_DISPATCHER
     Disables internal dispatching functionality. If the internal dispathcher
     mechanism is not needed, the user can define the @c SIMDPP_NO_DISPATCHER.
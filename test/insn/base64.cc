@@ -0,0 +1,173 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+static std::string base64_test_encode(const std::vector<uint8_t>& in)
+{
+    const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string r;
+    uint32_t w = 0;
+    unsigned bits = 0;
+    for (uint8_t b : in) {
+        w = (w << 8) | b;
+        bits += 8;
+        while (bits >= 6) {
+            bits -= 6;
+            r.push_back(alphabet[(w >> bits) & 0x3f]);
+        }
+    }
+    if (bits > 0) {
+        r.push_back(alphabet[(w << (6 - bits)) & 0x3f]);
+    }
+    while (r.size() % 4 != 0) {
+        r.push_back('=');
+    }
+    return r;
+}
+
+static bool base64_test_is_alphabet(char c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+           (c >= '0' && c <= '9') || c == '+' || c == '/';
+}
+
+static bool hex_test_is_digit(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+void test_base64(TestResults& res, TestReporter& tr)
+{
+    using namespace simdpp;
+    (void) res;
+
+    uint32_t seed = 1;
+    auto next = [&]() {
+        seed = seed * 1103515245u + 12345u;
+        return seed >> 8;
+    };
+
+    const std::size_t lengths[] = { 0, 1, 2, 3, 4, 11, 12, 13, 24, 25, 47, 48, 49,
+                                    64, 95, 96, 97, 100, 200, 301 };
+    for (std::size_t len : lengths) {
+        std::vector<uint8_t> data(len);
+        for (auto& b : data) {
+            b = uint8_t(next());
+        }
+
+        // base64
+        std::string ref = base64_test_encode(data);
+        std::string enc(base64_encoded_size(len) + 1, '#');
+        TEST_EQUAL(tr, base64_encode(data.data(), len, &enc[0]), ref.size());
+        enc.resize(ref.size());
+        TEST_EQUAL(tr, enc == ref, true);
+
+        std::vector<uint8_t> dec(base64_decoded_max_size(ref.size()) + 1, 0x5a);
+        decode_result r = base64_decode(ref.data(), ref.size(), dec.data());
+        TEST_EQUAL(tr, r.valid, true);
+        TEST_EQUAL(tr, r.size, len);
+        TEST_EQUAL(tr, r.error_pos, ref.size());
+        TEST_EQUAL(tr, std::vector<uint8_t>(dec.begin(), dec.begin() + r.size) == data, true);
+
+        for (unsigned t = 0; t < 20 && !ref.empty(); ++t) {
+            std::string bad = ref;
+            std::size_t pos = next() % bad.size();
+            bad[pos] = char(next());
+            // replacing padding may expose the preceding padding as invalid
+            if (base64_test_is_alphabet(bad[pos]) || bad[pos] == '=' || ref[pos] == '=') {
+                continue;
+            }
+            r = base64_decode(bad.data(), bad.size(), dec.data());
+            TEST_EQUAL(tr, r.valid, false);
+            TEST_EQUAL(tr, r.error_pos, pos);
+            TEST_EQUAL(tr, r.size, pos / 4 * 3);
+        }
+        if (ref.size() >= 8) {
+            // padding in the middle of the input
+            std::string bad = ref;
+            bad[ref.size() - 5] = '=';
+            r = base64_decode(bad.data(), bad.size(), dec.data());
+            TEST_EQUAL(tr, r.valid, false);
+            TEST_EQUAL(tr, r.error_pos, ref.size() - 5);
+            // truncated input
+            r = base64_decode(ref.data(), ref.size() - 3, dec.data());
+            TEST_EQUAL(tr, r.valid, false);
+            TEST_EQUAL(tr, r.error_pos, ref.size() - 3);
+            TEST_EQUAL(tr, r.size, base64_decoded_max_size(ref.size() - 3));
+        }
+
+        // hexadecimal
+        std::string hex(2 * len + 1, '#');
+        TEST_EQUAL(tr, hex_encode(data.data(), len, &hex[0]), 2 * len);
+        hex.resize(2 * len);
+        bool hex_ok = true;
+        for (std::size_t i = 0; i < len; ++i) {
+            hex_ok &= hex[2*i] == "0123456789abcdef"[data[i] >> 4] &&
+                      hex[2*i+1] == "0123456789abcdef"[data[i] & 0xf];
+        }
+        TEST_EQUAL(tr, hex_ok, true);
+
+        std::string upper = hex;
+        for (auto& c : upper) {
+            if (c >= 'a' && c <= 'f' && next() % 2 == 0) {
+                c = char(c - 'a' + 'A');
+            }
+        }
+        std::vector<uint8_t> hdec(len + 1, 0x5a);
+        r = hex_decode(upper.data(), upper.size(), hdec.data());
+        TEST_EQUAL(tr, r.valid, true);
+        TEST_EQUAL(tr, r.size, len);
+        TEST_EQUAL(tr, std::vector<uint8_t>(hdec.begin(), hdec.begin() + r.size) == data, true);
+
+        for (unsigned t = 0; t < 20 && !hex.empty(); ++t) {
+            std::string bad = hex;
+            std::size_t pos = next() % bad.size();
+            bad[pos] = char(next());
+            if (hex_test_is_digit(bad[pos])) {
+                continue;
+            }
+            r = hex_decode(bad.data(), bad.size(), hdec.data());
+            TEST_EQUAL(tr, r.valid, false);
+            TEST_EQUAL(tr, r.error_pos, pos);
+            TEST_EQUAL(tr, r.size, pos / 2);
+        }
+        if (!hex.empty()) {
+            r = hex_decode(hex.data(), hex.size() - 1, hdec.data());
+            TEST_EQUAL(tr, r.valid, false);
+            TEST_EQUAL(tr, r.error_pos, hex.size() - 1);
+        }
+    }
+
+    const char* padded[] = { "QQ==", "QUI=", "QUJD", "QQ=A", "Q===", "====", "QUJDQQ==" };
+    const bool padded_valid[] = { true, true, true, false, false, false, true };
+    const std::size_t padded_size[] = { 1, 2, 3, 0, 0, 0, 4 };
+    const std::size_t padded_pos[] = { 4, 4, 4, 2, 1, 0, 8 };
+    const char* padded_data[] = { "A", "AB", "ABC", "", "", "", "ABCA" };
+    for (unsigned i = 0; i < 7; ++i) {
+        // the buffer holds a whole vector, only the decoded bytes are compared
+        std::vector<uint8_t> out(32);
+        std::size_t n = std::string(padded[i]).size();
+        decode_result r = base64_decode(padded[i], n, out.data());
+        TEST_EQUAL(tr, r.valid, padded_valid[i]);
+        TEST_EQUAL(tr, r.error_pos, padded_pos[i]);
+        if (r.valid) {
+            TEST_EQUAL(tr, r.size, padded_size[i]);
+            TEST_EQUAL_MEMORY(tr, reinterpret_cast<const uint8_t*>(padded_data[i]),
+                              out.data(), (unsigned) padded_size[i]);
+        }
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,125 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+static uint64_t bitmap_ref_popcount(uint64_t x)
+{
+    uint64_t r = 0;
+    for (; x != 0; x &= x - 1) {
+        ++r;
+    }
+    return r;
+}
+
+// The operations are passed as lambdas since they are always inlined
+template<class F, class C, class R>
+void test_bitmap_op(TestReporter& tr, F op, C op_count, R ref,
+                    const std::vector<uint64_t>& a, const std::vector<uint64_t>& b)
+{
+    std::size_t n = a.size();
+    std::vector<uint64_t> expected(n);
+    uint64_t expected_count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        expected[i] = ref(a[i], b[i]);
+        expected_count += bitmap_ref_popcount(expected[i]);
+    }
+
+    std::vector<uint64_t> out(n + 1, 0x5a5a);
+    op(a.data(), b.data(), out.data(), n);
+    TEST_EQUAL(tr, std::vector<uint64_t>(out.begin(), out.begin() + n) == expected, true);
+    TEST_EQUAL(tr, out[n], uint64_t(0x5a5a));
+
+    std::vector<uint64_t> out2(n + 1, 0x5a5a);
+    TEST_EQUAL(tr, op_count(a.data(), b.data(), out2.data(), n), expected_count);
+    TEST_EQUAL(tr, out2 == out, true);
+    TEST_EQUAL(tr, op_count(a.data(), b.data(), nullptr, n), expected_count);
+
+    // in-place operation
+    std::vector<uint64_t> inplace = a;
+    TEST_EQUAL(tr, op_count(inplace.data(), b.data(), inplace.data(), n), expected_count);
+    TEST_EQUAL(tr, inplace == expected, true);
+}
+
+void test_bitmap(TestResults& res, TestReporter& tr)
+{
+    using namespace simdpp;
+    (void) res;
+
+    const std::size_t sizes[] = { 0, 1, 3, 7, 8, 15, 16, 17, 31, 32, 33, 64,
+                                  127, 128, 129, 200, 1000 };
+    uint32_t seed = 1;
+    auto next = [&]() {
+        seed = seed * 1103515245u + 12345u;
+        uint64_t hi = seed;
+        seed = seed * 1103515245u + 12345u;
+        return (hi << 32) | seed;
+    };
+
+    for (std::size_t n : sizes) {
+        // random, sparse and dense bitmaps
+        for (unsigned kind = 0; kind < 3; ++kind) {
+            std::vector<uint64_t> a(n), b(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                a[i] = next();
+                b[i] = next();
+                if (kind == 1) {
+                    a[i] &= next() & next();
+                    b[i] &= next();
+                } else if (kind == 2) {
+                    a[i] = ~uint64_t(0);
+                    b[i] |= next();
+                }
+            }
+
+            test_bitmap_op(tr,
+                [](const uint64_t* x, const uint64_t* y, uint64_t* r, std::size_t k)
+                { bitmap_and(x, y, r, k); },
+                [](const uint64_t* x, const uint64_t* y, uint64_t* r, std::size_t k)
+                { return bitmap_and_count(x, y, r, k); },
+                [](uint64_t x, uint64_t y) { return x & y; }, a, b);
+            test_bitmap_op(tr,
+                [](const uint64_t* x, const uint64_t* y, uint64_t* r, std::size_t k)
+                { bitmap_or(x, y, r, k); },
+                [](const uint64_t* x, const uint64_t* y, uint64_t* r, std::size_t k)
+                { return bitmap_or_count(x, y, r, k); },
+                [](uint64_t x, uint64_t y) { return x | y; }, a, b);
+            test_bitmap_op(tr,
+                [](const uint64_t* x, const uint64_t* y, uint64_t* r, std::size_t k)
+                { bitmap_xor(x, y, r, k); },
+                [](const uint64_t* x, const uint64_t* y, uint64_t* r, std::size_t k)
+                { return bitmap_xor_count(x, y, r, k); },
+                [](uint64_t x, uint64_t y) { return x ^ y; }, a, b);
+            test_bitmap_op(tr,
+                [](const uint64_t* x, const uint64_t* y, uint64_t* r, std::size_t k)
+                { bitmap_andnot(x, y, r, k); },
+                [](const uint64_t* x, const uint64_t* y, uint64_t* r, std::size_t k)
+                { return bitmap_andnot_count(x, y, r, k); },
+                [](uint64_t x, uint64_t y) { return x & ~y; }, a, b);
+
+            uint64_t expected = 0;
+            for (uint64_t w : a) {
+                expected += bitmap_ref_popcount(w);
+            }
+            TEST_EQUAL(tr, bitmap_popcount(a.data(), n), expected);
+        }
+    }
+
+    // all bits set, which exercises the carries of all counters
+    std::vector<uint64_t> ones(1000, ~uint64_t(0));
+    TEST_EQUAL(tr, bitmap_popcount(ones.data(), ones.size()), uint64_t(64000));
+    TEST_EQUAL(tr, bitmap_and_count(ones.data(), ones.data(), nullptr, ones.size()),
+               uint64_t(64000));
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
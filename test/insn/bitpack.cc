@@ -0,0 +1,144 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+std::vector<uint32_t> bitpack_data(std::size_t n, uint32_t seed)
+{
+    std::vector<uint32_t> r;
+    for (std::size_t i = 0; i < n; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        r.push_back(seed ^ (seed << 13));
+    }
+    return r;
+}
+
+// Packs values to the stream bit by bit
+std::vector<uint8_t> bitpack_reference(const std::vector<uint32_t>& in, unsigned b)
+{
+    std::vector<uint8_t> r((in.size() * b + 7) / 8, 0);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        for (unsigned j = 0; j < b; ++j) {
+            std::size_t bit = i * b + j;
+            r[bit / 8] |= uint8_t(((in[i] >> j) & 1) << (bit % 8));
+        }
+    }
+    return r;
+}
+
+template<unsigned B>
+void test_bitpack_width(TestResultsSet& ts, TestReporter& tr)
+{
+    using namespace simdpp;
+
+    const std::size_t sizes[] = { 0, 1, 5, 31, 32, 33, 64, 100, 257 };
+    for (std::size_t n : sizes) {
+        std::vector<uint32_t> in = bitpack_data(n, B * 1000 + (uint32_t) n);
+        std::vector<uint32_t> masked = in;
+        for (uint32_t& x : masked) {
+            x = B == 32 ? x : x & ((uint32_t(1) << (B % 32)) - 1);
+        }
+        std::vector<uint8_t> expected = bitpack_reference(in, B);
+
+        // the output is exactly sized to detect overflows with sanitizers
+        std::vector<uint8_t> packed(bitpack_size(n, B));
+        TEST_EQUAL(tr, bitpack<B>(in.data(), n, packed.data()), packed.size());
+        TEST_EQUAL(tr, packed == expected, true);
+
+        std::vector<uint32_t> unpacked(n + 1, 0);
+        bitunpack<B>(packed.data(), n, unpacked.data());
+        unpacked.pop_back();
+        TEST_EQUAL(tr, unpacked == masked, true);
+
+        std::fill(unpacked.begin(), unpacked.end(), 0);
+        bitunpack(packed.data(), n, B, unpacked.data());
+        TEST_EQUAL(tr, unpacked == masked, true);
+        std::fill(packed.begin(), packed.end(), 0);
+        TEST_EQUAL(tr, bitpack(in.data(), n, B, packed.data()), packed.size());
+        TEST_EQUAL(tr, packed == expected, true);
+
+        if (n == 64) {
+            uint32<4> v = load_u(unpacked.data());
+            TEST_PUSH(ts, uint32<4>, v);
+        }
+    }
+}
+
+template<unsigned B>
+struct test_bitpack_widths {
+    static void run(TestResultsSet& ts, TestReporter& tr)
+    {
+        test_bitpack_width<B>(ts, tr);
+        test_bitpack_widths<B + 1>::run(ts, tr);
+    }
+};
+
+template<>
+struct test_bitpack_widths<33> {
+    static void run(TestResultsSet&, TestReporter&) {}
+};
+
+void test_for_delta(TestReporter& tr)
+{
+    using namespace simdpp;
+
+    const std::size_t sizes[] = { 0, 1, 7, 16, 17, 100, 1001 };
+    for (std::size_t n : sizes) {
+        std::vector<uint32_t> in;
+        uint32_t x = 1000000;
+        uint32_t seed = (uint32_t) n;
+        for (std::size_t i = 0; i < n; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            x += (seed >> 16) % 2001 - 1000;
+            in.push_back(x);
+        }
+        if (n > 3) {
+            in[2] = 0;
+            in[3] = 0xffffffff;
+        }
+
+        std::vector<uint32_t> enc(n), dec(n);
+        uint32_t base = for_encode(in.data(), n, enc.data());
+        uint32_t expected_base = n > 0 ? *std::min_element(in.begin(), in.end()) : 0;
+        TEST_EQUAL(tr, base, expected_base);
+        for (std::size_t i = 0; i < n; ++i) {
+            TEST_EQUAL(tr, enc[i], in[i] - base);
+        }
+        for_decode(enc.data(), n, base, dec.data());
+        TEST_EQUAL(tr, dec == in, true);
+
+        delta_encode(in.data(), n, enc.data(), 999);
+        uint32_t prev = 999;
+        for (std::size_t i = 0; i < n; ++i) {
+            int32_t d = int32_t(in[i] - prev);
+            uint32_t z = d >= 0 ? uint32_t(d) * 2 : uint32_t(-int64_t(d)) * 2 - 1;
+            TEST_EQUAL(tr, enc[i], z);
+            prev = in[i];
+        }
+        delta_decode(enc.data(), n, dec.data(), 999);
+        TEST_EQUAL(tr, dec == in, true);
+
+        // in place
+        delta_decode(enc.data(), n, enc.data(), 999);
+        TEST_EQUAL(tr, enc == in, true);
+    }
+}
+
+void test_bitpack(TestResults& res, TestReporter& tr)
+{
+    TestResultsSet& ts = res.new_results_set("bitpack");
+    test_bitpack_widths<0>::run(ts, tr);
+    test_for_delta(tr);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
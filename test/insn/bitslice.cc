@@ -0,0 +1,123 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+static uint64_t bitslice_test_random(uint32_t& seed)
+{
+    seed = seed * 1103515245u + 12345u;
+    uint64_t hi = seed;
+    seed = seed * 1103515245u + 12345u;
+    return (hi << 32) | seed;
+}
+
+template<unsigned N>
+void test_bit_transpose8x8_vec(TestReporter& tr, uint32_t& seed)
+{
+    using namespace simdpp;
+    for (unsigned t = 0; t < 20; ++t) {
+        uint8_t in[N], expected[N], out[N];
+        for (unsigned i = 0; i < N; ++i) {
+            in[i] = uint8_t(bitslice_test_random(seed) >> 24);
+        }
+        for (unsigned m = 0; m < N; m += 8) {
+            for (unsigned i = 0; i < 8; ++i) {
+                uint8_t r = 0;
+                for (unsigned j = 0; j < 8; ++j) {
+                    r |= ((in[m + j] >> i) & 1) << j;
+                }
+                expected[m + i] = r;
+            }
+        }
+        uint8<N> v = load_u(in);
+        store_u(out, bit_transpose8x8(v));
+        TEST_EQUAL_MEMORY(tr, out, expected, N);
+    }
+}
+
+template<class T, class F>
+void test_bit_transpose_square(TestReporter& tr, F transpose, uint32_t& seed)
+{
+    const unsigned W = sizeof(T) * 8;
+    for (unsigned t = 0; t < 20; ++t) {
+        std::vector<T> in(W), expected(W, 0), out(W);
+        for (unsigned i = 0; i < W; ++i) {
+            in[i] = T(bitslice_test_random(seed));
+        }
+        for (unsigned i = 0; i < W; ++i) {
+            for (unsigned j = 0; j < W; ++j) {
+                expected[i] |= T((in[j] >> i) & 1) << j;
+            }
+        }
+        transpose(in.data(), out.data());
+        TEST_EQUAL(tr, out == expected, true);
+        transpose(in.data(), in.data());
+        TEST_EQUAL(tr, in == expected, true);
+    }
+}
+
+template<class T>
+void test_bitslice_type(TestReporter& tr, uint32_t& seed)
+{
+    using namespace simdpp;
+    const unsigned W = sizeof(T) * 8;
+    const std::size_t sizes[] = { 0, 1, 15, 16, 17, 63, 64, 65, 128, 200 };
+    for (std::size_t n : sizes) {
+        std::vector<T> in(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            in[i] = T(bitslice_test_random(seed));
+        }
+        std::size_t words = bitslice_words(n);
+        std::vector<uint64_t> expected(words * W, 0);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (unsigned b = 0; b < W; ++b) {
+                uint64_t bit = (uint64_t(in[i]) >> b) & 1;
+                expected[b * words + i / 64] |= bit << (i % 64);
+            }
+        }
+        std::vector<uint64_t> planes(words * W, 0x5a5a);
+        bitslice(in.data(), n, planes.data());
+        TEST_EQUAL(tr, planes == expected, true);
+
+        std::vector<T> out(n + 1, T(0x5a));
+        unbitslice(planes.data(), n, out.data());
+        TEST_EQUAL(tr, std::vector<T>(out.begin(), out.begin() + n) == in, true);
+        TEST_EQUAL(tr, out[n], T(0x5a));
+    }
+}
+
+void test_bitslice(TestResults& res, TestReporter& tr)
+{
+    using namespace simdpp;
+    (void) res;
+    uint32_t seed = 1;
+
+    test_bit_transpose8x8_vec<16>(tr, seed);
+    test_bit_transpose8x8_vec<32>(tr, seed);
+    test_bit_transpose8x8_vec<64>(tr, seed);
+
+    test_bit_transpose_square<uint16_t>(tr, bit_transpose16x16, seed);
+    test_bit_transpose_square<uint32_t>(tr, bit_transpose32x32, seed);
+    test_bit_transpose_square<uint64_t>(tr, bit_transpose64x64, seed);
+
+    test_bitslice_type<uint8_t>(tr, seed);
+    test_bitslice_type<int8_t>(tr, seed);
+    test_bitslice_type<uint16_t>(tr, seed);
+    test_bitslice_type<int16_t>(tr, seed);
+    test_bitslice_type<uint32_t>(tr, seed);
+    test_bitslice_type<int32_t>(tr, seed);
+    test_bitslice_type<uint64_t>(tr, seed);
+    test_bitslice_type<int64_t>(tr, seed);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
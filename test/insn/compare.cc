@@ -32,10 +32,8 @@ void test_compare_n(TestResultsSet& tc)
     using int16_n = int16<B/2>;
     using uint32_n = uint32<B/4>;
     using int32_n = int32<B/4>;
-#if SIMDPP_USE_NULL || SIMDPP_USE_AVX2 || SIMDPP_USE_NEON64
     using uint64_n = uint64<B/8>;
     using int64_n = int64<B/8>;
-#endif
     using float32_n = float32<B/4>;
     using float64_n = float64<B/8>;
 
@@ -53,6 +51,8 @@ void test_compare_n(TestResultsSet& tc)
 
         TEST_COMPARE_TESTER_HELPER(tc, int8_n, sl, sr);
         TEST_COMPARE_TESTER_HELPER(tc, uint8_n, sl, sr);
+        TEST_PUSH_ARRAY_OP2(tc, int8_n, cmp_neq, sl, sr);
+        TEST_PUSH_ARRAY_OP2(tc, uint8_n, cmp_neq, sl, sr);
     }
 
     //int16_n
@@ -69,6 +69,8 @@ void test_compare_n(TestResultsSet& tc)
 
         TEST_COMPARE_TESTER_HELPER(tc, int16_n, sl, sr);
         TEST_COMPARE_TESTER_HELPER(tc, uint16_n, sl, sr);
+        TEST_PUSH_ARRAY_OP2(tc, int16_n, cmp_neq, sl, sr);
+        TEST_PUSH_ARRAY_OP2(tc, uint16_n, cmp_neq, sl, sr);
     }
 
     //int32_n
@@ -85,6 +87,24 @@ void test_compare_n(TestResultsSet& tc)
 
         TEST_COMPARE_TESTER_HELPER(tc, int32_n, sl, sr);
         TEST_COMPARE_TESTER_HELPER(tc, uint32_n, sl, sr);
+        TEST_PUSH_ARRAY_OP2(tc, int32_n, cmp_neq, sl, sr);
+        TEST_PUSH_ARRAY_OP2(tc, uint32_n, cmp_neq, sl, sr);
+    }
+
+    //int64_n equality. Some elements differ in only one of the 32-bit halves
+    {
+        TestData<uint64_n> sl;
+        sl.add(make_uint(0x1111111122222222, 0x1111111122222222, 0x1111111122222222, 0x1111111122222222));
+        sl.add(make_uint(0x0000000000000000, 0xffffffffffffffff, 0x00000000ffffffff, 0xffffffff00000000));
+
+        TestData<uint64_n> sr;
+        sr.add(make_uint(0x1111111122222222, 0x1111111133333333, 0x4444444422222222, 0x4444444433333333));
+        sr.add(make_uint(0xffffffff00000000, 0x00000000ffffffff, 0x00000000ffffffff, 0xffffffffffffffff));
+
+        TEST_PUSH_ARRAY_OP2(tc, int64_n, cmp_eq, sl, sr);
+        TEST_PUSH_ARRAY_OP2(tc, uint64_n, cmp_eq, sl, sr);
+        TEST_PUSH_ARRAY_OP2(tc, int64_n, cmp_neq, sl, sr);
+        TEST_PUSH_ARRAY_OP2(tc, uint64_n, cmp_neq, sl, sr);
     }
 
 #if SIMDPP_USE_NULL || SIMDPP_USE_AVX2 || SIMDPP_USE_NEON64
@@ -0,0 +1,354 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+template<class V>
+void test_simd_vector_type(TestResultsSet& ts, TestReporter& tr)
+{
+    using namespace simdpp;
+    using T = typename V::element_type;
+    using Vec = simd_vector<T>;
+    const unsigned N = V::length;
+
+    for (unsigned n : { 0u, 1u, N - 1, N, N + 1, 3*N + 2 }) {
+        Vec v(n);
+        for (unsigned i = 0; i < n; ++i) {
+            v[i] = T(i + 1);
+        }
+        TEST_EQUAL(tr, std::size_t(n), v.size());
+        TEST_EQUAL(tr, std::size_t(0), v.capacity() % Vec::pad_length);
+        TEST_EQUAL(tr, true, v.capacity() >= v.padded_size());
+        TEST_EQUAL(tr, std::uintptr_t(0), reinterpret_cast<std::uintptr_t>(v.data()) %
+                                Vec::vector_bytes);
+
+        // whole vectors can be accessed up to the end of the container
+        for (unsigned i = 0; i < n; i += N) {
+            V x = v.template load<N>(i);
+            x = add(x, x);
+            v.template store<N>(i, x);
+            TEST_PUSH(ts, V, x);
+        }
+        for (unsigned i = 0; i < n; ++i) {
+            TEST_EQUAL(tr, T((i + 1) * 2), v[i]);
+        }
+    }
+
+    // growth preserves the contents
+    Vec v;
+    for (unsigned i = 0; i < 5*N; ++i) {
+        v.push_back(T(i));
+    }
+    Vec c = v;
+    TEST_EQUAL(tr, std::size_t(5*N), c.size());
+    TEST_EQUAL(tr, T(5*N - 1), c.back());
+    Vec m = std::move(c);
+    TEST_EQUAL(tr, std::size_t(0), c.size());
+    TEST_EQUAL(tr, T(0), m.front());
+    m.resize(1);
+    m.resize(N, T(3));
+    TEST_EQUAL(tr, T(0), m[0]);
+    TEST_EQUAL(tr, T(3), m[N-1]);
+
+    Vec l = { T(1), T(2), T(3) };
+    TEST_EQUAL(tr, std::size_t(3), l.size());
+    TEST_EQUAL(tr, T(2), l[1]);
+}
+
+template<class T, class... Fields>
+void test_soa_vector_aos(TestReporter& tr)
+{
+    using namespace simdpp;
+    using Vec = soa_vector<Fields...>;
+    const unsigned B = Vec::block_length;
+    const unsigned K = Vec::num_fields;
+
+    for (unsigned n : { 0u, 1u, B - 1, B, B + 1, 3*B + 2 }) {
+        std::vector<T> aos(n * K), out(n * K);
+        for (unsigned i = 0; i < n * K; ++i) {
+            aos[i] = T(i + 1);
+        }
+        Vec v;
+        v.from_aos(aos.data(), n);
+        TEST_EQUAL(tr, std::size_t(n), v.size());
+        for (unsigned i = 0; i < n; ++i) {
+            TEST_EQUAL(tr, T(i*K + 1), v.template get<0>(i));
+            TEST_EQUAL(tr, T(i*K + K), v.template get<K-1>(i));
+        }
+        v.to_aos(out.data());
+        TEST_EQUAL(tr, true, aos == out);
+    }
+}
+
+// The block length depends on the instruction set, thus the results are not
+// compared between the architectures
+void test_soa_vector(TestReporter& tr)
+{
+    using namespace simdpp;
+    using Vec = soa_vector<float, int32_t, double>;
+    using F = Vec::vector_type<0>;
+    using I = Vec::vector_type<1>;
+    using D = Vec::vector_type<2>;
+    const unsigned B = Vec::block_length;
+
+    Vec v;
+    for (unsigned i = 0; i < 3*B + 1; ++i) {
+        v.push_back(float(i), int32_t(i * 2), double(i * 3));
+    }
+    TEST_EQUAL(tr, std::size_t(3*B + 1), v.size());
+    TEST_EQUAL(tr, std::size_t(4), v.num_blocks());
+    TEST_EQUAL(tr, 0.0f, v.get<0>(0));
+    TEST_EQUAL(tr, int32_t(6*B), v.get<1>(3*B));
+    TEST_EQUAL(tr, double(3*(3*B - 1)), v.get<2>(3*B - 1));
+
+    // whole blocks are accessed as vectors
+    for (unsigned b = 0; b < v.num_blocks(); ++b) {
+        F x = v.load<0>(b);
+        I y = v.load<1>(b);
+        D z = v.load<2>(b);
+        TEST_EQUAL(tr, std::uintptr_t(0),
+                   reinterpret_cast<std::uintptr_t>(v.block_data<2>(b)) %
+                        D::length_bytes);
+        v.store<0>(b, add(x, x));
+        v.store<1>(b, add(y, y));
+        v.store<2>(b, add(z, z));
+    }
+    for (unsigned i = 0; i < v.size(); ++i) {
+        TEST_EQUAL(tr, float(i * 2), v.get<0>(i));
+        TEST_EQUAL(tr, int32_t(i * 4), v.get<1>(i));
+        TEST_EQUAL(tr, double(i * 6), v.get<2>(i));
+    }
+
+    // copies and mixed-type packed records
+    Vec c = v;
+    std::vector<char> aos(c.size() * Vec::record_bytes);
+    c.to_aos(aos.data());
+    Vec m;
+    m.from_aos(aos.data(), c.size());
+    for (unsigned i = 0; i < v.size(); ++i) {
+        TEST_EQUAL(tr, v.get<0>(i), m.get<0>(i));
+        TEST_EQUAL(tr, v.get<1>(i), m.get<1>(i));
+        TEST_EQUAL(tr, v.get<2>(i), m.get<2>(i));
+    }
+    m.resize(B + 2);
+    TEST_EQUAL(tr, float((B + 1) * 2), m.get<0>(B + 1));
+    m.resize(2*B);
+    TEST_EQUAL(tr, 0.0f, m.get<0>(2*B - 1));
+    TEST_EQUAL(tr, 0.0, m.get<2>(2*B - 1));
+
+    test_soa_vector_aos<float, float, float>(tr);
+    test_soa_vector_aos<float, float, float, float>(tr);
+    test_soa_vector_aos<float, float, float, float, float>(tr);
+    test_soa_vector_aos<float, float, float, float, float, float>(tr);
+    test_soa_vector_aos<int32_t, int32_t, int32_t, int32_t>(tr);
+    test_soa_vector_aos<uint32_t, uint32_t, uint32_t>(tr);
+    test_soa_vector_aos<double, double, double>(tr);
+    test_soa_vector_aos<uint64_t, uint64_t, uint64_t, uint64_t, uint64_t>(tr);
+}
+
+template<class Key>
+void test_flat_hash_map_type(TestReporter& tr, unsigned n)
+{
+    using namespace simdpp;
+    using Map = flat_hash_map<Key, uint64_t>;
+
+    Map m;
+    std::unordered_map<Key, uint64_t> ref;
+    uint32_t seed = n;
+    std::vector<Key> keys;
+    for (unsigned i = 0; i < n; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        Key k = Key(seed % (n * 2 + 1));
+        keys.push_back(k);
+        bool inserted = ref.insert(std::make_pair(k, uint64_t(i))).second;
+        auto r = m.insert(k, uint64_t(i));
+        TEST_EQUAL(tr, inserted, r.second);
+        TEST_EQUAL(tr, ref[k], *r.first);
+    }
+    TEST_EQUAL(tr, ref.size(), m.size());
+    TEST_EQUAL(tr, std::size_t(0), m.capacity() % Map::group_size);
+
+    // erase every other key present and add new ones
+    for (unsigned i = 0; i < n; i += 2) {
+        TEST_EQUAL(tr, ref.erase(keys[i]) != 0, m.erase(keys[i]));
+    }
+    for (unsigned i = 0; i < n; ++i) {
+        Key k = Key(n * 2 + 1 + i);
+        keys.push_back(k);
+        m[k] += i;
+        ref[k] += i;
+    }
+    TEST_EQUAL(tr, ref.size(), m.size());
+
+    // keys that are both present and absent
+    for (unsigned i = 0; i < n * 4; ++i) {
+        keys.push_back(Key(i));
+    }
+    std::vector<const uint64_t*> found(keys.size());
+    m.find_many(keys.data(), keys.size(), found.data());
+    const Map& cm = m;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        auto it = ref.find(keys[i]);
+        bool present = it != ref.end();
+        TEST_EQUAL(tr, present, m.contains(keys[i]));
+        TEST_EQUAL(tr, present, found[i] != nullptr);
+        TEST_EQUAL(tr, present, cm.find(keys[i]) != nullptr);
+        if (present && found[i] != nullptr) {
+            TEST_EQUAL(tr, it->second, *found[i]);
+        }
+    }
+
+    Map copy = m;
+    Map moved = std::move(copy);
+    std::size_t count = 0;
+    moved.for_each([&](const Key& k, const uint64_t& v) {
+        count++;
+        auto it = ref.find(k);
+        TEST_EQUAL(tr, true, it != ref.end() && it->second == v);
+    });
+    TEST_EQUAL(tr, ref.size(), count);
+
+    moved.clear();
+    TEST_EQUAL(tr, std::size_t(0), moved.size());
+    TEST_EQUAL(tr, false, moved.contains(Key(1)));
+    TEST_EQUAL(tr, ref.size(), m.size());
+}
+
+void test_flat_hash_map(TestReporter& tr)
+{
+    using namespace simdpp;
+
+    test_flat_hash_map_type<uint32_t>(tr, 0);
+    test_flat_hash_map_type<uint32_t>(tr, 1);
+    test_flat_hash_map_type<uint32_t>(tr, 100);
+    test_flat_hash_map_type<uint32_t>(tr, 10000);
+    test_flat_hash_map_type<uint64_t>(tr, 3000);
+
+    // non-trivial element types
+    flat_hash_map<std::string, std::string> s;
+    for (unsigned i = 0; i < 500; ++i) {
+        s[std::to_string(i)] = std::string(i % 40, 'x');
+    }
+    for (unsigned i = 0; i < 500; i += 3) {
+        s.erase(std::to_string(i));
+    }
+    s.reserve(2000);
+    TEST_EQUAL(tr, std::size_t(333), s.size());
+    for (unsigned i = 0; i < 500; ++i) {
+        const std::string* v = s.find(std::to_string(i));
+        TEST_EQUAL(tr, i % 3 != 0, v != nullptr);
+        if (v != nullptr) {
+            TEST_EQUAL(tr, true, *v == std::string(i % 40, 'x'));
+        }
+    }
+}
+
+// The reference implementation of the split block Bloom filter of Apache Parquet
+void bloom_reference_insert(std::vector<uint32_t>& words, uint64_t h)
+{
+    static const uint32_t salt[8] = {
+        0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d,
+        0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31
+    };
+    uint64_t num_blocks = words.size() / 8;
+    uint64_t b = ((h >> 32) * num_blocks) >> 32;
+    for (unsigned i = 0; i < 8; ++i) {
+        uint32_t bit = (uint32_t(h) * salt[i]) >> 27;
+        words[b * 8 + i] |= uint32_t(1) << bit;
+    }
+}
+
+void test_bloom_filter_size(TestReporter& tr, std::size_t n, double fpp)
+{
+    using namespace simdpp;
+
+    std::vector<uint64_t> hashes, others;
+    for (std::size_t i = 0; i < n; ++i) {
+        hashes.push_back(hash64(uint64_t(i)));
+        others.push_back(hash64(uint64_t(i + n)));
+    }
+
+    bloom_filter filter(bloom_filter::optimal_num_bits(n, fpp));
+    TEST_EQUAL(tr, filter.num_bits() % bloom_filter::block_bits, std::size_t(0));
+    for (std::size_t i = 0; i < n / 2; ++i) {
+        filter.insert(hashes[i]);
+    }
+    filter.insert_many(hashes.data() + n / 2, n - n / 2);
+
+    std::vector<uint32_t> ref(filter.num_bits() / 32, 0);
+    for (uint64_t h : hashes) {
+        bloom_reference_insert(ref, h);
+    }
+    TEST_EQUAL_MEMORY(tr, ref.data(), filter.data(), (unsigned) ref.size());
+
+    // no false negatives
+    std::unique_ptr<bool[]> out(new bool[n + 1]);
+    filter.contains_many(hashes.data(), n, out.get());
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        found += filter.contains(hashes[i]) && out[i];
+    }
+    TEST_EQUAL(tr, found, n);
+
+    // false positives are rare and contains_many() agrees with contains()
+    filter.contains_many(others.data(), n, out.get());
+    std::size_t positives = 0, mismatches = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        positives += out[i];
+        mismatches += out[i] != filter.contains(others[i]);
+    }
+    TEST_EQUAL(tr, mismatches, std::size_t(0));
+    TEST_EQUAL(tr, positives <= fpp * 2 * n + 2, true);
+
+    filter.clear();
+    TEST_EQUAL(tr, filter.contains(hashes[0]), false);
+}
+
+void test_bloom_filter(TestReporter& tr)
+{
+    using namespace simdpp;
+
+    test_bloom_filter_size(tr, 1, 0.01);
+    test_bloom_filter_size(tr, 37, 0.01);
+    test_bloom_filter_size(tr, 1000, 0.01);
+    test_bloom_filter_size(tr, 20000, 0.001);
+
+    bloom_filter a(1000), b(1000);
+    a.insert(hash64(1));
+    b.insert(hash64(2));
+    a.merge(b);
+    TEST_EQUAL(tr, a.contains(hash64(1)) && a.contains(hash64(2)), true);
+}
+
+void test_containers(TestResults& res, TestReporter& tr)
+{
+    using namespace simdpp;
+    TestResultsSet& ts = res.new_results_set("simd_vector");
+    test_simd_vector_type<uint8<16>>(ts, tr);
+    test_simd_vector_type<int16<8>>(ts, tr);
+    test_simd_vector_type<uint32<4>>(ts, tr);
+    test_simd_vector_type<int32<8>>(ts, tr);
+    test_simd_vector_type<uint64<2>>(ts, tr);
+    test_simd_vector_type<float32<4>>(ts, tr);
+    test_simd_vector_type<float32<16>>(ts, tr);
+    test_simd_vector_type<float64<4>>(ts, tr);
+
+    test_soa_vector(tr);
+    test_flat_hash_map(tr);
+    test_bloom_filter(tr);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
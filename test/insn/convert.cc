@@ -144,6 +144,18 @@ void test_convert_int32_n(TestResultsSet& ts)
     s.add(make_int(-c_2_pow_25 + 1, -c_2_pow_25));
     s.add(make_int(-c_2_pow_25 - 1, -c_2_pow_25 - 2));
 
+    // The elements are distinct across the whole vector, so that misordered
+    // groups of elements in the results are detected
+    uint32_t distinct0[B], distinct1[B];
+    for (unsigned i = 0; i < B; ++i) {
+        distinct0[i] = i * 0x01010101;
+        distinct1[i] = 0xfedc0080 + i * 0x00010003;
+    }
+    int32_4n d0 = load_u(distinct0);
+    int32_4n d1 = load_u(distinct1);
+    s.add(d0);
+    s.add(d1);
+
     TEST_PUSH_ARRAY_OP1_T(ts,  int8_n,     int32_4n, to_int8, s);
     TEST_PUSH_ARRAY_OP1_T(ts,  int8_n,    uint32_4n, to_int8, s);
     TEST_PUSH_ARRAY_OP1_T(ts, uint8_n,     int32_4n, to_uint8, s);
@@ -0,0 +1,63 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+template<class T, class I>
+void test_dict_decode_type(TestReporter& tr)
+{
+    using namespace simdpp;
+
+    // the small sizes exercise the lookup table paths
+    const std::size_t dict_sizes[] = { 1, 2, 3, 4, 7, 8, 16, 17, 255, 1000 };
+    const std::size_t sizes[] = { 0, 1, 5, 16, 17, 31, 64, 100, 1001 };
+    for (std::size_t dict_size : dict_sizes) {
+        if (dict_size > (std::size_t(1) << (sizeof(I) * 8))) {
+            continue;
+        }
+        std::vector<T> dict;
+        for (std::size_t i = 0; i < dict_size; ++i) {
+            dict.push_back(T(i * 37 + 11 + (i << (sizeof(T) * 4))));
+        }
+        for (std::size_t n : sizes) {
+            std::vector<I> idx;
+            uint32_t seed = uint32_t(n * dict_size);
+            for (std::size_t i = 0; i < n; ++i) {
+                seed = seed * 1103515245u + 12345u;
+                idx.push_back(I((seed >> 8) % dict_size));
+            }
+            std::vector<T> out(n);
+            dict_decode(idx.data(), n, dict.data(), dict_size, out.data());
+            for (std::size_t i = 0; i < n; ++i) {
+                TEST_EQUAL(tr, out[i], dict[idx[i]]);
+            }
+        }
+    }
+}
+
+void test_dict_decode(TestResults& res, TestReporter& tr)
+{
+    (void) res;
+    test_dict_decode_type<uint8_t, uint8_t>(tr);
+    test_dict_decode_type<uint16_t, uint8_t>(tr);
+    test_dict_decode_type<uint32_t, uint8_t>(tr);
+    test_dict_decode_type<float, uint8_t>(tr);
+    test_dict_decode_type<uint64_t, uint8_t>(tr);
+    test_dict_decode_type<uint16_t, uint16_t>(tr);
+    test_dict_decode_type<uint32_t, uint32_t>(tr);
+    test_dict_decode_type<float, uint32_t>(tr);
+    test_dict_decode_type<double, uint32_t>(tr);
+    test_dict_decode_type<uint64_t, uint32_t>(tr);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,125 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+template<class T, class P>
+std::vector<uint64_t> filter_reference(const std::vector<T>& in, const P& pred,
+                                       std::vector<uint64_t> bitmap,
+                                       simdpp::filter_combine op)
+{
+    for (std::size_t i = 0; i < bitmap.size() * 64; ++i) {
+        uint64_t bit = i < in.size() && pred(in[i]) ? 1 : 0;
+        uint64_t& w = bitmap[i / 64];
+        uint64_t m = uint64_t(1) << (i % 64);
+        switch (op) {
+        case simdpp::filter_combine::replace: w = (w & ~m) | (bit << (i % 64)); break;
+        case simdpp::filter_combine::intersect: if (!bit) w &= ~m; break;
+        case simdpp::filter_combine::unite: w |= bit << (i % 64); break;
+        }
+    }
+    return bitmap;
+}
+
+template<class T>
+void test_filter_bitmap_type(TestReporter& tr)
+{
+    using namespace simdpp;
+    using L = std::numeric_limits<T>;
+
+    std::vector<T> values = { T(0), T(1), T(2), T(3), T(5), T(7), T(100),
+                              L::max(), L::lowest(), T(L::max() - 1),
+                              T(L::lowest() + 1) };
+    if (L::is_signed) {
+        values.push_back(T(-1));
+        values.push_back(T(-3));
+    }
+
+    const std::size_t sizes[] = { 0, 1, 63, 64, 65, 128, 200 };
+    const filter_combine ops[] = { filter_combine::replace, filter_combine::intersect,
+                                   filter_combine::unite };
+    for (std::size_t n : sizes) {
+        std::vector<T> in;
+        uint32_t seed = uint32_t(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            in.push_back(values[(seed >> 16) % values.size()]);
+        }
+        std::vector<uint64_t> init(filter_bitmap_words(n));
+        for (uint64_t& w : init) {
+            seed = seed * 1103515245u + 12345u;
+            w = (uint64_t(seed) << 32) | (seed * 2654435761u);
+        }
+
+        for (filter_combine op : ops) {
+            const T bounds[][2] = { { T(1), T(7) }, { L::lowest(), L::max() },
+                                    { T(5), T(2) }, { T(3), T(3) },
+                                    { T(L::is_signed ? -3 : 0), T(100) } };
+            for (const auto& b : bounds) {
+                T lo = b[0], hi = b[1];
+                std::vector<uint64_t> out = init;
+                filter_range(in.data(), n, lo, hi, out.data(), op);
+                auto pred = [=](T x) { return lo <= x && x < hi; };
+                TEST_EQUAL(tr, out == filter_reference(in, pred, init, op), true);
+            }
+
+            for (T c : { T(2), L::max(), L::lowest() }) {
+                std::vector<uint64_t> out = init;
+                filter_eq(in.data(), n, c, out.data(), op);
+                auto pred = [=](T x) { return x == c; };
+                TEST_EQUAL(tr, out == filter_reference(in, pred, init, op), true);
+            }
+
+            std::vector<T> set = { T(3), L::max(), T(100), T(0) };
+            for (std::size_t size = 0; size <= set.size(); ++size) {
+                std::vector<uint64_t> out = init;
+                filter_in(in.data(), n, set.data(), size, out.data(), op);
+                auto pred = [&](T x) {
+                    return std::find(set.begin(), set.begin() + size, x) != set.begin() + size;
+                };
+                TEST_EQUAL(tr, out == filter_reference(in, pred, init, op), true);
+            }
+        }
+    }
+}
+
+void test_filter_bitmap_nan(TestReporter& tr)
+{
+    using namespace simdpp;
+    std::vector<float> in(100, 1.0f);
+    in[3] = std::numeric_limits<float>::quiet_NaN();
+    in[70] = std::numeric_limits<float>::quiet_NaN();
+    std::vector<uint64_t> out(2);
+    filter_range(in.data(), in.size(), 0.0f, 2.0f, out.data());
+    TEST_EQUAL(tr, out[0], ~(uint64_t(1) << 3));
+    TEST_EQUAL(tr, out[1], ((uint64_t(1) << 36) - 1) & ~(uint64_t(1) << 6));
+}
+
+void test_filter_bitmap(TestResults& res, TestReporter& tr)
+{
+    (void) res;
+    test_filter_bitmap_type<int8_t>(tr);
+    test_filter_bitmap_type<uint8_t>(tr);
+    test_filter_bitmap_type<int16_t>(tr);
+    test_filter_bitmap_type<uint16_t>(tr);
+    test_filter_bitmap_type<int32_t>(tr);
+    test_filter_bitmap_type<uint32_t>(tr);
+    test_filter_bitmap_type<int64_t>(tr);
+    test_filter_bitmap_type<uint64_t>(tr);
+    test_filter_bitmap_type<float>(tr);
+    test_filter_bitmap_type<double>(tr);
+    test_filter_bitmap_nan(tr);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,133 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+template<unsigned N>
+void test_hash32_type(TestResultsSet& ts, TestReporter& tr)
+{
+    using namespace simdpp;
+    using V = uint32<N>;
+
+    uint32_t a[N], r[N];
+    uint32_t seed = 12345;
+    for (unsigned k = 0; k < 8; ++k) {
+        for (unsigned i = 0; i < N; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            a[i] = seed ^ (seed << 7);
+        }
+        a[0] = 0;
+        a[N - 1] = 0xffffffff;
+
+        V v = load_u(a);
+        v = hash32(v);
+        TEST_PUSH(ts, V, v);
+        store_u(r, v);
+        for (unsigned i = 0; i < N; ++i) {
+            TEST_EQUAL(tr, r[i], hash32(a[i]));
+        }
+    }
+}
+
+template<unsigned N>
+void test_hash64_type(TestResultsSet& ts, TestReporter& tr)
+{
+    using namespace simdpp;
+    using V = uint64<N>;
+
+    uint64_t a[N], r[N];
+    uint64_t seed = 12345;
+    for (unsigned k = 0; k < 8; ++k) {
+        for (unsigned i = 0; i < N; ++i) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            a[i] = seed;
+        }
+        a[0] = 0;
+        a[N - 1] = 0xffffffffffffffffull;
+
+        V v = load_u(a);
+        v = hash64(v);
+        TEST_PUSH(ts, V, v);
+        store_u(r, v);
+        for (unsigned i = 0; i < N; ++i) {
+            TEST_EQUAL(tr, r[i], hash64(a[i]));
+        }
+    }
+}
+
+void test_hash_bytes_batch(TestReporter& tr, std::size_t max_len)
+{
+    using namespace simdpp;
+
+    std::vector<std::string> keys;
+    uint32_t seed = 7 + (uint32_t) max_len;
+    for (unsigned k = 0; k < 77; ++k) {
+        seed = seed * 1103515245u + 12345u;
+        std::size_t len = (seed >> 16) % (max_len + 1);
+        std::string s;
+        for (std::size_t i = 0; i < len; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            s.push_back((char) (seed >> 16));
+        }
+        keys.push_back(s);
+    }
+
+    std::vector<const char*> ptrs;
+    std::vector<std::size_t> lens;
+    for (const std::string& s : keys) {
+        ptrs.push_back(s.data());
+        lens.push_back(s.size());
+    }
+
+    for (std::size_t n = 0; n <= keys.size(); n += 11) {
+        std::vector<uint32_t> expected, result(n + 1, 0);
+        for (std::size_t i = 0; i < n; ++i) {
+            expected.push_back(hash_bytes(ptrs[i], lens[i], 31));
+        }
+        expected.push_back(0);
+        hash_bytes_batch(ptrs.data(), lens.data(), n, result.data(), 31);
+        TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) n + 1);
+    }
+}
+
+void test_hash(TestResults& res, TestReporter& tr)
+{
+    using namespace simdpp;
+
+    TestResultsSet& ts = res.new_results_set("hash");
+
+    test_hash32_type<4>(ts, tr);
+    test_hash32_type<8>(ts, tr);
+    test_hash32_type<16>(ts, tr);
+    test_hash64_type<2>(ts, tr);
+    test_hash64_type<4>(ts, tr);
+    test_hash64_type<8>(ts, tr);
+
+    // reference values of MurmurHash3
+    TEST_EQUAL(tr, hash32(1), 0x514e28b7u);
+    TEST_EQUAL(tr, hash64(1), 0xb456bcfc34c2cb2cull);
+    TEST_EQUAL(tr, hash_bytes("", 0), 0u);
+    TEST_EQUAL(tr, hash_bytes("", 0, 1), 0x514e28b7u);
+    TEST_EQUAL(tr, hash_bytes("hello", 5), 0x248bfa47u);
+    TEST_EQUAL(tr, hash_bytes("Hello, world!", 13, 1234), 0xfaf6cdb3u);
+    const char* fox = "The quick brown fox jumps over the lazy dog";
+    TEST_EQUAL(tr, hash_bytes(fox, std::strlen(fox)), 0x2e4ff723u);
+
+    test_hash_bytes_batch(tr, 3);
+    test_hash_bytes_batch(tr, 16);
+    test_hash_bytes_batch(tr, 100);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
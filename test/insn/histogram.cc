@@ -0,0 +1,104 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Keys are drawn from the first num_used of num_bins bins. Runs of equal
+// keys are generated if max_run is larger than one.
+template<class K>
+std::vector<K> histogram_keys(std::size_t n, std::size_t num_used, unsigned max_run)
+{
+    std::vector<K> keys;
+    uint32_t seed = 7 + (uint32_t) n;
+    while (keys.size() < n) {
+        seed = seed * 1103515245u + 12345u;
+        K k = K((seed >> 8) % num_used);
+        unsigned run = 1 + (seed >> 24) % max_run;
+        for (unsigned r = 0; r < run && keys.size() < n; ++r) {
+            keys.push_back(k);
+        }
+    }
+    return keys;
+}
+
+template<class K>
+void test_histogram_type(TestReporter& tr, std::size_t num_bins)
+{
+    using namespace simdpp;
+
+    const std::size_t sizes[] = { 0, 1, 3, 100, 1023, 5000, 70001 };
+    for (std::size_t n : sizes) {
+        for (unsigned max_run : { 1u, 40u }) {
+            std::vector<K> keys = histogram_keys<K>(n, num_bins, max_run);
+
+            // the counts are added to the existing values
+            std::vector<uint32_t> expected(num_bins, 3), result(num_bins, 3);
+            for (K k : keys) {
+                expected[k]++;
+            }
+            histogram(keys.data(), n, result.data(), num_bins);
+            TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) num_bins);
+        }
+    }
+}
+
+template<class K, class T>
+void test_group_sum_type(TestReporter& tr, std::size_t num_groups)
+{
+    using namespace simdpp;
+
+    const std::size_t sizes[] = { 0, 2, 99, 4000, 33333 };
+    for (std::size_t n : sizes) {
+        std::vector<K> keys = histogram_keys<K>(n, num_groups, 5);
+        std::vector<T> values;
+        for (std::size_t i = 0; i < n; ++i) {
+            // small integers are summed exactly in any order
+            values.push_back(T(int(i % 201) - 100));
+        }
+        std::vector<T> expected(num_groups, T(1)), result(num_groups, T(1));
+        for (std::size_t i = 0; i < n; ++i) {
+            expected[keys[i]] += values[i];
+        }
+        group_sum(keys.data(), values.data(), n, result.data(), num_groups);
+        TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) num_groups);
+    }
+}
+
+void test_histogram(TestResults& res, TestReporter& tr)
+{
+    using namespace simdpp;
+    (void) res;
+
+    test_histogram_type<uint8_t>(tr, 256);
+    test_histogram_type<uint8_t>(tr, 13);
+    test_histogram_type<uint16_t>(tr, 1000);
+    test_histogram_type<uint16_t>(tr, 65536);
+    test_histogram_type<uint32_t>(tr, 37);
+    test_histogram_type<uint32_t>(tr, 4096);
+
+    std::vector<uint8_t> bytes = histogram_keys<uint8_t>(10000, 256, 3);
+    std::vector<uint32_t> expected(256, 0), result(256, 0);
+    for (uint8_t b : bytes) {
+        expected[b]++;
+    }
+    histogram(bytes.data(), bytes.size(), result.data());
+    TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), 256);
+
+    test_group_sum_type<uint8_t, int32_t>(tr, 200);
+    test_group_sum_type<uint16_t, uint32_t>(tr, 17);
+    test_group_sum_type<uint32_t, int64_t>(tr, 500);
+    test_group_sum_type<uint8_t, float>(tr, 64);
+    test_group_sum_type<uint16_t, double>(tr, 3000);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
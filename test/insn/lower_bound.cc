@@ -0,0 +1,94 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+template<class T>
+void test_lower_bound_size(TestReporter& tr, std::size_t n, unsigned max_gap)
+{
+    using namespace simdpp;
+
+    // sorted data with repeated elements if max_gap allows zero gaps
+    std::vector<T> data(n);
+    uint32_t seed = 7 + (uint32_t) n;
+    T x = std::is_signed<T>::value ? T(0) - T(n) : T(1);
+    for (std::size_t i = 0; i < n; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        x += T((seed >> 16) % max_gap);
+        data[i] = x;
+    }
+
+    // keys below, within and above the range of the data
+    std::vector<T> keys;
+    keys.push_back(std::is_signed<T>::value ? T(0) - T(2 * n + 10) : T(0));
+    for (std::size_t i = 0; i < n; ++i) {
+        keys.push_back(data[i]);
+        keys.push_back(T(data[i] + 1));
+    }
+    keys.push_back(T(x + 1));
+    keys.push_back(std::numeric_limits<T>::max());
+
+    std::vector<std::size_t> expected;
+    for (T k : keys) {
+        expected.push_back(std::lower_bound(data.begin(), data.end(), k) - data.begin());
+    }
+
+    std::vector<std::size_t> result;
+    for (T k : keys) {
+        result.push_back(simdpp::lower_bound(data.data(), n, k));
+    }
+    TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) keys.size());
+
+    std::fill(result.begin(), result.end(), 0);
+    lower_bound_many(data.data(), n, keys.data(), keys.size(), result.data());
+    TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) keys.size());
+
+    kary_search_tree<T> tree(data.data(), n);
+    TEST_EQUAL(tr, tree.size(), n);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        result[i] = tree.lower_bound(keys[i]);
+    }
+    TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) keys.size());
+
+    std::fill(result.begin(), result.end(), 0);
+    tree.lower_bound_many(keys.data(), keys.size(), result.data());
+    TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) keys.size());
+}
+
+template<class T>
+void test_lower_bound_type(TestReporter& tr)
+{
+    const std::size_t sizes[] = {
+        0, 1, 2, 5, 8, 15, 16, 17, 31, 100, 255, 256, 257, 289, 1000, 4913,
+        20000
+    };
+    for (std::size_t n : sizes) {
+        test_lower_bound_size<T>(tr, n, 3);
+        test_lower_bound_size<T>(tr, n, 100);
+    }
+}
+
+void test_lower_bound(TestResults& res, TestReporter& tr)
+{
+    (void) res;
+    test_lower_bound_type<uint32_t>(tr);
+    test_lower_bound_type<int32_t>(tr);
+    test_lower_bound_type<float>(tr);
+    test_lower_bound_type<uint64_t>(tr);
+    test_lower_bound_type<int64_t>(tr);
+    test_lower_bound_type<double>(tr);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,91 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+static bool is_aligned(const void* p, std::size_t align)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % align == 0;
+}
+
+template<class Vector>
+void test_memory_alloc_vector(TestReporter& tr, Vector& v, std::size_t align)
+{
+    for (unsigned i = 0; i < v.size(); ++i) {
+        v[i] = i;
+    }
+    v.resize(v.size() * 2 + 1, 7);
+    TEST_EQUAL(tr, true, is_aligned(v.data(), align));
+    TEST_EQUAL(tr, 0u, v[0]);
+    TEST_EQUAL(tr, 7u, v.back());
+}
+
+void test_memory_alloc(TestResults& res, TestReporter& tr)
+{
+    using namespace simdpp;
+    (void) res;
+
+    // system_aligned_allocator
+    for (unsigned n : { 1, 17, 1000 }) {
+        std::vector<uint32_t, system_aligned_allocator<uint32_t, 64>> v(n);
+        test_memory_alloc_vector(tr, v, 64);
+    }
+    {
+        // allocations above 64 KiB use huge pages
+        using A = system_aligned_allocator<uint32_t, 32>;
+        A alloc(64 << 10);
+        std::vector<uint32_t, A> v(100000, 0, alloc);
+        TEST_EQUAL(tr, true, is_aligned(v.data(), A::huge_page_size));
+        test_memory_alloc_vector(tr, v, 32);
+        TEST_EQUAL(tr, true, alloc == v.get_allocator());
+        TEST_EQUAL(tr, true, alloc != A());
+    }
+
+    // simd_arena
+    {
+        simd_arena arena;
+        void* p1 = arena.allocate(1);
+        void* p2 = arena.allocate(100);
+        void* p3 = arena.allocate(200000);
+        TEST_EQUAL(tr, true, is_aligned(p1, 64));
+        TEST_EQUAL(tr, true, is_aligned(p2, 64));
+        TEST_EQUAL(tr, true, is_aligned(p3, 64));
+        TEST_EQUAL(tr, true, p1 != p2);
+
+        // the released buffer is reused for the same size class
+        arena.deallocate(p2, 100);
+        void* p4 = arena.allocate(128);
+        TEST_EQUAL(tr, true, p2 == p4);
+
+        arena.deallocate(p1, 1);
+        arena.deallocate(p3, 200000);
+        arena.deallocate(p4, 128);
+
+        // many allocations span several blocks
+        std::vector<void*> ptrs;
+        for (unsigned i = 0; i < 100; ++i) {
+            ptrs.push_back(arena.allocate(50000));
+            TEST_EQUAL(tr, true, is_aligned(ptrs.back(), 64));
+        }
+        for (void* p : ptrs) {
+            arena.deallocate(p, 50000);
+        }
+    }
+    {
+        std::vector<uint32_t, arena_allocator<uint32_t>> v(1000);
+        test_memory_alloc_vector(tr, v, 64);
+        TEST_EQUAL(tr, true, v.get_allocator().arena() == &thread_arena());
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
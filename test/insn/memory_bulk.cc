@@ -0,0 +1,173 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+static int test_sign(int x)
+{
+    return (x > 0) - (x < 0);
+}
+
+void test_memory_bulk_copy_fill(TestReporter& tr, unsigned n, unsigned offset,
+                                std::size_t threshold)
+{
+    using namespace simdpp;
+
+    // guard bytes around the destination detect out of bounds writes
+    const unsigned guard = 80;
+    std::vector<uint8_t> src(n + offset), dst(n + offset + guard * 2),
+                         expected(n + offset + guard * 2);
+    for (unsigned i = 0; i < src.size(); ++i) {
+        src[i] = (uint8_t) (i * 7 + 3);
+    }
+
+    std::memset(dst.data(), 0xcc, dst.size());
+    std::memset(expected.data(), 0xcc, expected.size());
+    std::memcpy(expected.data() + guard + offset, src.data() + offset, n);
+    copy(dst.data() + guard + offset, src.data() + offset, n, threshold);
+    TEST_EQUAL_MEMORY(tr, expected.data(), dst.data(), (unsigned) dst.size());
+
+    std::memset(expected.data() + guard + offset, 0x5a, n);
+    fill(dst.data() + guard + offset, 0x5a, n, threshold);
+    TEST_EQUAL_MEMORY(tr, expected.data(), dst.data(), (unsigned) dst.size());
+}
+
+void test_memory_bulk_compare_find(TestReporter& tr, unsigned n, unsigned offset)
+{
+    using namespace simdpp;
+
+    std::vector<uint8_t> a(n + offset), b(n + offset);
+    for (unsigned i = 0; i < a.size(); ++i) {
+        a[i] = b[i] = (uint8_t) (i % 251 + 1);
+    }
+    const uint8_t* pa = a.data() + offset;
+    const uint8_t* pb = b.data() + offset;
+
+    TEST_EQUAL(tr, 0, compare(pa, pb, n));
+
+    unsigned positions[] = { 0, 1, n / 2, n - 2, n - 1 };
+    for (unsigned pos : positions) {
+        if (pos >= n) {
+            continue;
+        }
+        uint8_t* pbm = b.data() + offset;
+        uint8_t old = pbm[pos];
+
+        pbm[pos] = old + 1;
+        TEST_EQUAL(tr, test_sign(std::memcmp(pa, pb, n)),
+                   test_sign(compare(pa, pb, n)));
+        pbm[pos] = old - 1;
+        TEST_EQUAL(tr, test_sign(std::memcmp(pa, pb, n)),
+                   test_sign(compare(pa, pb, n)));
+        pbm[pos] = old;
+
+        // zero byte never occurs in the data, so the found index is pos
+        pbm[pos] = 0;
+        TEST_EQUAL(tr, (std::size_t) pos, find_byte(pb, n, 0));
+        pbm[pos] = old;
+    }
+    TEST_EQUAL(tr, (std::size_t) n, find_byte(pb, n, 0));
+}
+
+void test_memory_bulk_search(TestReporter& tr, unsigned n, unsigned offset)
+{
+    using namespace simdpp;
+
+    std::vector<uint8_t> data(n + offset);
+    uint32_t seed = n * 3 + offset;
+    for (unsigned i = 0; i < data.size(); ++i) {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = (uint8_t) ('a' + (seed >> 16) % 4);
+    }
+    const uint8_t* p = data.data() + offset;
+
+    for (uint8_t value : { 'a', 'c', 'x' }) {
+        TEST_EQUAL(tr, (std::size_t) std::count(p, p + n, value), count_byte(p, n, value));
+    }
+
+    std::vector<std::vector<uint8_t>> sets = {
+        {}, { 'x' }, { 'x', 'd' }, { 'c', 'd', 'x', 0, 0xff },
+        // 16 bytes with distinct high nibbles and low nibble patterns
+        { 0x01, 0x12, 0x23, 0x34, 0x45, 0x56, 0x6f, 0x78,
+          0x89, 0x9a, 0xab, 0xbc, 0xcd, 0xde, 0xef, 0xf0 },
+        // high nibbles sharing a pattern of low nibbles
+        { 0x01, 0x12, 0x23, 0x34, 0x45, 0x55, 0x65, 0x78,
+          0x89, 0x9a, 0xab, 0xbc, 0xcd, 0xde, 0xef, 0xf0 },
+    };
+    std::vector<uint8_t> large;
+    for (unsigned i = 0; i < 256; i += 3) {
+        large.push_back((uint8_t) i);
+    }
+    sets.push_back(large);
+
+    for (const auto& set : sets) {
+        const uint8_t* ps = set.data();
+        TEST_EQUAL(tr, (std::size_t) (std::find_first_of(p, p + n, ps, ps + set.size()) - p),
+                   find_any_of(p, n, ps, set.size()));
+    }
+
+    // plant a byte of the set at various positions of data without matches
+    const uint8_t* hex = sets[5].data();
+    unsigned positions[] = { 0, 1, n / 2, n - 2, n - 1 };
+    for (unsigned pos : positions) {
+        if (pos >= n) {
+            continue;
+        }
+        uint8_t* pm = data.data() + offset;
+        uint8_t old = pm[pos];
+        pm[pos] = hex[pos % 16];
+        TEST_EQUAL(tr, (std::size_t) pos, find_any_of(p, n, hex, 16));
+        pm[pos] = old;
+    }
+
+    const char* needles[] = { "", "a", "ab", "abc", "dcba", "aaa", "abcdabcd", "x" };
+    for (const char* needle : needles) {
+        const uint8_t* pn = reinterpret_cast<const uint8_t*>(needle);
+        std::size_t m = std::strlen(needle);
+        TEST_EQUAL(tr, (std::size_t) (std::search(p, p + n, pn, pn + m) - p),
+                   find_substring(p, n, pn, m));
+    }
+    for (unsigned pos : positions) {
+        if (pos + 5 > n) {
+            continue;
+        }
+        uint8_t* pm = data.data() + offset;
+        std::vector<uint8_t> old(pm + pos, pm + pos + 5);
+        std::memcpy(pm + pos, "xyzzy", 5);
+        TEST_EQUAL(tr, (std::size_t) pos, find_substring(p, n, "xyzzy", 5));
+        std::memcpy(pm + pos, old.data(), 5);
+    }
+}
+
+void test_memory_bulk(TestResults& res, TestReporter& tr)
+{
+    (void) res;
+    for (unsigned n = 0; n < 300; ++n) {
+        for (unsigned offset = 0; offset < 3; ++offset) {
+            test_memory_bulk_copy_fill(tr, n, offset, SIMDPP_STREAM_THRESHOLD);
+            test_memory_bulk_compare_find(tr, n, offset);
+            test_memory_bulk_search(tr, n, offset);
+        }
+    }
+
+    // exercise the non-temporal path
+    unsigned sizes[] = { 64, 65, 127, 128, 1000, 4099 };
+    for (unsigned n : sizes) {
+        for (unsigned offset = 0; offset < 65; offset += 13) {
+            test_memory_bulk_copy_fill(tr, n, offset, 64);
+        }
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
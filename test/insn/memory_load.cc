@@ -75,6 +75,12 @@ void test_load_helper(TestResultsSet& tc, TestReporter& tr,
         TEST_NOT_EQUAL(tr, zero, r);
     }
 
+    for (unsigned i = 0; i < vnum; i++) {
+        V r = simdpp::stream_load<V>(sdata + i*V::length);
+        TEST_PUSH(tc, V, r);
+        TEST_EQUAL(tr, sv[i], r);
+    }
+
     rzero(rv);
     load_packed2(rv[0], rv[1], sdata);
     TEST_PUSH_ARRAY(tc, V, rv);
@@ -97,6 +103,49 @@ void test_load_helper(TestResultsSet& tc, TestReporter& tr,
     TEST_NOT_EQUAL(tr, zero, rv[3]);
 }
 
+template<class V, unsigned Stride>
+void test_load_strided_stride(TestResultsSet& tc, TestReporter& tr,
+                              const typename V::element_type* sdata)
+{
+    using namespace simdpp;
+    using E = typename V::element_type;
+
+    E edata[V::length];
+    for (unsigned i = 0; i < V::length; i++) {
+        edata[i] = sdata[i*Stride];
+    }
+    V expected = load_u(edata);
+
+    V r;
+    load_strided<Stride>(r, sdata);
+    TEST_PUSH(tc, V, r);
+    TEST_EQUAL(tr, expected, r);
+
+    load_strided<Stride>(r, sdata + 1);
+    TEST_PUSH(tc, V, r);
+}
+
+template<class V>
+void test_load_strided(TestResultsSet& tc, TestReporter& tr)
+{
+    using E = typename V::element_type;
+
+    // the largest tested stride is 16
+    E sdata[V::length * 16 + 1];
+    for (unsigned i = 0; i < V::length * 16 + 1; i++) {
+        sdata[i] = (E) (i * 3 + 1);
+    }
+
+    test_load_strided_stride<V, 1>(tc, tr, sdata);
+    test_load_strided_stride<V, 2>(tc, tr, sdata);
+    test_load_strided_stride<V, 3>(tc, tr, sdata);
+    test_load_strided_stride<V, 4>(tc, tr, sdata);
+    test_load_strided_stride<V, 5>(tc, tr, sdata);
+    test_load_strided_stride<V, 7>(tc, tr, sdata);
+    test_load_strided_stride<V, 8>(tc, tr, sdata);
+    test_load_strided_stride<V, 16>(tc, tr, sdata);
+}
+
 template<unsigned B>
 void test_memory_load_n(TestResultsSet& tc, TestReporter& tr)
 {
@@ -118,12 +167,30 @@ void test_memory_load_n(TestResultsSet& tc, TestReporter& tr)
 
     test_load_helper<float32<B/4>, vnum>(tc, tr, v.pf32);
     test_load_helper<float64<B/8>, vnum>(tc, tr, v.pf64);
+
+    test_load_strided<uint8<B>>(tc, tr);
+    test_load_strided<uint16<B/2>>(tc, tr);
+    test_load_strided<uint32<B/4>>(tc, tr);
+    test_load_strided<uint64<B/8>>(tc, tr);
+    test_load_strided<int32<B/4>>(tc, tr);
+    test_load_strided<float32<B/4>>(tc, tr);
+    test_load_strided<float64<B/8>>(tc, tr);
 }
 
 void test_memory_load(TestResults& res, TestReporter& tr)
 {
+    using namespace simdpp;
     TestResultsSet& tc = res.new_results_set("memory_load");
 
+    // prefetches have no observable effect, check only that they compile
+    char pdata[64] = {};
+    prefetch_read(pdata);
+    prefetch_read<prefetch_locality::nta>(pdata);
+    prefetch_read<prefetch_locality::t2>(pdata);
+    prefetch_read<prefetch_locality::t1>(pdata);
+    prefetch_write<prefetch_locality::t1>(pdata);
+    prefetch_write<prefetch_locality::nta>(pdata);
+
     test_memory_load_n<16>(tc, tr);
     test_memory_load_n<32>(tc, tr);
     test_memory_load_n<64>(tc, tr);
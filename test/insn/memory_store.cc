@@ -160,6 +160,42 @@ void test_store_helper(TestResultsSet& tc, TestReporter& tr, const V* sv)
     TEST_NOT_EQUAL_MEMORY(tr, data_zero, rdata + 3 * V::length, V::length);
 }
 
+template<class V, unsigned Stride>
+void test_store_strided_stride(TestResultsSet& tc, TestReporter& tr, const V& v)
+{
+    using namespace simdpp;
+    using E = typename V::element_type;
+
+    const unsigned count = V::length * Stride;
+    E rdata[V::length * 16];
+    E edata[V::length * 16];
+    std::memset(rdata, 0x5a, sizeof(rdata));
+    std::memset(edata, 0x5a, sizeof(edata));
+
+    SIMDPP_ALIGN(64) E vdata[V::length];
+    store(vdata, v);
+    for (unsigned i = 0; i < V::length; i++) {
+        edata[i*Stride] = vdata[i];
+    }
+
+    store_strided<Stride>(rdata, v);
+    TEST_PUSH_STORED(tc, V, rdata, count);
+    TEST_EQUAL_MEMORY(tr, edata, rdata, count);
+}
+
+template<class V>
+void test_store_strided(TestResultsSet& tc, TestReporter& tr, const V* sv)
+{
+    test_store_strided_stride<V, 1>(tc, tr, sv[0]);
+    test_store_strided_stride<V, 2>(tc, tr, sv[0]);
+    test_store_strided_stride<V, 3>(tc, tr, sv[0]);
+    test_store_strided_stride<V, 4>(tc, tr, sv[0]);
+    test_store_strided_stride<V, 5>(tc, tr, sv[0]);
+    test_store_strided_stride<V, 7>(tc, tr, sv[0]);
+    test_store_strided_stride<V, 8>(tc, tr, sv[0]);
+    test_store_strided_stride<V, 16>(tc, tr, sv[0]);
+}
+
 template<unsigned B>
 void test_memory_store_n(TestResultsSet& tc, TestReporter& tr)
 {
@@ -188,6 +224,14 @@ void test_memory_store_n(TestResultsSet& tc, TestReporter& tr)
     test_store_masked<int64<B/8>>(tc, tr, v.i64);
     test_store_masked<float32<B/4>>(tc, tr, v.f32);
     test_store_masked<float64<B/8>>(tc, tr, v.f64);
+
+    test_store_strided<uint8<B>>(tc, tr, v.u8);
+    test_store_strided<uint16<B/2>>(tc, tr, v.u16);
+    test_store_strided<uint32<B/4>>(tc, tr, v.u32);
+    test_store_strided<uint64<B/8>>(tc, tr, v.u64);
+    test_store_strided<int32<B/4>>(tc, tr, v.i32);
+    test_store_strided<float32<B/4>>(tc, tr, v.f32);
+    test_store_strided<float64<B/8>>(tc, tr, v.f64);
 }
 
 void test_memory_store(TestResults& res, TestReporter& tr)
@@ -0,0 +1,91 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Generates runs with lengths up to max_run
+template<class T>
+std::vector<T> rle_data(std::size_t n, unsigned max_run, uint32_t seed)
+{
+    std::vector<T> r;
+    while (r.size() < n) {
+        seed = seed * 1103515245u + 12345u;
+        std::size_t len = (seed >> 16) % max_run + 1;
+        T value = T((seed >> 8) % 5);
+        for (std::size_t i = 0; i < len && r.size() < n; ++i) {
+            r.push_back(value);
+        }
+    }
+    return r;
+}
+
+template<class T>
+void test_rle_type(TestReporter& tr)
+{
+    using namespace simdpp;
+
+    const std::size_t sizes[] = { 0, 1, 2, 15, 16, 17, 64, 100, 1000 };
+    const unsigned max_runs[] = { 1, 3, 20, 200 };
+    for (std::size_t n : sizes) {
+        for (unsigned max_run : max_runs) {
+            std::vector<T> in = rle_data<T>(n, max_run, uint32_t(n + max_run));
+
+            std::vector<T> exp_values;
+            std::vector<uint32_t> exp_runs;
+            for (std::size_t i = 0; i < n; ++i) {
+                if (i == 0 || in[i] != in[i - 1]) {
+                    exp_values.push_back(in[i]);
+                    exp_runs.push_back(0);
+                }
+                exp_runs.back()++;
+            }
+
+            std::vector<T> values(n);
+            std::vector<uint32_t> runs(n);
+            std::size_t num_runs = rle_encode(in.data(), n, values.data(), runs.data());
+            TEST_EQUAL(tr, num_runs, exp_runs.size());
+            values.resize(num_runs);
+            runs.resize(num_runs);
+            TEST_EQUAL(tr, values == exp_values, true);
+            TEST_EQUAL(tr, runs == exp_runs, true);
+
+            // the output is exactly sized to detect overflows with sanitizers
+            std::vector<T> out(n);
+            TEST_EQUAL(tr, rle_decode(values.data(), runs.data(), num_runs, out.data()), n);
+            TEST_EQUAL(tr, out == in, true);
+        }
+    }
+
+    // runs of zero length are skipped
+    std::vector<T> values = { 1, 2, 3 };
+    std::vector<uint32_t> runs = { 40, 0, 2 };
+    std::vector<T> out(100);
+    TEST_EQUAL(tr, rle_decode(values.data(), runs.data(), 3, out.data()), std::size_t(42));
+    TEST_EQUAL(tr, out[39], T(1));
+    TEST_EQUAL(tr, out[40], T(3));
+    TEST_EQUAL(tr, out[41], T(3));
+}
+
+void test_rle(TestResults& res, TestReporter& tr)
+{
+    (void) res;
+    test_rle_type<uint8_t>(tr);
+    test_rle_type<int8_t>(tr);
+    test_rle_type<uint16_t>(tr);
+    test_rle_type<int32_t>(tr);
+    test_rle_type<uint64_t>(tr);
+    test_rle_type<float>(tr);
+    test_rle_type<double>(tr);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,175 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// The values are small integers so that floating-point sums are exact
+template<class T>
+std::vector<T> scan_data(std::size_t n, uint32_t seed)
+{
+    std::vector<T> r;
+    for (std::size_t i = 0; i < n; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        r.push_back(T(int((seed >> 16) % 201) - 100));
+    }
+    return r;
+}
+
+template<class V>
+void test_prefix_sum_type(TestResultsSet& ts, TestReporter& tr)
+{
+    using namespace simdpp;
+    using E = typename V::element_type;
+    const unsigned L = V::length;
+
+    for (unsigned k = 0; k < 4; ++k) {
+        std::vector<E> a = scan_data<E>(L, k);
+        V v = load_u(a.data());
+        v = prefix_sum(v);
+        TEST_PUSH(ts, V, v);
+
+        E expected[L], result[L];
+        E s = 0;
+        for (unsigned i = 0; i < L; ++i) {
+            s += a[i];
+            expected[i] = s;
+        }
+        store_u(result, v);
+        TEST_EQUAL_MEMORY(tr, expected, result, L);
+    }
+}
+
+template<class T>
+void test_scan_type(TestReporter& tr)
+{
+    using namespace simdpp;
+
+    const std::size_t sizes[] = { 0, 1, 2, 7, 16, 31, 64, 65, 1000, 4099 };
+    for (std::size_t n : sizes) {
+        std::vector<T> in = scan_data<T>(n, (uint32_t) n);
+        std::vector<T> expected(n + 1, T(0)), result(n + 1, T(0));
+
+        T s = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            s += in[i];
+            expected[i] = s;
+        }
+        inclusive_scan(in.data(), result.data(), n);
+        TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) n + 1);
+
+        // in place
+        result = in;
+        result.push_back(T(0));
+        inclusive_scan(result.data(), result.data(), n);
+        TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) n + 1);
+
+        s = T(5);
+        for (std::size_t i = 0; i < n; ++i) {
+            expected[i] = s;
+            s += in[i];
+        }
+        std::fill(result.begin(), result.end(), T(0));
+        exclusive_scan(in.data(), result.data(), n, T(5));
+        TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) n + 1);
+
+        result = in;
+        result.push_back(T(0));
+        exclusive_scan(result.data(), result.data(), n, T(5));
+        TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) n + 1);
+    }
+}
+
+/*  The input consists of ones and a single element of large magnitude. Once
+    the large element is added, the ones are absorbed by rounding in any
+    summation order, thus the results are exact. The elements following the
+    large element in the exclusive scan would lose the preceding ones if they
+    were computed by subtracting the input from the inclusive sums.
+*/
+template<class T>
+void test_scan_large_type(TestReporter& tr, T big)
+{
+    using namespace simdpp;
+
+    const std::size_t sizes[] = { 1, 2, 7, 16, 31, 64, 65, 1000, 4099 };
+    for (std::size_t n : sizes) {
+        const std::size_t positions[] = { 0, 1, n / 2, n - 1 };
+        for (std::size_t p : positions) {
+            if (p >= n) {
+                continue;
+            }
+            std::vector<T> in(n, T(1));
+            in[p] = big;
+            std::vector<T> expected(n + 1, T(0)), result(n + 1, T(0));
+
+            T s = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                s += in[i];
+                expected[i] = s;
+            }
+            inclusive_scan(in.data(), result.data(), n);
+            TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) n + 1);
+
+            s = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                expected[i] = s;
+                s += in[i];
+            }
+            std::fill(result.begin(), result.end(), T(0));
+            exclusive_scan(in.data(), result.data(), n);
+            TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) n + 1);
+
+            result = in;
+            result.push_back(T(0));
+            exclusive_scan(result.data(), result.data(), n);
+            TEST_EQUAL_MEMORY(tr, expected.data(), result.data(), (unsigned) n + 1);
+        }
+    }
+}
+
+void test_scan(TestResults& res, TestReporter& tr)
+{
+    using namespace simdpp;
+
+    TestResultsSet& ts = res.new_results_set("prefix_sum");
+
+    test_prefix_sum_type<int8<16>>(ts, tr);
+    test_prefix_sum_type<uint8<64>>(ts, tr);
+    test_prefix_sum_type<int16<8>>(ts, tr);
+    test_prefix_sum_type<uint16<32>>(ts, tr);
+    test_prefix_sum_type<int32<4>>(ts, tr);
+    test_prefix_sum_type<int32<8>>(ts, tr);
+    test_prefix_sum_type<uint32<16>>(ts, tr);
+    test_prefix_sum_type<int64<2>>(ts, tr);
+    test_prefix_sum_type<uint64<8>>(ts, tr);
+    test_prefix_sum_type<float32<4>>(ts, tr);
+    test_prefix_sum_type<float32<16>>(ts, tr);
+    test_prefix_sum_type<float64<2>>(ts, tr);
+    test_prefix_sum_type<float64<8>>(ts, tr);
+
+    test_scan_type<int8_t>(tr);
+    test_scan_type<uint16_t>(tr);
+    test_scan_type<int32_t>(tr);
+    test_scan_type<uint32_t>(tr);
+    test_scan_type<int64_t>(tr);
+    test_scan_type<float>(tr);
+    test_scan_type<double>(tr);
+
+    test_scan_large_type<float>(tr, 1e20f);
+    test_scan_large_type<float>(tr, std::numeric_limits<float>::infinity());
+    test_scan_large_type<double>(tr, 1e20);
+    test_scan_large_type<double>(tr, 1e300);
+    test_scan_large_type<double>(tr, std::numeric_limits<double>::infinity());
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
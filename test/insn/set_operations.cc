@@ -0,0 +1,124 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Generates n strictly increasing values with gaps of 1 to max_gap
+template<class T>
+std::vector<T> make_sorted_set(std::size_t n, unsigned max_gap, uint32_t seed)
+{
+    std::vector<T> r(n);
+    T x = std::is_signed<T>::value ? T(0) - T(n) : T(0);
+    for (std::size_t i = 0; i < n; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        x += T(1 + (seed >> 16) % max_gap);
+        r[i] = x;
+    }
+    return r;
+}
+
+template<class T>
+void test_set_operations_inputs(TestReporter& tr, const std::vector<T>& a,
+                                const std::vector<T>& b)
+{
+    using namespace simdpp;
+
+    std::vector<T> out(a.size() + b.size() + 1);
+    std::vector<T> expected;
+    std::size_t n;
+
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                          std::back_inserter(expected));
+    n = intersect_sorted(a.data(), a.size(), b.data(), b.size(), out.data());
+    TEST_EQUAL(tr, n, expected.size());
+    TEST_EQUAL_MEMORY(tr, expected.data(), out.data(), (unsigned) n);
+
+    expected.clear();
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(expected));
+    n = difference_sorted(a.data(), a.size(), b.data(), b.size(), out.data());
+    TEST_EQUAL(tr, n, expected.size());
+    TEST_EQUAL_MEMORY(tr, expected.data(), out.data(), (unsigned) n);
+
+    expected.clear();
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                   std::back_inserter(expected));
+    n = union_sorted(a.data(), a.size(), b.data(), b.size(), out.data());
+    TEST_EQUAL(tr, n, expected.size());
+    TEST_EQUAL_MEMORY(tr, expected.data(), out.data(), (unsigned) n);
+
+    expected.clear();
+    std::merge(a.begin(), a.end(), b.begin(), b.end(),
+               std::back_inserter(expected));
+    n = merge_sorted(a.data(), a.size(), b.data(), b.size(), out.data());
+    TEST_EQUAL(tr, n, expected.size());
+    TEST_EQUAL_MEMORY(tr, expected.data(), out.data(), (unsigned) n);
+}
+
+template<class T>
+void test_set_operations_type(TestReporter& tr)
+{
+    const std::size_t sizes[][2] = {
+        { 0, 0 }, { 0, 10 }, { 10, 0 }, { 1, 1 }, { 7, 9 }, { 16, 16 },
+        { 17, 33 }, { 64, 64 }, { 100, 97 }, { 1000, 1000 }, { 1000, 37 },
+        { 20, 5000 }, { 5000, 3 }, { 4096, 8191 }
+    };
+    const unsigned gaps[] = { 1, 3, 16 };
+
+    uint32_t seed = 1;
+    for (const auto& s : sizes) {
+        for (unsigned ga : gaps) {
+            for (unsigned gb : gaps) {
+                std::vector<T> a = make_sorted_set<T>(s[0], ga, seed++);
+                std::vector<T> b = make_sorted_set<T>(s[1], gb, seed++);
+                test_set_operations_inputs(tr, a, b);
+            }
+        }
+    }
+
+    // merge_sorted accepts repeated elements
+    std::vector<T> a, b;
+    for (unsigned i = 0; i < 300; ++i) {
+        a.push_back(T(i / 7));
+        b.push_back(T(i / 3));
+    }
+    std::vector<T> out(a.size() + b.size());
+    std::vector<T> expected;
+    std::merge(a.begin(), a.end(), b.begin(), b.end(),
+               std::back_inserter(expected));
+    std::size_t n = simdpp::merge_sorted(a.data(), a.size(), b.data(), b.size(),
+                                         out.data());
+    TEST_EQUAL(tr, n, expected.size());
+    TEST_EQUAL_MEMORY(tr, expected.data(), out.data(), (unsigned) n);
+
+    expected.clear();
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                   std::back_inserter(expected));
+    expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+    n = simdpp::union_sorted(a.data(), a.size(), b.data(), b.size(), out.data());
+    TEST_EQUAL(tr, n, expected.size());
+    TEST_EQUAL_MEMORY(tr, expected.data(), out.data(), (unsigned) n);
+}
+
+void test_set_operations(TestResults& res, TestReporter& tr)
+{
+    (void) res;
+    test_set_operations_type<uint32_t>(tr);
+    test_set_operations_type<int32_t>(tr);
+    test_set_operations_type<uint64_t>(tr);
+    test_set_operations_type<int64_t>(tr);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -210,6 +210,7 @@ void test_shuffle(TestResults& res)
     // extract bits
     test_extract_bits<uint16_t, uint8<16>>(tc);
     test_extract_bits<uint32_t, uint8<32>>(tc);
+    test_extract_bits<uint64_t, uint8<64>>(tc);
 }
 
 } // namespace SIMDPP_ARCH_NAMESPACE
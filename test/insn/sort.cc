@@ -0,0 +1,162 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Results are pushed to the results set only for the types that are supported
+// on all instruction sets. The results are verified against std::sort anyway.
+template<class V, unsigned K, bool Push = true>
+void test_sort_network_type(TestResultsSet& ts, TestReporter& tr)
+{
+    using namespace simdpp;
+    using E = typename V::element_type;
+
+    E a[K][V::length];
+    V v[K];
+    uint32_t seed = 12345;
+    for (unsigned k = 0; k < K; ++k) {
+        for (unsigned i = 0; i < V::length; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            a[k][i] = (E) (int) ((seed >> 8) % 201 - 100);
+        }
+    }
+    for (unsigned k = 0; k < K; ++k) {
+        v[k] = load_u(a[k]);
+    }
+    sort_network(v);
+    for (unsigned k = 0; k < K; ++k) {
+        if (Push) {
+            TEST_PUSH(ts, V, v[k]);
+        }
+        store_u(a[k], v[k]);
+    }
+
+    for (unsigned i = 0; i < V::length; ++i) {
+        for (unsigned k = 1; k < K; ++k) {
+            TEST_EQUAL(tr, a[k-1][i] <= a[k][i], true);
+        }
+    }
+}
+
+template<class V, bool Push = true>
+void test_bitonic_merge_type(TestResultsSet& ts, TestReporter& tr)
+{
+    using namespace simdpp;
+    using E = typename V::element_type;
+    const unsigned L = V::length;
+
+    E a[2][L];
+    V v[2];
+    std::vector<E> expected;
+    uint32_t seed = 4321;
+    for (unsigned k = 0; k < 2; ++k) {
+        for (unsigned i = 0; i < L; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            a[k][i] = (E) (int) ((seed >> 8) % 101 - 50);
+            expected.push_back(a[k][i]);
+        }
+        std::sort(a[k], a[k] + L);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    v[0] = load_u(a[0]);
+    v[1] = load_u(a[1]);
+    bitonic_merge(v[0], v[1]);
+    if (Push) {
+        TEST_PUSH(ts, V, v[0]);
+        TEST_PUSH(ts, V, v[1]);
+    }
+    store_u(a[0], v[0]);
+    store_u(a[1], v[1]);
+    TEST_EQUAL_MEMORY(tr, expected.data(), &a[0][0], 2 * L);
+}
+
+template<class T>
+void test_sort_array(TestReporter& tr, std::size_t n, unsigned mode)
+{
+    std::vector<T> data(n);
+    uint64_t seed = 0x9e3779b97f4a7c15ull + n + mode;
+    for (std::size_t i = 0; i < n; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        int64_t r = (int64_t) (seed >> 24);
+        switch (mode) {
+        case 0: data[i] = (T) r; break;                   // random
+        case 1: data[i] = (T) (r % 7); break;             // many duplicates
+        case 2: data[i] = (T) i; break;                   // sorted
+        case 3: data[i] = (T) (n - i); break;             // reverse sorted
+        default: data[i] = (T) 3; break;                  // all equal
+        }
+        if (std::is_signed<T>::value && (i & 1) && mode != 2 && mode != 3) {
+            data[i] = T(0) - data[i];
+        }
+    }
+
+    std::vector<T> expected = data;
+    std::sort(expected.begin(), expected.end());
+    simdpp::sort(data.data(), data.size());
+    if (n > 0) {
+        TEST_EQUAL_MEMORY(tr, expected.data(), data.data(), (unsigned) n);
+    }
+}
+
+template<class T>
+void test_sort_array_type(TestReporter& tr)
+{
+    const std::size_t sizes[] = {
+        0, 1, 2, 3, 7, 15, 16, 17, 31, 33, 63, 64, 65, 100, 127, 128, 129,
+        255, 256, 257, 1000, 4099, 100000
+    };
+    for (std::size_t n : sizes) {
+        for (unsigned mode = 0; mode < 5; ++mode) {
+            test_sort_array<T>(tr, n, mode);
+        }
+    }
+}
+
+void test_sort(TestResults& res, TestReporter& tr)
+{
+    using namespace simdpp;
+
+    TestResultsSet& ts = res.new_results_set("sort");
+
+    test_sort_network_type<uint32<4>, 4>(ts, tr);
+    test_sort_network_type<int32<8>, 8>(ts, tr);
+    test_sort_network_type<float32<16>, 16>(ts, tr);
+    test_sort_network_type<int16<8>, 2>(ts, tr);
+    test_sort_network_type<uint8<32>, 4>(ts, tr);
+#if SIMDPP_USE_NULL || SIMDPP_USE_AVX2 || SIMDPP_USE_NEON64 || SIMDPP_USE_ALTIVEC
+    test_sort_network_type<int64<4>, 8, false>(ts, tr);
+#endif
+    test_sort_network_type<float64<2>, 1>(ts, tr);
+
+    test_bitonic_merge_type<uint32<4>>(ts, tr);
+    test_bitonic_merge_type<int32<8>>(ts, tr);
+    test_bitonic_merge_type<float32<8>>(ts, tr);
+    test_bitonic_merge_type<float32<16>>(ts, tr);
+#if SIMDPP_USE_NULL || SIMDPP_USE_AVX2 || SIMDPP_USE_NEON64 || SIMDPP_USE_ALTIVEC
+    test_bitonic_merge_type<uint64<2>, false>(ts, tr);
+    test_bitonic_merge_type<int64<4>, false>(ts, tr);
+#endif
+    test_bitonic_merge_type<float64<4>>(ts, tr);
+    test_bitonic_merge_type<float64<8>>(ts, tr);
+
+    test_sort_array_type<int32_t>(tr);
+    test_sort_array_type<uint32_t>(tr);
+    test_sort_array_type<float>(tr);
+    test_sort_array_type<int64_t>(tr);
+    test_sort_array_type<uint64_t>(tr);
+    test_sort_array_type<double>(tr);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
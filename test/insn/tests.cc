@@ -68,9 +68,28 @@ void main_test_function(TestResults& res, TestReporter& tr, const TestOptions& o
     test_math_int(res);
     test_compare(res);
     test_math_shift(res);
-    test_transpose(res);
+    test_transpose(res, tr);
+    test_transpose_matrix(res, tr);
 
     test_for_each(res, tr);
+    test_memory_alloc(res, tr);
+    test_memory_bulk(res, tr);
+    test_containers(res, tr);
+    test_sort(res, tr);
+    test_set_operations(res, tr);
+    test_lower_bound(res, tr);
+    test_hash(res, tr);
+    test_histogram(res, tr);
+    test_scan(res, tr);
+    test_bitpack(res, tr);
+    test_varint(res, tr);
+    test_rle(res, tr);
+    test_dict_decode(res, tr);
+    test_filter_bitmap(res, tr);
+    test_bitmap(res, tr);
+    test_bitslice(res, tr);
+    test_utf8(res, tr);
+    test_base64(res, tr);
 }
 
 } // namespace SIMDPP_ARCH_NAMESPACE
@@ -17,25 +17,44 @@
 namespace SIMDPP_ARCH_NAMESPACE {
 
 void main_test_function(TestResults& res, TestReporter& tr, const TestOptions& opts);
+void test_base64(TestResults& res, TestReporter& tr);
+void test_bitmap(TestResults& res, TestReporter& tr);
+void test_bitpack(TestResults& res, TestReporter& tr);
+void test_bitslice(TestResults& res, TestReporter& tr);
 void test_bitwise(TestResults& res, TestReporter& tr);
 void test_blend(TestResults& res);
 void test_compare(TestResults& res);
 void test_convert(TestResults& res);
 void test_construct(TestResults& res);
+void test_dict_decode(TestResults& res, TestReporter& tr);
+void test_filter_bitmap(TestResults& res, TestReporter& tr);
+void test_containers(TestResults& res, TestReporter& tr);
 void test_for_each(TestResults& res, TestReporter& tr);
+void test_hash(TestResults& res, TestReporter& tr);
+void test_histogram(TestResults& res, TestReporter& tr);
+void test_lower_bound(TestResults& res, TestReporter& tr);
 void test_math_fp(TestResults& res, const TestOptions& opts);
 void test_math_int(TestResults& res);
 void test_math_shift(TestResults& res);
+void test_memory_alloc(TestResults& res, TestReporter& tr);
+void test_memory_bulk(TestResults& res, TestReporter& tr);
 void test_memory_load(TestResults& res, TestReporter& tr);
 void test_memory_store(TestResults& res, TestReporter& tr);
+void test_rle(TestResults& res, TestReporter& tr);
+void test_scan(TestResults& res, TestReporter& tr);
 void test_set(TestResults& res);
+void test_set_operations(TestResults& res, TestReporter& tr);
 void test_shuffle(TestResults& res);
 void test_shuffle_bytes(TestResults& res, TestReporter& tr);
 void test_shuffle_generic(TestResults& res);
 void test_permute_generic(TestResults& res);
 void test_shuffle_transpose(TestResults& res);
+void test_sort(TestResults& res, TestReporter& tr);
 void test_test_utils(TestResults& res);
-void test_transpose(TestResults& res);
+void test_transpose(TestResults& res, TestReporter& tr);
+void test_transpose_matrix(TestResults& res, TestReporter& tr);
+void test_utf8(TestResults& res, TestReporter& tr);
+void test_varint(TestResults& res, TestReporter& tr);
 
 } // namespace SIMDPP_ARCH_NAMESPACE
 
@@ -12,11 +12,85 @@
 
 namespace SIMDPP_ARCH_NAMESPACE {
 
+/*  Checks that each K consecutive elements of the K vectors in @a r form the
+    transpose of the corresponding KxK matrix in @a a.
+*/
+template<class V, unsigned K>
+void test_transpose_result(TestReporter& tr, const V* a, const V* r)
+{
+    using E = typename V::element_type;
+    E sa[K][V::length];
+    E sr[K][V::length];
+    E expected[K][V::length];
+    for (unsigned i = 0; i < K; ++i) {
+        simdpp::store_u(sa[i], a[i]);
+        simdpp::store_u(sr[i], r[i]);
+    }
+    for (unsigned i = 0; i < K; ++i) {
+        for (unsigned j = 0; j < V::length; ++j) {
+            unsigned block = j / K * K;
+            expected[i][j] = sa[j - block][block + i];
+        }
+    }
+    for (unsigned i = 0; i < K; ++i) {
+        TEST_EQUAL_MEMORY(tr, expected[i], sr[i], V::length);
+    }
+}
+
+/*  Fills the K vectors at @a a with distinct values, so that any misplaced
+    element is detected. 8-bit elements have too few values to be distinct
+    across whole wide vectors, thus the values are distinct within each
+    128-bit block and each block is XORed with a different constant.
+*/
+template<class V, unsigned K>
+void fill_transpose_input(V* a)
+{
+    using E = typename V::element_type;
+    E data[K][V::length];
+    for (unsigned i = 0; i < K; ++i) {
+        for (unsigned j = 0; j < V::length; ++j) {
+            unsigned value = i * V::length + j;
+            if (sizeof(E) == 1) {
+                value = ((i * 16 + j % 16) ^ (j / 16 * 0x55)) & 0xff;
+            }
+            data[i][j] = E(value);
+        }
+        a[i] = simdpp::load_u(data[i]);
+    }
+}
+
+template<class V>
+void test_transpose8_type(TestResultsSet& tc, TestReporter& tr, V* a)
+{
+    fill_transpose_input<V, 8>(a);
+    V r[8];
+    for (unsigned i = 0; i < 8; ++i) {
+        r[i] = a[i];
+    }
+    transpose8(r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7]);
+    TEST_PUSH_ARRAY(tc, V, r);
+    test_transpose_result<V, 8>(tr, a, r);
+}
+
+template<class V>
+void test_transpose16_type(TestResultsSet& tc, TestReporter& tr, V* a)
+{
+    fill_transpose_input<V, 16>(a);
+    V r[16];
+    for (unsigned i = 0; i < 16; ++i) {
+        r[i] = a[i];
+    }
+    transpose16(r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7],
+                r[8], r[9], r[10], r[11], r[12], r[13], r[14], r[15]);
+    TEST_PUSH_ARRAY(tc, V, r);
+    test_transpose_result<V, 16>(tr, a, r);
+}
+
 template<unsigned B>
-void test_transpose_n(TestResultsSet& tc)
+void test_transpose_n(TestResultsSet& tc, TestReporter& tr)
 {
     using namespace simdpp;
-    Vectors<B,8> v;
+    Vectors<B,16> v;
 
     // int8x16
     transpose4(v.u8[0], v.u8[1], v.u8[2], v.u8[3]);
@@ -59,14 +133,30 @@ void test_transpose_n(TestResultsSet& tc)
     transpose2(v.f64[0], v.f64[1]);
     TEST_PUSH_ARRAY(tc, float64<B/8>, v.f64);
     v.reset();
+
+    // whole 128-bit lane transposes
+    test_transpose16_type(tc, tr, v.u8);
+    test_transpose8_type(tc, tr, v.u16);
 }
 
-void test_transpose(TestResults& res)
+void test_transpose(TestResults& res, TestReporter& tr)
 {
+    using namespace simdpp;
     TestResultsSet& tc = res.new_results_set("transpose");
-    test_transpose_n<16>(tc);
-    test_transpose_n<32>(tc);
-    test_transpose_n<64>(tc);
+    test_transpose_n<16>(tc, tr);
+    test_transpose_n<32>(tc, tr);
+    test_transpose_n<64>(tc, tr);
+
+    // transposes that span whole 256 and 512-bit vectors
+    Vectors<32,8> v32;
+    test_transpose8_type(tc, tr, v32.u32);
+    test_transpose8_type(tc, tr, v32.f32);
+
+    Vectors<64,16> v64;
+    test_transpose8_type(tc, tr, v64.u64);
+    test_transpose8_type(tc, tr, v64.f64);
+    test_transpose16_type(tc, tr, v64.u32);
+    test_transpose16_type(tc, tr, v64.f32);
 }
 
 } // namespace SIMDPP_ARCH_NAMESPACE
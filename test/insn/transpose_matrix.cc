@@ -0,0 +1,79 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+template<class T, bool Stream>
+void test_transpose_matrix_size(TestReporter& tr,
+                                unsigned rows, unsigned cols,
+                                unsigned src_pad, unsigned dst_pad)
+{
+    using namespace simdpp;
+
+    unsigned src_stride = cols + src_pad;
+    unsigned dst_stride = rows + dst_pad;
+
+    std::vector<T, aligned_allocator<T, 64>> src(rows * src_stride);
+    std::vector<T, aligned_allocator<T, 64>> dst(cols * dst_stride, T(0));
+    std::vector<T> expected(cols * dst_stride, T(0));
+
+    for (unsigned i = 0; i < src.size(); ++i) {
+        src[i] = (T) (i * 0x9e3779b1u + 1);
+    }
+    for (unsigned r = 0; r < rows; ++r) {
+        for (unsigned c = 0; c < cols; ++c) {
+            expected[c * dst_stride + r] = src[r * src_stride + c];
+        }
+    }
+
+    if (Stream) {
+        transpose_matrix_stream(src.data(), dst.data(), rows, cols,
+                                src_stride, dst_stride);
+    } else {
+        transpose_matrix(src.data(), dst.data(), rows, cols,
+                         src_stride, dst_stride);
+    }
+    TEST_EQUAL_MEMORY(tr, expected.data(), dst.data(), (unsigned) dst.size());
+}
+
+template<class T>
+void test_transpose_matrix_type(TestReporter& tr)
+{
+    // sizes exercise empty matrices, partial blocks, partial tiles and
+    // multiple tiles in both directions
+    const unsigned sizes[][2] = {
+        { 0, 0 }, { 1, 1 }, { 1, 17 }, { 17, 1 }, { 16, 16 }, { 8, 24 },
+        { 31, 33 }, { 64, 64 }, { 65, 130 }, { 130, 67 }, { 128, 128 }
+    };
+
+    for (const auto& s : sizes) {
+        test_transpose_matrix_size<T, false>(tr, s[0], s[1], 0, 0);
+        test_transpose_matrix_size<T, false>(tr, s[0], s[1], 3, 5);
+        test_transpose_matrix_size<T, true>(tr, s[0], s[1], 0, 0);
+        // keeps each destination row aligned so that stream() can be used
+        test_transpose_matrix_size<T, true>(tr, s[0], s[1], 1,
+                                            64 - s[0] % 64);
+    }
+}
+
+void test_transpose_matrix(TestResults& res, TestReporter& tr)
+{
+    (void) res;
+    test_transpose_matrix_type<uint8_t>(tr);
+    test_transpose_matrix_type<uint16_t>(tr);
+    test_transpose_matrix_type<uint32_t>(tr);
+    test_transpose_matrix_type<float>(tr);
+    test_transpose_matrix_type<uint64_t>(tr);
+    test_transpose_matrix_type<double>(tr);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,176 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+static void utf8_test_encode(uint32_t cp, std::vector<uint8_t>& u8,
+                             std::vector<char16_t>& u16)
+{
+    if (cp < 0x80) {
+        u8.push_back(uint8_t(cp));
+    } else if (cp < 0x800) {
+        u8.push_back(uint8_t(0xc0 | (cp >> 6)));
+        u8.push_back(uint8_t(0x80 | (cp & 0x3f)));
+    } else if (cp < 0x10000) {
+        u8.push_back(uint8_t(0xe0 | (cp >> 12)));
+        u8.push_back(uint8_t(0x80 | ((cp >> 6) & 0x3f)));
+        u8.push_back(uint8_t(0x80 | (cp & 0x3f)));
+    } else {
+        u8.push_back(uint8_t(0xf0 | (cp >> 18)));
+        u8.push_back(uint8_t(0x80 | ((cp >> 12) & 0x3f)));
+        u8.push_back(uint8_t(0x80 | ((cp >> 6) & 0x3f)));
+        u8.push_back(uint8_t(0x80 | (cp & 0x3f)));
+    }
+    if (cp < 0x10000) {
+        u16.push_back(char16_t(cp));
+    } else {
+        u16.push_back(char16_t(0xd800 + ((cp - 0x10000) >> 10)));
+        u16.push_back(char16_t(0xdc00 + ((cp - 0x10000) & 0x3ff)));
+    }
+}
+
+// Decodes each code point and checks that its encoding is the shortest one
+static bool utf8_test_validate(const std::vector<uint8_t>& s)
+{
+    std::size_t i = 0;
+    while (i < s.size()) {
+        uint8_t b = s[i];
+        unsigned len = b < 0x80 ? 1 : b < 0xc0 ? 0 : b < 0xe0 ? 2 : b < 0xf0 ? 3 :
+                       b < 0xf8 ? 4 : 0;
+        if (len == 0 || i + len > s.size()) {
+            return false;
+        }
+        uint32_t cp = len == 1 ? b : b & (0x7f >> len);
+        for (unsigned k = 1; k < len; ++k) {
+            if ((s[i + k] & 0xc0) != 0x80) {
+                return false;
+            }
+            cp = (cp << 6) | (s[i + k] & 0x3f);
+        }
+        if (cp > 0x10ffff || (cp >= 0xd800 && cp < 0xe000)) {
+            return false;
+        }
+        std::vector<uint8_t> enc;
+        std::vector<char16_t> u16;
+        utf8_test_encode(cp, enc, u16);
+        if (enc.size() != len) {
+            return false;
+        }
+        i += len;
+    }
+    return true;
+}
+
+void test_utf8(TestResults& res, TestReporter& tr)
+{
+    using namespace simdpp;
+    (void) res;
+
+    uint32_t seed = 1;
+    auto next = [&]() {
+        seed = seed * 1103515245u + 12345u;
+        return seed >> 8;
+    };
+
+    // the maximum code point of each class of characters
+    const uint32_t ranges[] = { 0x7f, 0x7ff, 0xffff, 0x10ffff };
+    const std::size_t lengths[] = { 0, 1, 5, 16, 17, 31, 33, 64, 100, 300 };
+    for (unsigned mix = 0; mix < 6; ++mix) {
+        for (std::size_t len : lengths) {
+            std::vector<uint8_t> u8;
+            std::vector<char16_t> u16;
+            for (std::size_t i = 0; i < len; ++i) {
+                // mostly ASCII with runs of the other classes
+                unsigned cls = mix < 4 ? mix : next() % (mix == 4 ? 3 : 4);
+                if (next() % 4 == 0) {
+                    cls = 0;
+                }
+                uint32_t cp = next() % (ranges[cls] + 1);
+                if (cp >= 0xd800 && cp < 0xe000) {
+                    cp -= 0x800;
+                }
+                utf8_test_encode(cp, u8, u16);
+            }
+
+            TEST_EQUAL(tr, utf8_validate(u8.data(), u8.size()), true);
+
+            std::vector<char16_t> out16(u8.size() + 1, char16_t(0x5a5a));
+            std::size_t n16 = utf8_to_utf16(u8.data(), u8.size(), out16.data());
+            TEST_EQUAL(tr, n16, u16.size());
+            TEST_EQUAL(tr, std::vector<char16_t>(out16.begin(), out16.begin() + n16) == u16, true);
+            TEST_EQUAL(tr, unsigned(out16.back()), 0x5a5au);
+
+            std::vector<uint8_t> out8(u16.size() * 3 + 1, 0x5a);
+            std::size_t n8 = utf16_to_utf8(u16.data(), u16.size(), out8.data());
+            TEST_EQUAL(tr, n8, u8.size());
+            TEST_EQUAL(tr, std::vector<uint8_t>(out8.begin(), out8.begin() + n8) == u8, true);
+            TEST_EQUAL(tr, unsigned(out8.back()), 0x5au);
+
+            // corrupt single bytes
+            for (unsigned t = 0; t < 20 && !u8.empty(); ++t) {
+                std::vector<uint8_t> bad = u8;
+                bad[next() % bad.size()] = uint8_t(next());
+                bool valid = utf8_test_validate(bad);
+                TEST_EQUAL(tr, utf8_validate(bad.data(), bad.size()), valid);
+                if (!valid) {
+                    TEST_EQUAL(tr, utf8_to_utf16(bad.data(), bad.size(), out16.data()),
+                               std::size_t(0));
+                }
+            }
+            // truncate the last sequence
+            if (!u8.empty() && u8.back() >= 0x80) {
+                TEST_EQUAL(tr, utf8_validate(u8.data(), u8.size() - 1), false);
+            }
+            // unpaired surrogates
+            for (char16_t s : { char16_t(0xd800), char16_t(0xdbff), char16_t(0xdc00) }) {
+                std::vector<char16_t> bad = u16;
+                bad.insert(bad.begin() + next() % (bad.size() + 1), s);
+                if (s < 0xdc00) {
+                    bad.push_back(s);
+                }
+                TEST_EQUAL(tr, utf16_to_utf8(bad.data(), bad.size(), out8.data()),
+                           std::size_t(0));
+            }
+        }
+    }
+
+    const std::vector<std::vector<uint8_t>> invalid = {
+        { 0x80 }, { 0xbf }, { 0xc0, 0x80 }, { 0xc1, 0xbf }, { 0xe0, 0x80, 0x80 },
+        { 0xe0, 0x9f, 0xbf }, { 0xed, 0xa0, 0x80 }, { 0xed, 0xbf, 0xbf },
+        { 0xf0, 0x80, 0x80, 0x80 }, { 0xf0, 0x8f, 0xbf, 0xbf },
+        { 0xf4, 0x90, 0x80, 0x80 }, { 0xf5, 0x80, 0x80, 0x80 }, { 0xff },
+        { 0xc2 }, { 0xe2, 0x82 }, { 0xf0, 0x9f, 0x98 }, { 0xc2, 0x41 },
+        { 0xe2, 0x28, 0xa1 }, { 0xc2, 0x80, 0x80 }, { 0xf0, 0x9f, 0x98, 0x80, 0x80 },
+    };
+    const std::vector<std::vector<uint8_t>> valid = {
+        { 0xc2, 0x80 }, { 0xdf, 0xbf }, { 0xe0, 0xa0, 0x80 }, { 0xed, 0x9f, 0xbf },
+        { 0xee, 0x80, 0x80 }, { 0xef, 0xbf, 0xbf }, { 0xf0, 0x90, 0x80, 0x80 },
+        { 0xf4, 0x8f, 0xbf, 0xbf },
+    };
+    for (std::size_t pos : { 0, 1, 13, 15, 16, 30, 31, 32, 60, 63, 64, 100 }) {
+        for (const auto& seq : invalid) {
+            std::vector<uint8_t> s(pos, 'a');
+            s.insert(s.end(), seq.begin(), seq.end());
+            s.resize(s.size() + 40, 'b');
+            TEST_EQUAL(tr, utf8_validate(s.data(), s.size()), false);
+            TEST_EQUAL(tr, utf8_validate(s.data(), pos + seq.size()), false);
+        }
+        for (const auto& seq : valid) {
+            std::vector<uint8_t> s(pos, 'a');
+            s.insert(s.end(), seq.begin(), seq.end());
+            TEST_EQUAL(tr, utf8_validate(s.data(), s.size()), true);
+        }
+    }
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE
@@ -0,0 +1,161 @@
+/*  Copyright (C) 2017  Povilas Kanapickas <povilas@radix.lt>
+
+    Distributed under the Boost Software License, Version 1.0.
+        (See accompanying file LICENSE_1_0.txt or copy at
+            http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../utils/test_helpers.h"
+#include "../utils/test_results.h"
+#include <simdpp/simd.h>
+#include <cstdint>
+#include <vector>
+
+namespace SIMDPP_ARCH_NAMESPACE {
+
+// Values with byte lengths chosen by the bits of seed. With small set, most
+// values fit into a single byte.
+std::vector<uint32_t> varint_data(std::size_t n, uint32_t seed, bool small)
+{
+    std::vector<uint32_t> r;
+    for (std::size_t i = 0; i < n; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t x = seed ^ (seed >> 15);
+        unsigned sel = (seed >> 28) & 7;
+        if (small) {
+            x &= sel == 0 ? 0x3fff : 0x7f;
+        } else {
+            const uint32_t masks[8] = { 0x7f, 0xff, 0x3fff, 0xffff, 0x1fffff,
+                                        0xffffff, 0xfffffff, 0xffffffff };
+            x &= masks[sel];
+        }
+        r.push_back(x);
+    }
+    return r;
+}
+
+std::vector<uint8_t> svb_reference(const std::vector<uint32_t>& in)
+{
+    std::vector<uint8_t> ctrl((in.size() + 3) / 4, 0);
+    std::vector<uint8_t> data;
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        uint32_t x = in[i];
+        unsigned len = x < (1u << 8) ? 1 : x < (1u << 16) ? 2 : x < (1u << 24) ? 3 : 4;
+        ctrl[i / 4] |= (len - 1) << (i % 4 * 2);
+        for (unsigned s = 0; s < len; ++s) {
+            data.push_back(uint8_t(x >> (s * 8)));
+        }
+    }
+    ctrl.insert(ctrl.end(), data.begin(), data.end());
+    return ctrl;
+}
+
+std::vector<uint8_t> leb128_reference(const std::vector<uint32_t>& in)
+{
+    std::vector<uint8_t> r;
+    for (uint32_t x : in) {
+        do {
+            uint8_t b = x & 0x7f;
+            x >>= 7;
+            r.push_back(x != 0 ? b | 0x80 : b);
+        } while (x != 0);
+    }
+    return r;
+}
+
+void test_varint_size(TestReporter& tr, std::size_t n, bool small)
+{
+    using namespace simdpp;
+
+    std::vector<uint32_t> in = varint_data(n, uint32_t(n * 7 + small), small);
+
+    // Stream VByte
+    std::vector<uint8_t> expected = svb_reference(in);
+    std::vector<uint8_t> enc(svb_max_encoded_size(n));
+    std::size_t size = svb_encode(in.data(), n, enc.data());
+    TEST_EQUAL(tr, size, expected.size());
+    enc.resize(size);
+    TEST_EQUAL(tr, enc == expected, true);
+
+    // the encoded data is copied to an exactly sized buffer to detect
+    // overreads with sanitizers
+    std::vector<uint8_t> exact(enc);
+    std::vector<uint32_t> dec(n);
+    TEST_EQUAL(tr, svb_decode(exact.data(), n, dec.data()), size);
+    TEST_EQUAL(tr, dec == in, true);
+
+    // LEB128
+    expected = leb128_reference(in);
+    enc.assign(leb128_max_encoded_size(n), 0);
+    size = leb128_encode(in.data(), n, enc.data());
+    TEST_EQUAL(tr, size, expected.size());
+    enc.resize(size);
+    TEST_EQUAL(tr, enc == expected, true);
+
+    exact = enc;
+    std::fill(dec.begin(), dec.end(), 0);
+    TEST_EQUAL(tr, leb128_decode(exact.data(), exact.size(), dec.data(), n), size);
+    TEST_EQUAL(tr, dec == in, true);
+
+    if (n > 0) {
+        // truncated input
+        TEST_EQUAL(tr, leb128_decode(exact.data(), exact.size() - 1, dec.data(), n),
+                   std::size_t(0));
+        // fewer values than available
+        std::size_t first = leb128_decode(exact.data(), exact.size(), dec.data(), n - 1);
+        TEST_EQUAL(tr, first, size - leb128_reference({ in[n-1] }).size());
+    }
+}
+
+void test_leb128_malformed(TestReporter& tr)
+{
+    using namespace simdpp;
+
+    // The invalid sequences are tested both in the vectorized and the
+    // scalar part of the decoder
+    for (std::size_t prefix : { std::size_t(0), std::size_t(20) }) {
+        std::vector<uint8_t> buf(prefix, 1);
+        std::vector<uint32_t> out(prefix + 1);
+        std::size_t n = prefix + 1;
+
+        // redundant zero groups are accepted
+        std::vector<uint8_t> in = buf;
+        in.insert(in.end(), { 0x81, 0x80, 0x80, 0x80, 0x00 });
+        TEST_EQUAL(tr, leb128_decode(in.data(), in.size(), out.data(), n), prefix + 5);
+        TEST_EQUAL(tr, out[prefix], 1u);
+
+        // the largest value
+        in = buf;
+        in.insert(in.end(), { 0xff, 0xff, 0xff, 0xff, 0x0f });
+        TEST_EQUAL(tr, leb128_decode(in.data(), in.size(), out.data(), n), prefix + 5);
+        TEST_EQUAL(tr, out[prefix], 0xffffffffu);
+
+        // value does not fit into 32 bits
+        in = buf;
+        in.insert(in.end(), { 0xff, 0xff, 0xff, 0xff, 0x1f });
+        TEST_EQUAL(tr, leb128_decode(in.data(), in.size(), out.data(), n), std::size_t(0));
+
+        // more than 5 bytes
+        in = buf;
+        in.insert(in.end(), { 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 });
+        TEST_EQUAL(tr, leb128_decode(in.data(), in.size(), out.data(), n), std::size_t(0));
+
+        // no terminator at all
+        in = buf;
+        in.insert(in.end(), 20, 0x80);
+        TEST_EQUAL(tr, leb128_decode(in.data(), in.size(), out.data(), n), std::size_t(0));
+    }
+}
+
+void test_varint(TestResults& res, TestReporter& tr)
+{
+    (void) res;
+    const std::size_t sizes[] = { 0, 1, 3, 4, 5, 8, 15, 16, 17, 33, 100, 1000 };
+    for (std::size_t n : sizes) {
+        test_varint_size(tr, n, false);
+        test_varint_size(tr, n, true);
+    }
+    test_leb128_malformed(tr);
+}
+
+} // namespace SIMDPP_ARCH_NAMESPACE